@@ -0,0 +1,80 @@
+#pragma once
+
+#include <chrono>
+
+#include <Pandora/Core/Types.h>
+
+/**
+ * \brief Calls the function until enough time has passed to get a stable reading.
+ *
+ * \param func The function to measure.
+ * \param minSeconds How long to keep calling it.
+ * \return The average nanoseconds per call.
+ */
+template<typename Func>
+pd::f64 Measure(Func func, pd::f64 minSeconds = 0.1) {
+    using Clock = std::chrono::steady_clock;
+
+    // Warm up caches and lazily resolved function pointers
+    func();
+
+    pd::u64 calls = 0;
+    pd::u64 batch = 1;
+    Clock::time_point start = Clock::now();
+    pd::f64 elapsed = 0.0;
+
+    // Reading the clock after every call would dwarf the fast functions
+    do {
+        for (pd::u64 i = 0; i < batch; i++) {
+            func();
+        }
+
+        calls += batch;
+        batch *= 2;
+        elapsed = std::chrono::duration<pd::f64>(Clock::now() - start).count();
+    } while (elapsed < minSeconds);
+
+    return elapsed * 1e9 / (pd::f64)calls;
+}
+
+/**
+ * \brief Prints a row of a result table.
+ *
+ * \param name What was measured.
+ * \param before The nanoseconds per call of the old or reference path, negative if it was skipped.
+ * \param after The nanoseconds per call of the new path.
+ * \param bytes How many bytes one call processes, 0 to leave out the throughput.
+ */
+void PrintComparison(const char* name, pd::f64 before, pd::f64 after, pd::u64 bytes = 0);
+
+/**
+ * \brief Prints a section header.
+ *
+ * \param title The title.
+ * \param beforeName What the "before" column measures.
+ * \param afterName What the "after" column measures.
+ */
+void PrintHeader(const char* title, const char* beforeName, const char* afterName);
+
+// @GLOBAL
+extern volatile pd::byte benchmarkSink;
+
+/**
+ * \brief Keeps the compiler from optimizing the value away.
+ */
+template<typename T>
+inline void KeepAlive(const T& value) {
+    benchmarkSink = *(const volatile pd::byte*)&value;
+}
+
+void BenchMemory();
+void BenchSort();
+void BenchParallel();
+void BenchDictionary();
+void BenchFlatMap();
+void BenchHash();
+void BenchText();
+void BenchString();
+void BenchLog();
+void BenchConsole();
+void BenchFile();
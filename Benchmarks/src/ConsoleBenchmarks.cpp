@@ -0,0 +1,148 @@
+#include <stdio.h>
+#include <string.h>
+
+#if !defined(PD_WINDOWS)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <Pandora/Core/IO/Console.h>
+#include <Pandora/Core/Logging/Logging.h>
+#include <Pandora/Core/Logging/PrintType.h>
+
+#include "Benchmark.h"
+
+using namespace pd;
+
+// How many files the box builder stages in every measured call
+const int STAGED_FILE_COUNT = 5000;
+
+#if !defined(PD_WINDOWS)
+
+// The Linux color escapes, same as the console's
+const char* OLD_COLOR_ANSI[] = {
+    "\x1b[30m", "\x1b[2;34m", "\x1b[2;32m", "\x1b[2;36m",
+    "\x1b[2;31m", "\x1b[2;35m", "\x1b[2;33m", "\x1b[0m",
+    "\x1b[2;37m", "\x1b[34m", "\x1b[32m", "\x1b[36m",
+    "\x1b[31m", "\x1b[35m", "\x1b[33m", "\x1b[37m"
+};
+
+// What `Console` did before it had a buffer, every write went straight to stdio
+// and every color change was a printf to `stdout`
+class OldConsole final : public Stream {
+public:
+    virtual int ReadByte(byte* out) override {
+        return 0;
+    }
+
+    virtual int WriteByte(byte b) override {
+        return (int)fwrite(&b, 1, 1, stdout);
+    }
+
+    virtual int WriteBytes(Slice<byte> bytes) override {
+        return (int)fwrite(bytes.Data(), 1, bytes.SizeInBytes(), stdout);
+    }
+
+    void SetColor(ConColor color) {
+        printf("%s", OLD_COLOR_ANSI[(int)color]);
+    }
+
+    // The old `Log()` wrote the text of the format a byte at a time
+    void WriteText(const char* text) {
+        for (; *text; text++) {
+            WriteByte((byte)*text);
+        }
+    }
+
+    virtual void Flush() override {
+        fflush(stdout);
+    }
+
+    virtual void Seek(i64 offset, SeekOrigin origin = SeekOrigin::Current) override {}
+};
+
+// The calls the old console got for a staged texture
+static void OldLogStagedFiles(OldConsole& out) {
+    StringView name = "Textures/Tiles/tile";
+    StringView path = "data/textures/tiles/tile.png";
+
+    for (int i = 0; i < STAGED_FILE_COUNT; i++) {
+        out.WriteText("[");
+        out.SetColor(ConColor::Red);
+        out.WriteText("Box");
+        out.SetColor(ConColor::White);
+        out.WriteText("] ");
+
+        out.WriteText("Staging texture '");
+        out.WriteBytes(Slice<byte>((byte*)name.Data(), (int)name.SizeInBytes()));
+        out.WriteText("'");
+
+        out.WriteText(" ");
+        out.SetColor(ConColor::Grey);
+        out.WriteText("(");
+        out.WriteBytes(Slice<byte>((byte*)path.Data(), (int)path.SizeInBytes()));
+        out.WriteText(")");
+        out.SetColor(ConColor::White);
+        out.WriteText("\n");
+    }
+
+    out.Flush();
+}
+
+// What `BoxBuilder` logs for a staged texture
+static void LogStagedFiles() {
+    StringView name = "Textures/Tiles/tile";
+    StringView path = "data/textures/tiles/tile.png";
+
+    for (int i = 0; i < STAGED_FILE_COUNT; i++) {
+        console.Log("[{}Box{}] ", ConColor::Red, ConColor::White);
+        console.Log("Staging texture '{}'", name);
+        console.Log(" {}({}){}\n", ConColor::Grey, path, ConColor::White);
+    }
+
+    console.Flush();
+}
+
+void BenchConsole() {
+    const ConsoleFlushMode MODES[] = { ConsoleFlushMode::Line, ConsoleFlushMode::Size, ConsoleFlushMode::Manual };
+    const char* MODE_NAMES[] = { "Line mode", "Size mode", "Manual mode" };
+
+    f64 after[3] = {};
+
+    // The lines go to the null device so they don't end up between the results
+    console.Flush();
+    int savedOutput = dup(STDOUT_FILENO);
+    int nullOutput = open("/dev/null", O_WRONLY);
+    dup2(nullOutput, STDOUT_FILENO);
+
+    OldConsole oldConsole;
+    f64 before = Measure([&]() { OldLogStagedFiles(oldConsole); });
+
+    ConsoleFlushMode previousMode = console.FlushMode();
+    for (int i = 0; i < 3; i++) {
+        console.SetFlushMode(MODES[i]);
+        after[i] = Measure([&]() { LogStagedFiles(); });
+    }
+
+    console.SetFlushMode(previousMode);
+    console.Flush();
+
+    dup2(savedOutput, STDOUT_FILENO);
+    close(savedOutput);
+    close(nullOutput);
+
+    PrintHeader("Logging 5000 staged files with colors, per line", "unbuffered", "buffered");
+
+    for (int i = 0; i < 3; i++) {
+        PrintComparison(MODE_NAMES[i], before / STAGED_FILE_COUNT, after[i] / STAGED_FILE_COUNT);
+    }
+}
+
+#else
+
+void BenchConsole() {
+    // Colors are console calls on Windows and the output can't be sent elsewhere
+    console.Log("\nThe console benchmark only runs where colors are escape codes\n");
+}
+
+#endif
@@ -0,0 +1,241 @@
+#include <stdio.h>
+
+#include <Pandora/Core/Data/Dictionary.h>
+#include <Pandora/Core/Data/String.h>
+#include <Pandora/Core/IO/Console.h>
+#include <Pandora/Core/Logging/PrintType.h>
+
+#include "Benchmark.h"
+
+using namespace pd;
+
+// @GLOBAL
+static u64 hashCalls = 0;
+
+// Wraps a key so every hash of it gets counted
+template<typename T>
+struct CountedKey {
+    T value;
+
+    bool operator==(const CountedKey<T>& other) const {
+        return value == other.value;
+    }
+};
+
+namespace pd {
+
+template<typename T>
+struct Hasher<CountedKey<T>> {
+    static u64 Hash(const CountedKey<T>& key) {
+        hashCalls += 1;
+        return DoHash(key.value);
+    }
+};
+
+}
+
+// The Robin Hood dictionary from before entries kept their hash. Keys got compared by hashing
+// both of them, growing hashed every key again and a missing key got inserted and looked up again.
+// The original lost the displaced entry when it stole a bucket, that is fixed here so it finishes.
+template<typename K, typename V>
+class OldDictionary {
+    struct Entry {
+        i8 dist = -1;
+        K key = K();
+        V val = V();
+    };
+
+public:
+    ~OldDictionary() {
+        for (int i = 0; i < capacity; i++) {
+            memory[i].~Entry();
+        }
+
+        Free(memory);
+    }
+
+    bool Contains(const K& key) const {
+        if (!memory) return false;
+
+        u64 bucket = DoHash(key) & (u64)(capacity - 1);
+
+        for (int probed = 0; probed < capacity; probed++) {
+            Entry* entry = &memory[bucket];
+
+            if (entry->dist < 0) return false;
+            if (DoHash(key) == DoHash(entry->key)) return true;
+
+            bucket = (bucket + 1) & (u64)(capacity - 1);
+        }
+
+        return false;
+    }
+
+    V& Get(const K& key) {
+        Init();
+
+        u64 bucket = DoHash(key) & (u64)(capacity - 1);
+
+        for (int probed = 0; probed < capacity; probed++) {
+            Entry* entry = &memory[bucket];
+
+            if (entry->dist < 0) break;
+            if (DoHash(key) == DoHash(entry->key)) return entry->val;
+
+            bucket = (bucket + 1) & (u64)(capacity - 1);
+        }
+
+        Insert(key, V());
+        return Get(key);
+    }
+
+    void Insert(const K& key, const V& val) {
+        Init();
+
+        u64 bucket = DoHash(key) & (u64)(capacity - 1);
+
+        Entry target;
+        target.dist = 0;
+        target.key = key;
+        target.val = val;
+
+        while (true) {
+            Entry* entry = &memory[bucket];
+
+            if (entry->dist < 0) {
+                *entry = std::move(target);
+                count += 1;
+
+                if (count > capacity / 2) {
+                    GrowAndRehash();
+                }
+
+                return;
+            } else if (target.dist > entry->dist) {
+                std::swap(target, *entry);
+            }
+
+            bucket = (bucket + 1) & (u64)(capacity - 1);
+            target.dist += 1;
+        }
+    }
+
+private:
+    void Init() {
+        const int INITIAL_LENGTH = 32;
+
+        if (!memory) {
+            capacity = INITIAL_LENGTH;
+            memory = (Entry*)Alloc(sizeof(Entry) * capacity);
+
+            for (int i = 0; i < capacity; i++) {
+                new (memory + i) Entry();
+            }
+        }
+    }
+
+    void GrowAndRehash() {
+        Entry* oldMemory = memory;
+        int oldCapacity = capacity;
+
+        capacity *= 2;
+        count = 0;
+        memory = (Entry*)Alloc(sizeof(Entry) * capacity);
+
+        for (int i = 0; i < capacity; i++) {
+            new (memory + i) Entry();
+        }
+
+        for (int i = 0; i < oldCapacity; i++) {
+            if (oldMemory[i].dist >= 0) {
+                Insert(oldMemory[i].key, oldMemory[i].val);
+            }
+
+            oldMemory[i].~Entry();
+        }
+
+        Free(oldMemory);
+    }
+
+    Entry* memory = nullptr;
+    int capacity = 0;
+    int count = 0;
+};
+
+/**
+ * \brief Fills a dictionary with the keys, looks every key up a few times and checks as many missing keys.
+ */
+template<typename Dict, typename K>
+static void RunDictionaryWorkload(const Array<K>& keys, const Array<K>& missing) {
+    const int LOOKUPS_PER_KEY = 8;
+
+    Dict dict;
+
+    for (int i = 0; i < keys.Count(); i++) {
+        dict.Get(keys[i]) = i;
+    }
+
+    int found = 0;
+    for (int round = 0; round < LOOKUPS_PER_KEY; round++) {
+        for (int i = 0; i < keys.Count(); i++) {
+            found += dict.Get(keys[i]);
+        }
+    }
+
+    for (int i = 0; i < missing.Count(); i++) {
+        found += dict.Contains(missing[i]) ? 1 : 0;
+    }
+
+    KeepAlive(found);
+}
+
+template<typename K>
+static void CompareDictionaries(const char* name, const Array<K>& keys, const Array<K>& missing) {
+    hashCalls = 0;
+    RunDictionaryWorkload<OldDictionary<K, int>>(keys, missing);
+    u64 oldHashes = hashCalls;
+
+    hashCalls = 0;
+    RunDictionaryWorkload<Dictionary<K, int>>(keys, missing);
+    u64 newHashes = hashCalls;
+
+    f64 before = Measure([&]() { RunDictionaryWorkload<OldDictionary<K, int>>(keys, missing); });
+    f64 after = Measure([&]() { RunDictionaryWorkload<Dictionary<K, int>>(keys, missing); });
+
+    PrintComparison(name, before, after);
+    PrintfToStream(console, "%-28s %14llu %14llu %8.2fx\n", "  hash calls",
+                   (unsigned long long)oldHashes, (unsigned long long)newHashes, (f64)oldHashes / (f64)newHashes);
+}
+
+void BenchDictionary() {
+    const int COUNTS[] = { 100, 1000, 10000 };
+
+    PrintHeader("Dictionary fill, 8 lookups per key, as many misses", "old", "new");
+
+    for (int count : COUNTS) {
+        Array<CountedKey<String>> names;
+        Array<CountedKey<String>> missingNames;
+        Array<CountedKey<codepoint>> glyphs;
+        Array<CountedKey<codepoint>> missingGlyphs;
+
+        for (int i = 0; i < count; i++) {
+            CountedKey<String> name;
+            name.value.Format("Textures/Tiles/tile_{}.png", i);
+            names.Add(name);
+
+            name.value.Format("Textures/Tiles/missing_{}.png", i);
+            missingNames.Add(name);
+
+            // Glyphs start at the printable characters like a font atlas does
+            glyphs.Add(CountedKey<codepoint>{ 0x20 + i });
+            missingGlyphs.Add(CountedKey<codepoint>{ 0x20 + count + i });
+        }
+
+        char name[64];
+        snprintf(name, sizeof(name), "%d String keys", count);
+        CompareDictionaries(name, names, missingNames);
+
+        snprintf(name, sizeof(name), "%d codepoint keys", count);
+        CompareDictionaries(name, glyphs, missingGlyphs);
+    }
+}
@@ -0,0 +1,116 @@
+#include <stdio.h>
+
+#include <Pandora/Core/Data/Allocator.h>
+#include <Pandora/Core/Encoding/Box.h>
+#include <Pandora/Core/IO/File.h>
+#include <Pandora/Core/IO/FileStream.h>
+
+#include "Benchmark.h"
+
+using namespace pd;
+
+// Where the benchmark box gets written, it's deleted afterwards
+const char* BENCH_BOX_PATH = "BenchmarkHeaders.box";
+
+/**
+ * \brief Writes a box with only a header table, the way `BoxBuilder::Build()` lays it out.
+ */
+static bool WriteHeaderBox(int headerCount) {
+    FileStream file;
+    if (!file.Open(BENCH_BOX_PATH, FileMode::Truncate, FILE_STREAM_BUFFER_SIZE)) return false;
+
+    const byte BLANK_IV[16] = { 0 };
+
+    file.WriteBytes(BOX_FILE_MAGIC);
+    file.Write(BOX_VERSION);
+    file.WriteBytes(Slice<byte>(BLANK_IV, 16));
+    file.Write((u32)headerCount);
+
+    for (int i = 0; i < headerCount; i++) {
+        String name;
+        name.Format("Textures/Tiles/tile_{}.png", i);
+
+        // The name length includes the null terminator
+        StringView view = name.View();
+        file.Write(ResourceType::Texture);
+        file.Write((u16)(view.SizeInBytes() + 1));
+        file.WriteBytes(Slice<byte>((byte*)view.Data(), (int)view.SizeInBytes()));
+        file.WriteByte('\0');
+        file.Write((u64)i * 4096);
+    }
+
+    file.WriteByte('\n');
+    return true;
+}
+
+/**
+ * \brief Reads the header table field by field like `Box::Load()`, through a stream opened with the buffer size.
+ */
+static int ReadHeaderTable(u32 bufferSize) {
+    FileStream file;
+    if (!file.Open(BENCH_BOX_PATH, FileMode::Read, bufferSize)) return 0;
+
+    byte iv[16];
+    byte version = 0;
+    u32 fileCount = 0;
+
+    file.SkipIfEqual(BOX_FILE_MAGIC);
+    file.ReadByte(&version);
+    file.ReadBytes(iv, 16);
+    file.Read<u32>(&fileCount);
+
+    Array<BoxHeader> headers;
+    headers.Resize((int)fileCount);
+
+    for (u32 i = 0; i < fileCount; i++) {
+        ScopedArena scope;
+
+        ResourceType type;
+        u16 fileNameLen = 0;
+        u64 dataPosition = 0;
+
+        file.Read(&type);
+        file.Read<u16>(&fileNameLen);
+
+        byte* fileName = (byte*)Alloc(fileNameLen, Allocator::Temporary);
+        if (file.ReadBytes(fileName, fileNameLen) != fileNameLen) break;
+
+        file.Read<u64>(&dataPosition);
+
+        headers.Reserve(1);
+        headers.Last().type = type;
+        headers.Last().name.Set(fileName);
+        headers.Last().position = dataPosition;
+    }
+
+    return headers.Count();
+}
+
+void BenchFile() {
+    const int COUNTS[] = { 5000, 50000 };
+
+    PrintHeader("Loading the header table of a box, page cache warm", "stdio", "buffered");
+
+    for (int count : COUNTS) {
+        if (!WriteHeaderBox(count)) return;
+
+        f64 before = Measure([&]() { KeepAlive(ReadHeaderTable(0)); });
+        f64 after = Measure([&]() { KeepAlive(ReadHeaderTable(FILE_STREAM_BUFFER_SIZE)); });
+
+        char name[64];
+        snprintf(name, sizeof(name), "%d headers", count);
+        PrintComparison(name, before, after, GetFileSize(BENCH_BOX_PATH));
+
+        // The whole thing, which also opens the file with the buffer
+        f64 load = Measure([&]() {
+            Box box;
+            box.Load(BENCH_BOX_PATH);
+            KeepAlive(box.GetHeaders().Count());
+        });
+
+        snprintf(name, sizeof(name), "%d headers, Box::Load", count);
+        PrintComparison(name, before, load, GetFileSize(BENCH_BOX_PATH));
+    }
+
+    FileDelete(BENCH_BOX_PATH);
+}
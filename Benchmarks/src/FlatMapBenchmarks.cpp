@@ -0,0 +1,144 @@
+#include <stdio.h>
+
+#include <Pandora/Core/Data/Dictionary.h>
+#include <Pandora/Core/Data/FlatMap.h>
+#include <Pandora/Core/Data/String.h>
+#include <Pandora/Core/Math/Random.h>
+
+#include "Benchmark.h"
+
+using namespace pd;
+
+/**
+ * \brief Times filling a map with the keys and finding `lookups` in it, which may hold missing keys.
+ */
+template<typename K>
+static void CompareMaps(const char* name, const Array<K>& keys, const Array<K>& lookups) {
+    f64 fillBefore = Measure([&]() {
+        Dictionary<K, int> dict;
+        for (int i = 0; i < keys.Count(); i++) {
+            dict.Insert(keys[i], i);
+        }
+        KeepAlive(dict.Count());
+    });
+
+    f64 fillAfter = Measure([&]() {
+        FlatMap<K, int> map;
+        for (int i = 0; i < keys.Count(); i++) {
+            map.Insert(keys[i], i);
+        }
+        KeepAlive(map.Count());
+    });
+
+    Dictionary<K, int> dict;
+    FlatMap<K, int> map;
+
+    for (int i = 0; i < keys.Count(); i++) {
+        dict.Insert(keys[i], i);
+        map.Insert(keys[i], i);
+    }
+
+    f64 findBefore = Measure([&]() {
+        int found = 0;
+        for (int i = 0; i < lookups.Count(); i++) {
+            int* val = dict.Find(lookups[i]);
+            found += (val) ? *val : -1;
+        }
+        KeepAlive(found);
+    });
+
+    f64 findAfter = Measure([&]() {
+        int found = 0;
+        for (int i = 0; i < lookups.Count(); i++) {
+            int* val = map.Find(lookups[i]);
+            found += (val) ? *val : -1;
+        }
+        KeepAlive(found);
+    });
+
+    char row[64];
+    snprintf(row, sizeof(row), "%s fill", name);
+    PrintComparison(row, fillBefore, fillAfter);
+
+    snprintf(row, sizeof(row), "%s find", name);
+    PrintComparison(row, findBefore, findAfter);
+}
+
+// Resource names like the catalog holds, looked up by name with every tenth one missing
+static void BenchCatalogLookups() {
+    const int RESOURCE_COUNT = 500;
+    const int LOOKUP_COUNT = 4096;
+
+    Array<String> names;
+    for (int i = 0; i < RESOURCE_COUNT; i++) {
+        String name;
+        name.Format("Textures/Tiles/tile_{}.png", i);
+        names.Add(name);
+    }
+
+    Array<String> lookups;
+    for (int i = 0; i < LOOKUP_COUNT; i++) {
+        int index = (int)pd::random.Range(0, RESOURCE_COUNT);
+
+        if (i % 10 == 0) {
+            String name;
+            name.Format("Textures/Tiles/missing_{}.png", index);
+            lookups.Add(name);
+        } else {
+            lookups.Add(names[index]);
+        }
+    }
+
+    CompareMaps("catalog", names, lookups);
+}
+
+// A font atlas with the printable ASCII characters and Latin-1, looked up for every character of a text
+static void BenchGlyphLookups() {
+    const int LOOKUP_COUNT = 4096;
+
+    Array<codepoint> glyphs;
+    for (codepoint c = 0x20; c < 0x7F; c++) {
+        glyphs.Add(c);
+    }
+
+    for (codepoint c = 0xA0; c < 0x180; c++) {
+        glyphs.Add(c);
+    }
+
+    // Mostly ASCII with the odd accented character
+    Array<codepoint> text;
+    for (int i = 0; i < LOOKUP_COUNT; i++) {
+        bool accented = (pd::random.Range(0, 20) == 0);
+        text.Add(accented ? (codepoint)pd::random.Range(0xC0, 0x100) : (codepoint)pd::random.Range(0x20, 0x7F));
+    }
+
+    CompareMaps("glyph", glyphs, text);
+}
+
+// A handful of scenes found by their name hash, like switching scenes does
+static void BenchSceneLookups() {
+    const int SCENE_COUNT = 16;
+    const int LOOKUP_COUNT = 4096;
+
+    Array<u64> scenes;
+    for (int i = 0; i < SCENE_COUNT; i++) {
+        String name;
+        name.Format("Scene{}", i);
+        scenes.Add(DoHash(name));
+    }
+
+    Array<u64> lookups;
+    for (int i = 0; i < LOOKUP_COUNT; i++) {
+        lookups.Add(scenes[(int)pd::random.Range(0, SCENE_COUNT)]);
+    }
+
+    CompareMaps("scene", scenes, lookups);
+}
+
+void BenchFlatMap() {
+    PrintHeader("Fill the map, then 4096 lookups", "Dictionary", "FlatMap");
+
+    BenchCatalogLookups();
+    BenchGlyphLookups();
+    BenchSceneLookups();
+}
@@ -0,0 +1,120 @@
+#include <stdio.h>
+
+#include <Pandora/Core/CPU.h>
+#include <Pandora/Core/Data/Hash.h>
+#include <Pandora/Core/Data/Array.h>
+
+#if defined(PD_X86)
+#include <Pandora/Libs/MeowHash/meow_hash_x64_aesni.h>
+#endif
+
+#include "Benchmark.h"
+
+using namespace pd;
+
+// How many different keys every measured call hashes
+const int HASH_KEY_COUNT = 1024;
+
+// Has padding after `type` and `flags`, which the old byte hash read
+struct PaddedKey {
+    u8 type;
+    u32 id;
+    u16 flags;
+};
+
+namespace pd {
+
+template<>
+struct Hasher<PaddedKey> {
+    static u64 Hash(const PaddedKey& key) {
+        return HashFields(key.type, key.id, key.flags);
+    }
+};
+
+}
+
+enum class BenchResourceKind : u32 {
+    Texture,
+    Shader,
+    Font,
+};
+
+// What `DoHash()` did for every type before, MeowHash over the bytes of the object
+inline u64 OldHashBytes(const void* data, u64 size) {
+#if defined(PD_X86)
+    return MeowU64From(MeowHash(MeowDefaultSeed, size, (void*)data), 0);
+#else
+    return HashBytes(data, size);
+#endif
+}
+
+template<typename T>
+static void CompareKeyHashes(const char* name, const Array<T>& keys) {
+    f64 before = Measure([&]() {
+        u64 sum = 0;
+        for (int i = 0; i < keys.Count(); i++) {
+            sum += OldHashBytes(&keys[i], sizeof(T));
+        }
+        KeepAlive(sum);
+    });
+
+    f64 after = Measure([&]() {
+        u64 sum = 0;
+        for (int i = 0; i < keys.Count(); i++) {
+            sum += DoHash(keys[i]);
+        }
+        KeepAlive(sum);
+    });
+
+    PrintComparison(name, before / HASH_KEY_COUNT, after / HASH_KEY_COUNT, sizeof(T));
+}
+
+static void BenchKeyHashes() {
+    PrintHeader("Hashing one key", "MeowHash", "DoHash");
+
+    Array<u32> codepoints;
+    Array<u64> hashes;
+    Array<void*> pointers;
+    Array<BenchResourceKind> kinds;
+    Array<PaddedKey> padded;
+
+    for (int i = 0; i < HASH_KEY_COUNT; i++) {
+        codepoints.Add((u32)(0x20 + i));
+        hashes.Add(HashMix((u64)i));
+        pointers.Add((void*)(uintptr_t)(0x10000 + i * 64));
+        kinds.Add((BenchResourceKind)(i % 3));
+        padded.Add(PaddedKey{ (u8)(i % 7), (u32)i, (u16)(i * 3) });
+    }
+
+    CompareKeyHashes("u32 codepoint", codepoints);
+    CompareKeyHashes("u64 hash", hashes);
+    CompareKeyHashes("pointer", pointers);
+    CompareKeyHashes("enum", kinds);
+    CompareKeyHashes("12 byte padded struct", padded);
+}
+
+static void BenchBufferHashes() {
+    const u64 SIZES[] = { 16, 32, 64, 256, 4096, 65536 };
+
+    PrintHeader("Hashing a buffer", "MeowHash", "HashBytes");
+
+    Array<byte> buffer;
+    buffer.AddUninitialized(65536);
+    for (int i = 0; i < buffer.Count(); i++) {
+        buffer[i] = (byte)(i * 31);
+    }
+
+    for (u64 size : SIZES) {
+        f64 before = Measure([&]() { KeepAlive(OldHashBytes(buffer.Data(), size)); });
+        f64 after = Measure([&]() { KeepAlive(HashBytes(buffer.Data(), size)); });
+
+        char name[64];
+        snprintf(name, sizeof(name), "%llu bytes", (unsigned long long)size);
+        PrintComparison(name, before, after, size);
+    }
+}
+
+void BenchHash() {
+    BenchKeyHashes();
+    BenchBufferHashes();
+}
@@ -0,0 +1,149 @@
+#include <stdio.h>
+#include <string.h>
+
+#include <Pandora/Core/IO/Console.h>
+#include <Pandora/Core/IO/MemoryStream.h>
+#include <Pandora/Core/Logging/Logging.h>
+#include <Pandora/Core/Logging/PrintType.h>
+
+#include "Benchmark.h"
+
+using namespace pd;
+
+// How many lines every measured call logs
+const int LOG_LINE_COUNT = 1000000;
+
+// Where the console benchmarks write to
+#if defined(PD_WINDOWS)
+const char* NULL_DEVICE = "NUL";
+#else
+const char* NULL_DEVICE = "/dev/null";
+#endif
+
+// What `LogInternal()` did before format strings were split into segments,
+// every argument scanned the rest of the format and wrote the text a byte at a time
+
+static void OldLogInternal(Stream& out, const char* remainingFormat) {
+    int formatLength = (int)strlen(remainingFormat);
+
+    bool parsingParam = false;
+    for (int i = 0; i < formatLength; i++) {
+        if (remainingFormat[i] == '{') {
+            if (i + 1 < formatLength && remainingFormat[i + 1] == '{') {
+                out.WriteByte('{');
+                i += 1;
+                continue;
+            }
+
+            parsingParam = true;
+        } else if (remainingFormat[i] == '}') {
+            if (i + 1 < formatLength && remainingFormat[i + 1] == '}') {
+                out.WriteByte('}');
+                i += 1;
+                continue;
+            }
+
+            if (parsingParam) {
+                parsingParam = false;
+                out.WriteBytes("{ missing }");
+                continue;
+            }
+        } else if (!parsingParam) {
+            out.WriteByte((remainingFormat + i)[0]);
+        }
+    }
+}
+
+template<typename Arg0, typename... Args>
+static void OldLogInternal(Stream& out, const char* remainingFormat, const Arg0& arg0, const Args&... args) {
+    int formatLength = (int)strlen(remainingFormat);
+
+    FormatInfo info(out);
+    bool parsingParam = false;
+    for (int i = 0; i < formatLength; i++) {
+        if (remainingFormat[i] == '{') {
+            if (i + 1 < formatLength && remainingFormat[i + 1] == '{') {
+                out.WriteByte('{');
+                i += 1;
+                continue;
+            }
+
+            info.raw = remainingFormat + i;
+            info.rawLength = i;
+
+            parsingParam = true;
+        } else if (remainingFormat[i] == '}') {
+            if (i + 1 < formatLength && remainingFormat[i + 1] == '}') {
+                out.WriteByte('}');
+                i += 1;
+                continue;
+            }
+
+            if (parsingParam) {
+                info.rawLength = i - info.rawLength;
+
+                PrintType((Arg0&)arg0, info);
+                OldLogInternal(out, remainingFormat + i + 1, args...);
+                return;
+            }
+        } else if (parsingParam) {
+            // Only the plain {} are used here
+        } else {
+            out.WriteByte((remainingFormat + i)[0]);
+        }
+    }
+}
+
+/**
+ * \brief Logs the same kind of line the box builder does, once the old way, once at runtime and once with `PD_FORMAT()`.
+ */
+template<typename Reset>
+static void CompareLogging(const char* name, Stream& out, Reset reset) {
+    StringView file = "Textures/Tiles/tile.png";
+
+    f64 before = Measure([&]() {
+        reset();
+        for (int i = 0; i < LOG_LINE_COUNT; i++) {
+            OldLogInternal(out, "[Box] Staged '{}' ({} of {}, {} bytes)\n", file, i, LOG_LINE_COUNT, i * 64);
+        }
+    }, 0.5);
+
+    f64 runtime = Measure([&]() {
+        reset();
+        for (int i = 0; i < LOG_LINE_COUNT; i++) {
+            Log(out, "[Box] Staged '{}' ({} of {}, {} bytes)\n", file, i, LOG_LINE_COUNT, i * 64);
+        }
+    }, 0.5);
+
+    f64 parsed = Measure([&]() {
+        reset();
+        for (int i = 0; i < LOG_LINE_COUNT; i++) {
+            Log(out, PD_FORMAT("[Box] Staged '{}' ({} of {}, {} bytes)\n"), file, i, LOG_LINE_COUNT, i * 64);
+        }
+    }, 0.5);
+
+    char row[64];
+    snprintf(row, sizeof(row), "%s, runtime", name);
+    PrintComparison(row, before / LOG_LINE_COUNT, runtime / LOG_LINE_COUNT);
+
+    snprintf(row, sizeof(row), "%s, PD_FORMAT", name);
+    PrintComparison(row, before / LOG_LINE_COUNT, parsed / LOG_LINE_COUNT);
+}
+
+void BenchLog() {
+    PrintHeader("Logging 1M formatted lines, per line", "old Log", "new Log");
+
+    MemoryStream memory(64 * 1024 * 1024);
+    CompareLogging("MemoryStream", memory, [&]() { memory.Seek(0, SeekOrigin::Start); });
+
+    // A console of its own so the lines don't end up between the results
+    FILE* null = fopen(NULL_DEVICE, "wb");
+    if (!null) return;
+
+    {
+        Console nullConsole(null);
+        CompareLogging("Console", nullConsole, [&]() {});
+    }
+
+    fclose(null);
+}
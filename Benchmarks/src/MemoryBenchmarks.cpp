@@ -0,0 +1,153 @@
+#include <stdio.h>
+#include <string.h>
+
+#include <Pandora/Core/Data/Allocator.h>
+#include <Pandora/Core/Data/Memory.h>
+#include <Pandora/Core/IO/Console.h>
+#include <Pandora/Core/Logging/PrintType.h>
+
+#include "Benchmark.h"
+
+using namespace pd;
+
+// The 8 bytes at a time loops the memory functions used before they were vectorized
+
+static void ScalarCopy(void* destination, const void* source, u64 copySize) {
+    for (int i = 0; i < copySize / sizeof(u64); i++) {
+        ((u64*)destination)[i] = ((u64*)source)[i];
+    }
+
+    int base = (int)(copySize / sizeof(u64) * sizeof(u64));
+    for (int i = 0; i < copySize % sizeof(u64); i++) {
+        ((byte*)destination)[base + i] = ((byte*)source)[base + i];
+    }
+}
+
+// Overlapping copies went through a heap allocated copy of the source
+static void ScalarMove(void* destination, const void* source, u64 moveSize) {
+    void* intermediate = Alloc(moveSize);
+    ScalarCopy(intermediate, source, moveSize);
+    ScalarCopy(destination, intermediate, moveSize);
+    Free(intermediate);
+}
+
+static void ScalarSet(void* destination, u64 setSize, byte value) {
+    u64 v = (u64)value;
+    u64 packedValue = (v << 56) | (v << 48) | (v << 40) | (v << 32) | (v << 24) | (v << 16) | (v << 8) | v;
+
+    for (int i = 0; i < setSize / sizeof(u64); i++) {
+        ((u64*)destination)[i] = packedValue;
+    }
+
+    int base = (int)(setSize / sizeof(u64) * sizeof(u64));
+    for (int i = 0; i < setSize % sizeof(u64); i++) {
+        ((byte*)destination)[base + i] = value;
+    }
+}
+
+static bool ScalarCompare(void* a, void* b, u64 compareSize) {
+    for (int i = 0; i < compareSize / sizeof(u64); i++) {
+        if (((u64*)a)[i] != ((u64*)b)[i]) return false;
+    }
+
+    int base = (int)(compareSize / sizeof(u64) * sizeof(u64));
+    for (int i = 0; i < compareSize % sizeof(u64); i++) {
+        if (((byte*)a)[base + i] != ((byte*)b)[base + i]) return false;
+    }
+
+    return true;
+}
+
+static void SizeName(char* out, int outSize, u64 size, const char* operation) {
+    if (size >= 1024 * 1024) {
+        snprintf(out, outSize, "%s %llu MB", operation, size / (1024 * 1024));
+    } else if (size >= 1024) {
+        snprintf(out, outSize, "%s %llu KB", operation, size / 1024);
+    } else {
+        snprintf(out, outSize, "%s %llu B", operation, size);
+    }
+}
+
+void BenchMemory() {
+    const u64 SIZES[] = { 8, 64, 512, 4096, 32768, 262144, 2097152, 16777216, 67108864 };
+    const u64 MAX_SIZE = 67108864;
+
+    // Room for a move that overlaps by half
+    byte* a = (byte*)Alloc(MAX_SIZE * 2, Allocator::Persistent, 64);
+    byte* b = (byte*)Alloc(MAX_SIZE, Allocator::Persistent, 64);
+    MemorySet(a, MAX_SIZE * 2, 0x5A);
+    MemorySet(b, MAX_SIZE, 0x5A);
+
+    char name[64];
+
+    PrintHeader("MemoryCopy", "old loop", "MemoryCopy");
+    for (u64 size : SIZES) {
+        f64 before = Measure([&]() { ScalarCopy(b, a, size); KeepAlive(b[0]); });
+        f64 after = Measure([&]() { MemoryCopy(b, a, size); KeepAlive(b[0]); });
+        SizeName(name, sizeof(name), size, "copy");
+        PrintComparison(name, before, after, size);
+    }
+
+    PrintHeader("MemoryCopy", "memcpy", "MemoryCopy");
+    for (u64 size : SIZES) {
+        f64 before = Measure([&]() { memcpy(b, a, size); KeepAlive(b[0]); });
+        f64 after = Measure([&]() { MemoryCopy(b, a, size); KeepAlive(b[0]); });
+        SizeName(name, sizeof(name), size, "copy");
+        PrintComparison(name, before, after, size);
+    }
+
+    PrintHeader("MemoryMove, overlapping by half", "old copy", "MemoryMove");
+    for (u64 size : SIZES) {
+        f64 before = Measure([&]() { ScalarMove(a + size / 2, a, size); KeepAlive(a[0]); });
+        f64 after = Measure([&]() { MemoryMove(a + size / 2, a, size); KeepAlive(a[0]); });
+        SizeName(name, sizeof(name), size, "move");
+        PrintComparison(name, before, after, size);
+    }
+
+    PrintHeader("MemoryMove, overlapping by half", "memmove", "MemoryMove");
+    for (u64 size : SIZES) {
+        f64 before = Measure([&]() { memmove(a + size / 2, a, size); KeepAlive(a[0]); });
+        f64 after = Measure([&]() { MemoryMove(a + size / 2, a, size); KeepAlive(a[0]); });
+        SizeName(name, sizeof(name), size, "move");
+        PrintComparison(name, before, after, size);
+    }
+
+    PrintHeader("MemorySet", "old loop", "MemorySet");
+    for (u64 size : SIZES) {
+        f64 before = Measure([&]() { ScalarSet(b, size, 0x11); KeepAlive(b[0]); });
+        f64 after = Measure([&]() { MemorySet(b, size, 0x11); KeepAlive(b[0]); });
+        SizeName(name, sizeof(name), size, "set");
+        PrintComparison(name, before, after, size);
+    }
+
+    PrintHeader("MemorySet", "memset", "MemorySet");
+    for (u64 size : SIZES) {
+        f64 before = Measure([&]() { memset(b, 0x11, size); KeepAlive(b[0]); });
+        f64 after = Measure([&]() { MemorySet(b, size, 0x11); KeepAlive(b[0]); });
+        SizeName(name, sizeof(name), size, "set");
+        PrintComparison(name, before, after, size);
+    }
+
+    // Equal buffers so every byte gets compared
+    MemorySet(a, MAX_SIZE, 0x11);
+    MemorySet(b, MAX_SIZE, 0x11);
+
+    PrintHeader("MemoryCompare, equal buffers", "old loop", "MemoryCompare");
+    for (u64 size : SIZES) {
+        f64 before = Measure([&]() { KeepAlive(ScalarCompare(a, b, size)); });
+        f64 after = Measure([&]() { KeepAlive(MemoryCompare(a, b, size)); });
+        SizeName(name, sizeof(name), size, "compare");
+        PrintComparison(name, before, after, size);
+    }
+
+    PrintHeader("MemoryCompare, equal buffers", "memcmp", "MemoryCompare");
+    for (u64 size : SIZES) {
+        f64 before = Measure([&]() { KeepAlive(memcmp(a, b, size) == 0); });
+        f64 after = Measure([&]() { KeepAlive(MemoryCompare(a, b, size)); });
+        SizeName(name, sizeof(name), size, "compare");
+        PrintComparison(name, before, after, size);
+    }
+
+    Free(a);
+    Free(b);
+}
@@ -0,0 +1,163 @@
+#include <stdio.h>
+
+#include <Pandora/Core/Async/Parallel.h>
+#include <Pandora/Core/Data/Array.h>
+#include <Pandora/Core/Data/Memory.h>
+#include <Pandora/Core/Math/Random.h>
+#include <Pandora/Core/IO/Console.h>
+#include <Pandora/Core/Logging/PrintType.h>
+
+#include "Benchmark.h"
+
+using namespace pd;
+
+// As big as a sprite, sorted by depth like the sprite renderer does
+struct DepthItem {
+    f32 depth;
+    byte payload[44];
+};
+
+static void BenchParallelRadixSort() {
+    const int COUNTS[] = { 10000, 100000, 1000000 };
+
+    auto key = [](const DepthItem& item) {
+        return item.depth;
+    };
+
+    PrintHeader("Sorting random items by depth", "RadixSort", "parallel");
+
+    Array<DepthItem> source;
+    Array<DepthItem> work;
+
+    for (int count : COUNTS) {
+        source.Clear();
+        for (int i = 0; i < count; i++) {
+            DepthItem item = {};
+            item.depth = (f32)pd::random.Range(0, count);
+            source.Add(item);
+        }
+
+        work.Clear();
+        work.AddUninitialized(count);
+
+        // Every run sorts a fresh copy, the copy itself doesn't count
+        auto restore = [&]() {
+            MemoryCopy(work.Data(), source.Data(), (u64)count * sizeof(DepthItem));
+        };
+
+        f64 copy = Measure([&]() { restore(); KeepAlive(work[0]); });
+        f64 serial = Measure([&]() { restore(); work.RadixSort(key); }) - copy;
+        f64 parallel = Measure([&]() { restore(); ParallelRadixSort(work, key); }) - copy;
+
+        char name[64];
+        snprintf(name, sizeof(name), "%d RadixSort", count);
+        PrintComparison(name, serial, parallel);
+    }
+}
+
+static void BenchParallelLoops() {
+    const int COUNTS[] = { 10000, 1000000, 16000000 };
+
+    PrintHeader("Loops over f32 arrays", "serial loop", "parallel");
+
+    Array<f32> input;
+    Array<f32> output;
+
+    for (int count : COUNTS) {
+        input.Clear();
+        for (int i = 0; i < count; i++) {
+            input.Add((f32)(i % 1000) * 0.5f);
+        }
+
+        output.Clear();
+        output.AddUninitialized(count);
+
+        auto transform = [](f32 value) {
+            return value * 2.0f + 1.0f;
+        };
+
+        f64 serial = Measure([&]() {
+            for (int i = 0; i < count; i++) {
+                output[i] = transform(input[i]);
+            }
+            KeepAlive(output[count - 1]);
+        });
+
+        f64 parallel = Measure([&]() {
+            ParallelTransform(Slice<f32>(input.Data(), count), output.Data(), transform);
+            KeepAlive(output[count - 1]);
+        });
+
+        char name[64];
+        snprintf(name, sizeof(name), "%d Transform", count);
+        PrintComparison(name, serial, parallel, (u64)count * sizeof(f32) * 2);
+
+        auto add = [](f64 sum, f32 value) { return sum + value; };
+        auto combine = [](f64 a, f64 b) { return a + b; };
+
+        serial = Measure([&]() {
+            f64 sum = 0.0;
+            for (int i = 0; i < count; i++) {
+                sum = add(sum, input[i]);
+            }
+            KeepAlive(sum);
+        });
+
+        parallel = Measure([&]() {
+            KeepAlive(ParallelReduce(input, 0.0, add, combine));
+        });
+
+        snprintf(name, sizeof(name), "%d Reduce", count);
+        PrintComparison(name, serial, parallel, (u64)count * sizeof(f32));
+    }
+}
+
+static void BenchParallelSort() {
+    const int COUNTS[] = { 100000, 1000000 };
+
+    auto less = [](const DepthItem& a, const DepthItem& b) {
+        return a.depth < b.depth;
+    };
+
+    PrintHeader("Sorting random items by depth", "Sort", "parallel");
+
+    Array<DepthItem> source;
+    Array<DepthItem> work;
+
+    for (int count : COUNTS) {
+        source.Clear();
+        for (int i = 0; i < count; i++) {
+            DepthItem item = {};
+            item.depth = (f32)pd::random.Range(0, count);
+            source.Add(item);
+        }
+
+        work.Clear();
+        work.AddUninitialized(count);
+
+        auto restore = [&]() {
+            MemoryCopy(work.Data(), source.Data(), (u64)count * sizeof(DepthItem));
+        };
+
+        f64 copy = Measure([&]() { restore(); KeepAlive(work[0]); });
+        f64 serial = Measure([&]() { restore(); work.Sort(less); }) - copy;
+        f64 parallel = Measure([&]() { restore(); ParallelSort(work, less); }) - copy;
+
+        char name[64];
+        snprintf(name, sizeof(name), "%d Sort", count);
+        PrintComparison(name, serial, parallel);
+    }
+}
+
+void BenchParallel() {
+    workerPool.Create();
+
+    // The speedups only mean something next to the amount of threads that produced them
+    PrintfToStream(console, "\nParallel algorithms on %d workers plus the calling thread\n", workerPool.WorkerCount());
+
+    BenchParallelRadixSort();
+    BenchParallelSort();
+    BenchParallelLoops();
+
+    workerPool.Delete();
+}
@@ -0,0 +1,129 @@
+#include <stdio.h>
+
+#include <Pandora/Core/Data/Array.h>
+#include <Pandora/Core/Data/Memory.h>
+#include <Pandora/Core/Math/Vector.h>
+#include <Pandora/Core/Math/Random.h>
+#include <Pandora/Core/Logging/PrintType.h>
+
+#include "Benchmark.h"
+
+using namespace pd;
+
+// Stands in for `Sprite`, the fields the renderer copies around without the material
+struct BenchSprite {
+    Vec3 position;
+    Vec2 size;
+    Vec2 pivot;
+    f32 rotation;
+    u32 color;
+    void* material;
+};
+
+// The recursive Lomuto quicksort `Array::Sort` used before
+template<typename T, typename LessLambda>
+void OldQuickSort(T* data, int start, int end, LessLambda less) {
+    if (start >= end) return;
+
+    int i = start;
+    for (int j = start; j < end; j++) {
+        if (less(data[j], data[end])) {
+            std::swap(data[i], data[j]);
+            i += 1;
+        }
+    }
+
+    std::swap(data[i], data[end]);
+
+    OldQuickSort(data, start, i - 1, less);
+    OldQuickSort(data, i + 1, end, less);
+}
+
+enum class SortPattern {
+    Sorted,
+    Reversed,
+    Random,
+    Layers
+};
+
+static const char* SORT_PATTERN_NAMES[] = { "sorted", "reversed", "random", "8 layers" };
+
+static void FillSprites(Array<BenchSprite>& sprites, int count, SortPattern pattern) {
+    sprites.Clear();
+
+    for (int i = 0; i < count; i++) {
+        BenchSprite sprite = {};
+
+        switch (pattern) {
+            case SortPattern::Sorted: sprite.position.z = (f32)i; break;
+            case SortPattern::Reversed: sprite.position.z = (f32)(count - i); break;
+            case SortPattern::Random: sprite.position.z = (f32)random.Range(0, count); break;
+            case SortPattern::Layers: sprite.position.z = (f32)random.Range(0, 8); break;
+        }
+
+        sprites.Add(sprite);
+    }
+}
+
+void BenchSort() {
+    const int COUNTS[] = { 1000, 10000, 100000, 1000000 };
+
+    // The old sort recurses once per element on ordered input, past this it overflows the stack
+    const int OLD_ORDERED_LIMIT = 10000;
+
+    // With few distinct keys the old sort goes quadratic too, a million sprites take minutes
+    const int OLD_LAYERS_LIMIT = 100000;
+
+    auto less = [](const BenchSprite& a, const BenchSprite& b) {
+        return a.position.z < b.position.z;
+    };
+
+    auto key = [](const BenchSprite& sprite) {
+        return sprite.position.z;
+    };
+
+    Array<BenchSprite> source;
+    Array<BenchSprite> work;
+
+    for (int p = 0; p < 4; p++) {
+        SortPattern pattern = (SortPattern)p;
+
+        char title[64];
+        snprintf(title, sizeof(title), "Sorting %s sprites by depth", SORT_PATTERN_NAMES[p]);
+        PrintHeader(title, "old quicksort", "new");
+
+        for (int count : COUNTS) {
+            FillSprites(source, count, pattern);
+            work.Clear();
+            work.AddUninitialized(count);
+
+            // Every run sorts a fresh copy, the copy itself doesn't count
+            auto restore = [&]() {
+                MemoryCopy(work.Data(), source.Data(), (u64)count * sizeof(BenchSprite));
+            };
+
+            f64 copy = Measure([&]() { restore(); KeepAlive(work[0]); });
+
+            f64 before = -1.0;
+            bool oldFinishes = (pattern == SortPattern::Random) ||
+                               (pattern == SortPattern::Layers && count <= OLD_LAYERS_LIMIT) ||
+                               count <= OLD_ORDERED_LIMIT;
+
+            if (oldFinishes) {
+                before = Measure([&]() { restore(); OldQuickSort(work.Data(), 0, count - 1, less); }) - copy;
+            }
+
+            f64 sort = Measure([&]() { restore(); work.Sort(less); }) - copy;
+            f64 stable = Measure([&]() { restore(); work.StableSort(less); }) - copy;
+            f64 radix = Measure([&]() { restore(); work.RadixSort(key); }) - copy;
+
+            char name[64];
+            snprintf(name, sizeof(name), "%d Sort", count);
+            PrintComparison(name, before, sort);
+            snprintf(name, sizeof(name), "%d StableSort", count);
+            PrintComparison(name, before, stable);
+            snprintf(name, sizeof(name), "%d RadixSort", count);
+            PrintComparison(name, before, radix);
+        }
+    }
+}
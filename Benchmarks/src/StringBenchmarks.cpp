@@ -0,0 +1,134 @@
+#include <stdio.h>
+
+#include <Pandora/Core/Data/Allocator.h>
+#include <Pandora/Core/Data/String.h>
+#include <Pandora/Core/Encoding/Box.h>
+#include <Pandora/Core/Encoding/JSON.h>
+#include <Pandora/Core/IO/Console.h>
+#include <Pandora/Core/Logging/PrintType.h>
+
+#include "Benchmark.h"
+
+using namespace pd;
+
+// The longest text a string keeps inline
+const u64 STRING_INLINE_MAX = STRING_INLINE_SIZE - 2;
+
+// How big a string was before it got an inline buffer
+const u64 OLD_STRING_SIZE = 32;
+
+/**
+ * \brief Prints how many allocations the work made under the tag.
+ * Before short strings were stored inline every one of them was a heap allocation, so the old
+ * count is at least the new one plus the strings that stayed inline.
+ */
+template<typename Func>
+static void CompareAllocations(const char* name, MemoryTag tag, int inlineStrings, Func func) {
+    u64 start = GetMemoryTagStats(tag).totalAllocations;
+    func();
+    u64 allocations = GetMemoryTagStats(tag).totalAllocations - start;
+    u64 oldAllocations = allocations + (u64)inlineStrings;
+
+    PrintfToStream(console, "%-28s %14llu %14llu %8.2fx\n", name,
+                   (unsigned long long)oldAllocations, (unsigned long long)allocations,
+                   (f64)oldAllocations / (f64)allocations);
+}
+
+static void AppendKeyValue(String& source, const char* key, StringView value, int& inlineStrings) {
+    source.Append("\"");
+    source.Append(key);
+    source.Append("\": \"");
+    source.Append(value);
+    source.Append("\"");
+
+    inlineStrings += (value.SizeInBytes() <= STRING_INLINE_MAX) ? 1 : 0;
+    inlineStrings += 1;
+}
+
+// A resource list shaped like the data.json files, with many more items
+static void BenchJsonStrings() {
+    const int COUNTS[] = { 1000, 10000 };
+
+    for (int count : COUNTS) {
+        String source;
+        int inlineStrings = 1;
+        source.Append("{ \"compressed\": true, \"items\": [\n");
+
+        for (int i = 0; i < count; i++) {
+            String name;
+            name.Format("Textures/Tiles/tile_{}", i);
+
+            String path;
+            path.Format("data/textures/tiles/tile_{}.png", i);
+
+            source.Append((i > 0) ? ",\n{ " : "{ ");
+            AppendKeyValue(source, "name", name, inlineStrings);
+            source.Append(", ");
+            AppendKeyValue(source, "type", "Texture", inlineStrings);
+            source.Append(", ");
+            AppendKeyValue(source, "path", path, inlineStrings);
+            source.Append(", ");
+            AppendKeyValue(source, "filtering", "Linear", inlineStrings);
+            source.Append(" }");
+        }
+
+        source.Append("\n] }\n");
+
+        char row[64];
+        snprintf(row, sizeof(row), "%d item data.json", count);
+
+        CompareAllocations(row, MemoryTag::JSON, inlineStrings, [&]() {
+            JsonValue root;
+            root.Parse(source, false);
+            KeepAlive(root.Type());
+        });
+    }
+}
+
+// Fills the headers the way `Box::Load()` does
+static void BenchBoxHeaders() {
+    const int COUNTS[] = { 5000, 50000 };
+
+    for (int count : COUNTS) {
+        Array<String> names;
+        int inlineStrings = 0;
+
+        for (int i = 0; i < count; i++) {
+            String name;
+            name.Format((i % 2 == 0) ? "Sprites/s_{}" : "Textures/Tiles/tile_{}.png", i);
+            inlineStrings += (StringView(name).SizeInBytes() <= STRING_INLINE_MAX) ? 1 : 0;
+            names.Add(name);
+        }
+
+        char row[64];
+        snprintf(row, sizeof(row), "%d box headers", count);
+
+        CompareAllocations(row, MemoryTag::Box, inlineStrings, [&]() {
+            ScopedMemoryTag tag(MemoryTag::Box);
+            Array<BoxHeader> headers;
+
+            headers.Resize(count);
+            for (int i = 0; i < count; i++) {
+                headers.Reserve(1);
+                headers.Last().type = ResourceType::Texture;
+                headers.Last().name.Set(names[i]);
+                headers.Last().position = (u64)i * 4096;
+            }
+
+            KeepAlive(headers.Count());
+        });
+
+        PrintfToStream(console, "%-28s %14llu %14llu\n", "  header array bytes",
+                       (unsigned long long)((sizeof(BoxHeader) - sizeof(String) + OLD_STRING_SIZE) * count),
+                       (unsigned long long)(sizeof(BoxHeader) * count));
+    }
+}
+
+void BenchString() {
+    PrintfToStream(console, "\nAllocations, the old String had no inline buffer and was %llu bytes, the new one is %llu\n",
+                   (unsigned long long)OLD_STRING_SIZE, (unsigned long long)sizeof(String));
+    PrintfToStream(console, "%-28s %14s %14s %9s\n", "", "old (at least)", "new", "fewer");
+
+    BenchJsonStrings();
+    BenchBoxHeaders();
+}
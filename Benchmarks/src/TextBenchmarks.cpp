@@ -0,0 +1,137 @@
+#include <stdio.h>
+
+#include <Pandora/Core/Data/FlatMap.h>
+#include <Pandora/Core/Data/String.h>
+#include <Pandora/Core/Math/Random.h>
+
+#include "Benchmark.h"
+
+using namespace pd;
+
+// What `String::Count()` did before, utf8len over the whole text on every call
+static int OldCount(const String& text) {
+    const byte* u = (const byte*)text.Data();
+    if (!u) return 0;
+
+    int count = 0;
+    for (; *u; u++) {
+        if ((*u & 0xC0) != 0x80) count += 1;
+    }
+
+    return count;
+}
+
+// What `String::At()` did before, decoding from the start up to the index
+static codepoint OldAt(const String& text, int index) {
+    codepoint point = 0;
+    uchar* u = (uchar*)text.Data();
+
+    for (int i = 0; i < index + 1; i++) {
+        u = GetNextCodepoint(u, &point);
+    }
+
+    return point;
+}
+
+// Stands in for the font, every glyph only has an advance
+struct BenchFont {
+    FlatMap<codepoint, f32> advances;
+    f32 lineHeight = 18.0f;
+    f32 wrapWidth = 640.0f;
+
+    BenchFont() {
+        for (codepoint c = 0x20; c < 0x180; c++) {
+            advances.Insert(c, 6.0f + (f32)(c % 5));
+        }
+
+        advances.Insert(0x20AC, 9.0f);
+    }
+};
+
+// Places every character like `Text` does, wrapping at the edge
+struct LayoutResult {
+    f32 x = 0.0f;
+    f32 y = 0.0f;
+    int placed = 0;
+
+    void Place(const BenchFont& font, codepoint point) {
+        if (point == '\n' || x > font.wrapWidth) {
+            x = 0.0f;
+            y -= font.lineHeight;
+            if (point == '\n') return;
+        }
+
+        f32* advance = font.advances.Find(point);
+        x += (advance) ? *advance : 0.0f;
+        placed += 1;
+    }
+};
+
+static void MakeParagraph(String& text, int count, bool ascii) {
+    const char* WORDS[] = { "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "and", "runs" };
+    const char* ACCENTED[] = { "caf\xC3\xA9", "na\xC3\xAFve", "\xC3\xBC" "ber", "5\xE2\x82\xAC" };
+
+    text.Set("");
+
+    while (text.Count() < count) {
+        bool accented = !ascii && pd::random.Range(0, 6) == 0;
+        const char* word = (accented) ? ACCENTED[pd::random.Range(0, 4)] : WORDS[pd::random.Range(0, 10)];
+
+        text.Append(word);
+        text.Append((pd::random.Range(0, 40) == 0) ? "\n" : " ");
+    }
+}
+
+static void CompareLayout(const char* name, const BenchFont& font, const String& text) {
+    f64 before = Measure([&]() {
+        LayoutResult layout;
+        for (int i = 0; i < OldCount(text); i++) {
+            layout.Place(font, OldAt(text, i));
+        }
+        KeepAlive(layout.placed);
+    });
+
+    f64 indexed = Measure([&]() {
+        LayoutResult layout;
+        for (int i = 0; i < text.Count(); i++) {
+            layout.Place(font, text[i]);
+        }
+        KeepAlive(layout.placed);
+    });
+
+    f64 iterated = Measure([&]() {
+        LayoutResult layout;
+        for (codepoint point : text) {
+            layout.Place(font, point);
+        }
+        KeepAlive(layout.placed);
+    });
+
+    char row[64];
+    snprintf(row, sizeof(row), "%s, text[i]", name);
+    PrintComparison(row, before, indexed);
+
+    snprintf(row, sizeof(row), "%s, iterator", name);
+    PrintComparison(row, before, iterated);
+}
+
+void BenchText() {
+    const int COUNTS[] = { 1000, 10000 };
+
+    BenchFont font;
+    String text;
+
+    PrintHeader("Laying out a paragraph", "old At(i)", "new");
+
+    for (int count : COUNTS) {
+        char name[64];
+
+        MakeParagraph(text, count, true);
+        snprintf(name, sizeof(name), "%d ASCII", count);
+        CompareLayout(name, font, text);
+
+        MakeParagraph(text, count, false);
+        snprintf(name, sizeof(name), "%d UTF-8", count);
+        CompareLayout(name, font, text);
+    }
+}
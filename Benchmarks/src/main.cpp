@@ -0,0 +1,72 @@
+#include <Pandora/Core/Data/Allocator.h>
+#include <Pandora/Core/IO/Console.h>
+#include <Pandora/Core/Logging/PrintType.h>
+
+#include "Benchmark.h"
+
+using namespace pd;
+
+// Measures the engine's hot paths against the code they replaced.
+// Build with optimizations, the numbers are meaningless otherwise.
+//
+// Usage: Benchmarks [group...]
+// Runs every group if none are given.
+
+// @GLOBAL
+volatile byte benchmarkSink = 0;
+
+struct BenchmarkGroup {
+    const char* name;
+    void (*run)();
+};
+
+const BenchmarkGroup BENCHMARK_GROUPS[] = {
+    { "memory", BenchMemory },
+    { "sort", BenchSort },
+    { "parallel", BenchParallel },
+    { "dictionary", BenchDictionary },
+    { "flatmap", BenchFlatMap },
+    { "hash", BenchHash },
+    { "text", BenchText },
+    { "strings", BenchString },
+    { "log", BenchLog },
+    { "console", BenchConsole },
+    { "file", BenchFile },
+};
+
+void PrintHeader(const char* title, const char* beforeName, const char* afterName) {
+    PrintfToStream(console, "\n%s\n%-28s %14s %14s %9s %12s\n", title, "", beforeName, afterName, "speedup", "throughput");
+}
+
+void PrintComparison(const char* name, f64 before, f64 after, u64 bytes) {
+    if (before < 0.0) {
+        PrintfToStream(console, "%-28s %14s %11.1f ns %9s", name, "skipped", after, "");
+    } else {
+        PrintfToStream(console, "%-28s %11.1f ns %11.1f ns %8.2fx", name, before, after, before / after);
+    }
+
+    if (bytes > 0) {
+        PrintfToStream(console, " %8.2f GB/s", (f64)bytes / after);
+    }
+
+    console.WriteByte('\n');
+}
+
+int main(int argc, char** argv) {
+    for (const BenchmarkGroup& group : BENCHMARK_GROUPS) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; i++) {
+            selected |= strcmp(argv[i], group.name) == 0;
+        }
+
+        if (selected) {
+            group.run();
+            console.Flush();
+        }
+    }
+
+    DeleteTemporaryAllocator();
+    DeletePoolAllocator();
+
+    return 0;
+}
@@ -0,0 +1,54 @@
+
+#include <Pandora/Core/Data/Allocator.h>
+#include <Pandora/Core/IO/Console.h>
+#include <Pandora/Core/IO/FileStream.h>
+#include <Pandora/Core/Logging/BinaryLog.h>
+
+using namespace pd;
+
+// Turns a log written by pd::BinaryLog back into text.
+//
+// Usage: LogDecoder <binary log> [text output]
+// Writes to the console if no output file is given.
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        console.Log("Usage: {} <binary log> [text output]\n", argv[0]);
+        return 1;
+    }
+
+    int result = 0;
+
+    {
+        FileStream input(argv[1], FileMode::Read);
+        if (!input.IsOpen()) {
+            console.Log("[{}LogDecoder{}] couldn't open '{}'\n", ConColor::Red, ConColor::White, argv[1]);
+            return 1;
+        }
+
+        FileStream file;
+        Stream* output = &console;
+
+        if (argc > 2) {
+            if (!file.Open(argv[2], FileMode::Truncate)) {
+                console.Log("[{}LogDecoder{}] couldn't open '{}'\n", ConColor::Red, ConColor::White, argv[2]);
+                return 1;
+            }
+
+            output = &file;
+        }
+
+        if (!DecodeBinaryLog(input, *output)) {
+            console.Log("\n[{}LogDecoder{}] '{}' is not a binary log or is corrupted\n",
+                        ConColor::Red, ConColor::White, argv[1]);
+            result = 1;
+        }
+
+        output->Flush();
+    }
+
+    DeleteTemporaryAllocator();
+    DeletePoolAllocator();
+
+    return result;
+}
@@ -18,6 +18,8 @@ App::App(int argc, char** argv, VideoBackend backend, StringView title, Vec2i si
     }
 
     random.Seed();
+    asyncLog.Create();
+
     if (SDL_Init(SDL_SUBSYSTEMS) != 0) {
         console.Log("[{}SDL Error{}] couldn't initialize SDL: {}\n", ConColor::Red, ConColor::White, SDL_GetError());
     }
@@ -68,6 +70,13 @@ App::~App() {
     AudioAPI::Delete();
     window.Delete();
     DeleteStorage();
+    DeleteNames();
+
+    workerPool.Delete();
+    asyncLog.Delete();
+
+    // Get out whatever is still buffered
+    console.Flush();
 
     SDL_Quit();
 }
@@ -91,13 +100,22 @@ void App::Run() {
     Stopwatch deltaClock;
 
     while (IsRunning()) {
+        // Temporary allocations only live for a single frame
+        ResetTemporaryAllocator();
+        ResetFrameMemoryStats();
+
         rawDelta = (f32)deltaClock.Restart().seconds;
 
-        OnUpdateInternal(rawDelta * updateTimescale);
+        {
+            // Everything the game does that isn't tagged by an engine subsystem
+            ScopedMemoryTag tag(MemoryTag::Game);
+
+            OnUpdateInternal(rawDelta * updateTimescale);
 
-        video->BindDefaultFrameBuffer();
-        OnRenderInternal(rawDelta * renderTimescale);
-        video->BindDefaultFrameBuffer();
+            video->BindDefaultFrameBuffer();
+            OnRenderInternal(rawDelta * renderTimescale);
+            video->BindDefaultFrameBuffer();
+        }
 
 #if !defined(PD_NO_IMGUI)
         OnImGuiInternal();
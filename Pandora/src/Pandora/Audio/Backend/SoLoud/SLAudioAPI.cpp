@@ -97,6 +97,7 @@ void SLAudioAPI::Seek(AudioHandle handle, Duration time) {
 
 void SLAudioAPI::SetAudioRequestHandler(ResourceCatalog& catalog) {
     catalog.SetResourceRequestHandler(ResourceType::Audio, [](Box& box, ResourceType type, StringView name, void* data) {
+        ScopedMemoryTag tag(MemoryTag::Audio);
         SLAudio* sound = New<SLAudio>();
 
         // Apply import options
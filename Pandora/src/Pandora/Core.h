@@ -10,15 +10,23 @@
 
 #include "Pandora/Core/Logging/PrintType.h"
 #include "Pandora/Core/Logging/Logging.h"
+#include "Pandora/Core/Logging/AsyncLog.h"
+#include "Pandora/Core/Logging/BinaryLog.h"
 
 #include "Pandora/Core/Data/Allocator.h"
+#include "Pandora/Core/Data/MemoryStats.h"
+#include "Pandora/Core/Data/LeakTracker.h"
 #include "Pandora/Core/Data/Memory.h"
 #include "Pandora/Core/Data/Slice.h"
+#include "Pandora/Core/Data/Sort.h"
 #include "Pandora/Core/Data/Array.h"
 #include "Pandora/Core/Data/StringView.h"
 #include "Pandora/Core/Data/String.h"
+#include "Pandora/Core/Data/StringBuilder.h"
 #include "Pandora/Core/Data/Hash.h"
 #include "Pandora/Core/Data/Dictionary.h"
+#include "Pandora/Core/Data/FlatMap.h"
+#include "Pandora/Core/Data/Name.h"
 #include "Pandora/Core/Data/Reference.h"
 #include "Pandora/Core/Data/Pair.h"
 #include "Pandora/Core/Data/Optional.h"
@@ -31,6 +39,7 @@
 #include "Pandora/Core/Math/Matrix.h"
 #include "Pandora/Core/Math/Perlin.h"
 
+#include "Pandora/Core/Encoding/UTF8.h"
 #include "Pandora/Core/Encoding/Compression.h"
 #include "Pandora/Core/Encoding/Encryption.h"
 #include "Pandora/Core/Encoding/Base64.h"
@@ -56,6 +65,8 @@
 #include "Pandora/Core/Async/Lock.h"
 #include "Pandora/Core/Async/Condition.h"
 #include "Pandora/Core/Async/Semaphore.h"
+#include "Pandora/Core/Async/WorkerPool.h"
+#include "Pandora/Core/Async/Parallel.h"
 
 #include "Pandora/Core/Input/Key.h"
 #include "Pandora/Core/Input/Input.h"
@@ -7,6 +7,8 @@
 #include "Pandora/Core/IO/Folder.h"
 
 #include "Pandora/Core/Data/String.h"
+#include "Pandora/Core/Logging/AsyncLog.h"
+#include "Pandora/Core/IO/Console.h"
 
 #include "Pandora/Core/Time/Time.h"
 
@@ -43,6 +45,10 @@ void Crash(bool expr, const char* file, const char* function, int line, const ch
     vsprintf(buffer, fmt, args);
     va_end(args);
 
+    // Get out whatever was logged before the crash
+    asyncLog.Flush();
+    console.Flush();
+
     String message;
     message.Format("A crash has occurred at:\n{}:{}(...):{}\n\nMessage: {}\n\nA crash log has been generated.",
                    file, function, line, &buffer[0]);
@@ -127,6 +133,10 @@ void Crash(bool expr, const char* file, const char* function, int line, const ch
     vsprintf(buffer, fmt, args);
     va_end(args);
 
+    // Get out whatever was logged before the crash
+    asyncLog.Flush();
+    console.Flush();
+
     String message;
     message.Format("A crash has occurred at:\n{}:{}(...):{}\n\nMessage: {}\n\nA crash log has been generated.",
                    file, function, line, &buffer[0]);
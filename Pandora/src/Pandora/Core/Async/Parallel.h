@@ -0,0 +1,558 @@
+#pragma once
+
+#include <new>
+#include <atomic>
+#include <utility>
+#include <type_traits>
+
+#include "Pandora/Core/Types.h"
+#include "Pandora/Core/Async/WorkerPool.h"
+#include "Pandora/Core/Data/Allocator.h"
+#include "Pandora/Core/Data/Array.h"
+#include "Pandora/Core/Data/Slice.h"
+#include "Pandora/Core/Data/Sort.h"
+
+namespace pd {
+
+/**
+ * \brief The grain size used when none is given and the work is split deterministically.
+ */
+const int PARALLEL_DETERMINISTIC_GRAIN = 2048;
+
+/**
+ * \brief The smallest grain size that gets picked automatically.
+ */
+const int PARALLEL_MIN_GRAIN = 256;
+
+/**
+ * \brief How many chunks every thread gets when the grain size is picked automatically.
+ * More chunks balance uneven work better at the cost of more scheduling.
+ */
+const int PARALLEL_CHUNKS_PER_THREAD = 4;
+
+struct ParallelOptions {
+    // How many elements every chunk holds, 0 picks one based on the element and worker count
+    int grainSize = 0;
+
+    // Splits the work the same way regardless of how many workers there are, so results
+    // like floating point sums and the order of equal elements are the same on every machine
+    bool deterministic = false;
+};
+
+/**
+ * \param count How many elements there are.
+ * \param options The options.
+ * \return How many elements every chunk holds.
+ */
+inline int ParallelGrainSize(int count, ParallelOptions options) {
+    if (options.grainSize > 0) return options.grainSize;
+    if (options.deterministic) return PARALLEL_DETERMINISTIC_GRAIN;
+
+    int threads = workerPool.WorkerCount() + 1;
+    int grain = count / (threads * PARALLEL_CHUNKS_PER_THREAD);
+
+    return (grain > PARALLEL_MIN_GRAIN) ? grain : PARALLEL_MIN_GRAIN;
+}
+
+/**
+ * \param count How many elements there are.
+ * \param grainSize How many elements every chunk holds.
+ * \return How many chunks the elements get split up in.
+ */
+inline int ParallelChunkCount(int count, int grainSize) {
+    return (int)(((i64)count + grainSize - 1) / grainSize);
+}
+
+/**
+ * \brief Runs `body(chunk, start, end)` for every chunk on the worker pool.
+ */
+template<typename ChunkLambda>
+void RunParallelChunks(int count, int grainSize, ChunkLambda& body) {
+    workerPool.Run(count, grainSize, [](void* data, int chunk, int start, int end) {
+        (*(ChunkLambda*)data)(chunk, start, end);
+    }, &body);
+}
+
+/**
+ * \brief Calls `func(start, end)` for chunks of the range in parallel.
+ *
+ * \param count How many elements to process.
+ * \param func The function to run for every chunk.
+ * \param options The options.
+ */
+template<typename RangeLambda>
+void ParallelForRange(int count, RangeLambda func, ParallelOptions options = ParallelOptions()) {
+    auto body = [&func](int /*chunk*/, int start, int end) {
+        func(start, end);
+    };
+
+    RunParallelChunks(count, ParallelGrainSize(count, options), body);
+}
+
+/**
+ * \brief Calls `func(index)` for every index in parallel.
+ *
+ * \param count How many indices there are.
+ * \param func The function to run for every index.
+ * \param options The options.
+ */
+template<typename IndexLambda>
+void ParallelFor(int count, IndexLambda func, ParallelOptions options = ParallelOptions()) {
+    auto body = [&func](int /*chunk*/, int start, int end) {
+        for (int i = start; i < end; i++) {
+            func(i);
+        }
+    };
+
+    RunParallelChunks(count, ParallelGrainSize(count, options), body);
+}
+
+/**
+ * \brief Stores `func(input[i])` in `output[i]` in parallel.
+ *
+ * \param input The input elements.
+ * \param output The output buffer, must hold as many elements as the input.
+ * \param func The transform function.
+ * \param options The options.
+ */
+template<typename T, typename U, typename TransformLambda>
+void ParallelTransform(Slice<T> input, U* output, TransformLambda func, ParallelOptions options = ParallelOptions()) {
+    T* in = input.Data();
+
+    auto body = [&func, in, output](int /*chunk*/, int start, int end) {
+        for (int i = start; i < end; i++) {
+            output[i] = func(in[i]);
+        }
+    };
+
+    RunParallelChunks(input.Count(), ParallelGrainSize(input.Count(), options), body);
+}
+
+/**
+ * \brief Replaces the output elements with `func(input[i])` in parallel.
+ *
+ * \param input The input elements.
+ * \param output The output array.
+ * \param func The transform function.
+ * \param options The options.
+ */
+template<typename T, typename U, typename TransformLambda>
+void ParallelTransform(const Array<T>& input, Array<U>& output, TransformLambda func,
+                       ParallelOptions options = ParallelOptions()) {
+    output.Clear();
+    output.Reserve(input.Count());
+
+    ParallelTransform(Slice<T>(input.Data(), input.Count()), output.Data(), func, options);
+}
+
+/**
+ * \brief Reduces the elements in parallel.
+ * Every chunk gets reduced on its own starting from `identity`, then the chunk results are combined in order.
+ *
+ * \param input The input elements.
+ * \param identity The starting value, combining it with a value must not change the value.
+ * \param reduce Returns the result of adding an element to the accumulated value, `reduce(U, const T&)`.
+ * \param combine Returns the result of combining two accumulated values, `combine(U, U)`.
+ * \param options The options.
+ * \return The reduced value.
+ */
+template<typename T, typename U, typename ReduceLambda, typename CombineLambda>
+U ParallelReduce(Slice<T> input, U identity, ReduceLambda reduce, CombineLambda combine,
+                 ParallelOptions options = ParallelOptions()) {
+    int count = input.Count();
+    if (count <= 0) return identity;
+
+    int grainSize = ParallelGrainSize(count, options);
+    int chunkCount = ParallelChunkCount(count, grainSize);
+
+    U* partials = (U*)Alloc(sizeof(U) * chunkCount, Allocator::Persistent, alignof(U));
+    T* in = input.Data();
+
+    auto body = [&reduce, &identity, partials, in](int chunk, int start, int end) {
+        U value = identity;
+
+        for (int i = start; i < end; i++) {
+            value = reduce(std::move(value), in[i]);
+        }
+
+        new (partials + chunk) U(std::move(value));
+    };
+
+    RunParallelChunks(count, grainSize, body);
+
+    // Combining in chunk order keeps the result the same for the same grain size
+    U result = identity;
+    for (int i = 0; i < chunkCount; i++) {
+        result = combine(std::move(result), std::move(partials[i]));
+        partials[i].~U();
+    }
+
+    Free(partials);
+
+    return result;
+}
+
+/**
+ * \brief Reduces the elements in parallel.
+ *
+ * \param input The input array.
+ * \param identity The starting value, combining it with a value must not change the value.
+ * \param reduce Returns the result of adding an element to the accumulated value, `reduce(U, const T&)`.
+ * \param combine Returns the result of combining two accumulated values, `combine(U, U)`.
+ * \param options The options.
+ * \return The reduced value.
+ */
+template<typename T, typename U, typename ReduceLambda, typename CombineLambda>
+U ParallelReduce(const Array<T>& input, U identity, ReduceLambda reduce, CombineLambda combine,
+                 ParallelOptions options = ParallelOptions()) {
+    return ParallelReduce(Slice<T>(input.Data(), input.Count()), std::move(identity), reduce, combine, options);
+}
+
+/**
+ * \brief Moves all elements that match the predicate to the front in parallel.
+ * The partition is stable, elements keep their order on both sides.
+ *
+ * \param data The elements.
+ * \param pred Needs to return true for elements that go in front.
+ * \param options The options.
+ * \return How many elements matched, which is the index of the first element that didn't.
+ */
+template<typename T, typename PredLambda>
+int ParallelPartition(Slice<T> data, PredLambda pred, ParallelOptions options = ParallelOptions()) {
+    int count = data.Count();
+    if (count <= 0) return 0;
+
+    int grainSize = ParallelGrainSize(count, options);
+    int chunkCount = ParallelChunkCount(count, grainSize);
+
+    T* elements = data.Data();
+
+    // One allocation for the predicate results, the per-chunk offsets and the moved elements,
+    // every part starts at an alignment that works for both the offsets and the elements
+    const u64 alignment = (alignof(T) > alignof(int)) ? alignof(T) : alignof(int);
+
+    u64 flagsSize = ((u64)count + alignment - 1) / alignment * alignment;
+    u64 offsetsSize = ((sizeof(int) * (u64)chunkCount) + alignment - 1) / alignment * alignment;
+    byte* scratch = (byte*)Alloc(flagsSize + offsetsSize + sizeof(T) * (u64)count, Allocator::Persistent, alignment);
+
+    byte* flags = scratch;
+    int* offsets = (int*)(scratch + flagsSize);
+    T* moved = (T*)(scratch + flagsSize + offsetsSize);
+
+    // Evaluate the predicate once and count the matches of every chunk
+    auto countBody = [&pred, elements, flags, offsets](int chunk, int start, int end) {
+        int matches = 0;
+
+        for (int i = start; i < end; i++) {
+            flags[i] = pred(elements[i]) ? 1 : 0;
+            matches += flags[i];
+        }
+
+        offsets[chunk] = matches;
+    };
+
+    RunParallelChunks(count, grainSize, countBody);
+
+    int matchCount = 0;
+    for (int i = 0; i < chunkCount; i++) {
+        int matches = offsets[i];
+        offsets[i] = matchCount;
+        matchCount += matches;
+    }
+
+    // Scatter every element to its final spot
+    auto scatterBody = [elements, flags, offsets, moved, matchCount](int chunk, int start, int end) {
+        int matched = offsets[chunk];
+        int unmatched = matchCount + (start - offsets[chunk]);
+
+        for (int i = start; i < end; i++) {
+            int target = (flags[i]) ? matched++ : unmatched++;
+            new (moved + target) T(std::move(elements[i]));
+        }
+    };
+
+    RunParallelChunks(count, grainSize, scatterBody);
+
+    auto moveBackBody = [elements, moved](int /*chunk*/, int start, int end) {
+        if (std::is_trivially_copyable<T>::value) {
+            MemoryCopy(elements + start, moved + start, sizeof(T) * (u64)(end - start));
+        } else {
+            for (int i = start; i < end; i++) {
+                elements[i] = std::move(moved[i]);
+                moved[i].~T();
+            }
+        }
+    };
+
+    RunParallelChunks(count, grainSize, moveBackBody);
+
+    Free(scratch);
+
+    return matchCount;
+}
+
+/**
+ * \brief Moves all elements that match the predicate to the front in parallel.
+ * The partition is stable, elements keep their order on both sides.
+ *
+ * \param array The array.
+ * \param pred Needs to return true for elements that go in front.
+ * \param options The options.
+ * \return How many elements matched, which is the index of the first element that didn't.
+ */
+template<typename T, typename PredLambda>
+int ParallelPartition(Array<T>& array, PredLambda pred, ParallelOptions options = ParallelOptions()) {
+    return ParallelPartition(Slice<T>(array.Data(), array.Count()), pred, options);
+}
+
+/**
+ * \brief Sorts the elements in parallel.
+ * Runs of the range get sorted with `IntroSort()` on the workers and are then merged pairwise.
+ * The sort is not stable, but it is deterministic when `options.deterministic` is set.
+ *
+ * \param data The elements.
+ * \param less Needs to return true if `a` goes before `b`.
+ * \param options The options. The grain size is the smallest size of a run.
+ */
+template<typename T, typename LessLambda>
+void ParallelSort(Slice<T> data, LessLambda less, ParallelOptions options = ParallelOptions()) {
+    int count = data.Count();
+    T* elements = data.Data();
+
+    int grainSize = ParallelGrainSize(count, options);
+
+    // The number of runs is a power of two so every merge level halves it
+    int runCount = 1;
+    while ((i64)runCount * 2 * grainSize <= count) {
+        runCount *= 2;
+    }
+
+    if (runCount == 1) {
+        IntroSort(elements, count, less);
+        return;
+    }
+
+    auto runStart = [count, runCount](int run) {
+        return (int)((i64)count * run / runCount);
+    };
+
+    auto sortBody = [&less, &runStart, elements](int /*chunk*/, int start, int end) {
+        for (int run = start; run < end; run++) {
+            int first = runStart(run);
+            IntroSort(elements + first, runStart(run + 1) - first, less);
+        }
+    };
+
+    RunParallelChunks(runCount, 1, sortBody);
+
+    T* buffer = (T*)Alloc(sizeof(T) * (u64)count, Allocator::Persistent, alignof(T));
+
+    for (int width = 1; width < runCount; width *= 2) {
+        // Every merge uses the part of the buffer under its own runs, so they don't overlap
+        auto mergeBody = [&less, &runStart, elements, buffer, width](int /*chunk*/, int start, int end) {
+            for (int pair = start; pair < end; pair++) {
+                int first = runStart(pair * width * 2);
+                int middle = runStart(pair * width * 2 + width);
+                int last = runStart(pair * width * 2 + width * 2);
+
+                MergeAdjacent(elements + first, middle - first, last - first, buffer + first, less);
+            }
+        };
+
+        RunParallelChunks(runCount / (width * 2), 1, mergeBody);
+    }
+
+    Free(buffer);
+}
+
+/**
+ * \brief Sorts the array in parallel.
+ *
+ * \param array The array.
+ * \param less Needs to return true if `a` goes before `b`.
+ * \param options The options. The grain size is the smallest size of a run.
+ */
+template<typename T, typename LessLambda>
+void ParallelSort(Array<T>& array, LessLambda less, ParallelOptions options = ParallelOptions()) {
+    ParallelSort(Slice<T>(array.Data(), array.Count()), less, options);
+}
+
+/**
+ * \brief Below this many elements `ParallelRadixSort()` sorts on the calling thread,
+ * starting the passes on the workers costs more than they save.
+ */
+const int PARALLEL_RADIX_SORT_MIN_COUNT = 32768;
+
+/**
+ * \brief Sorts the elements by the key of every element in parallel, see `RadixSort()`.
+ * Every chunk counts and scatters its own elements, so equal keys keep their order and
+ * the result doesn't depend on the grain size.
+ * Elements that aren't trivially copyable are moved into place on the calling thread,
+ * because their copies may touch shared state like reference counts.
+ *
+ * \param data The elements.
+ * \param keyFunc Returns the key of an element.
+ * \param options The options.
+ */
+template<typename T, typename KeyLambda>
+void ParallelRadixSort(Slice<T> data, KeyLambda keyFunc, ParallelOptions options = ParallelOptions()) {
+    int count = data.Count();
+    T* elements = data.Data();
+
+    int grainSize = ParallelGrainSize(count, options);
+    int chunkCount = ParallelChunkCount(count, grainSize);
+
+    if (count < PARALLEL_RADIX_SORT_MIN_COUNT || chunkCount <= 1) {
+        RadixSort(elements, count, keyFunc);
+        return;
+    }
+
+    using Key = decltype(ToRadixKey(keyFunc(*elements)));
+
+    struct Entry {
+        Key key;
+        u32 index;
+    };
+
+    const int RADIX = 256;
+    const int PASSES = (int)sizeof(Key);
+
+    // One allocation for the digit counts of every chunk, the keys, the scratch keys and the sorted elements
+    const u64 alignment = (alignof(T) > alignof(Entry)) ? alignof(T) : alignof(Entry);
+
+    u64 countsSize = (sizeof(u32) * PASSES * RADIX * (u64)chunkCount + alignment - 1) / alignment * alignment;
+    u64 entriesSize = ((u64)count * sizeof(Entry) * 2 + alignment - 1) / alignment * alignment;
+    byte* buffer = (byte*)Alloc(countsSize + entriesSize + sizeof(T) * (u64)count, Allocator::Persistent, alignment);
+
+    // Laid out as [chunk][pass][digit]
+    u32* counts = (u32*)buffer;
+    Entry* entries = (Entry*)(buffer + countsSize);
+    Entry* scratch = entries + count;
+
+    std::atomic<bool> unsorted{ false };
+
+    // Read every key once, count the digits of every pass and check if the elements are in order already
+    auto keyBody = [&keyFunc, &unsorted, elements, counts, entries](int chunk, int start, int end) {
+        u32* chunkCounts = counts + (u64)chunk * PASSES * RADIX;
+        MemorySet(chunkCounts, sizeof(u32) * PASSES * RADIX, 0);
+
+        Key previous = ToRadixKey(keyFunc(elements[(start > 0) ? start - 1 : 0]));
+        bool sorted = true;
+
+        for (int i = start; i < end; i++) {
+            Key key = ToRadixKey(keyFunc(elements[i]));
+
+            if (key < previous) sorted = false;
+            previous = key;
+
+            entries[i].key = key;
+            entries[i].index = (u32)i;
+
+            for (int pass = 0; pass < PASSES; pass++) {
+                chunkCounts[pass * RADIX + ((key >> (pass * 8)) & 0xFF)] += 1;
+            }
+        }
+
+        if (!sorted) {
+            unsorted.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    RunParallelChunks(count, grainSize, keyBody);
+
+    bool moved = false;
+    for (int pass = 0; pass < PASSES && unsorted.load(std::memory_order_relaxed); pass++) {
+        // The chunk counts are only right for the original order, once something moved they need a recount
+        if (moved) {
+            auto countBody = [entries, counts, pass](int chunk, int start, int end) {
+                u32* passCounts = counts + ((u64)chunk * PASSES + pass) * RADIX;
+                MemorySet(passCounts, sizeof(u32) * RADIX, 0);
+
+                for (int i = start; i < end; i++) {
+                    passCounts[(entries[i].key >> (pass * 8)) & 0xFF] += 1;
+                }
+            };
+
+            RunParallelChunks(count, grainSize, countBody);
+        }
+
+        // Every key has the same digit, nothing would move
+        u32 firstDigit = (entries[0].key >> (pass * 8)) & 0xFF;
+        u32 firstDigitCount = 0;
+        for (int chunk = 0; chunk < chunkCount; chunk++) {
+            firstDigitCount += counts[((u64)chunk * PASSES + pass) * RADIX + firstDigit];
+        }
+
+        if (firstDigitCount == (u32)count) continue;
+
+        // Turn the counts into the spot where every chunk puts its first element of every digit
+        u32 offset = 0;
+        for (int digit = 0; digit < RADIX; digit++) {
+            for (int chunk = 0; chunk < chunkCount; chunk++) {
+                u32& digitCount = counts[((u64)chunk * PASSES + pass) * RADIX + digit];
+                u32 chunkDigitCount = digitCount;
+                digitCount = offset;
+                offset += chunkDigitCount;
+            }
+        }
+
+        auto scatterBody = [entries, scratch, counts, pass](int chunk, int start, int end) {
+            u32* offsets = counts + ((u64)chunk * PASSES + pass) * RADIX;
+
+            for (int i = start; i < end; i++) {
+                scratch[offsets[(entries[i].key >> (pass * 8)) & 0xFF]++] = entries[i];
+            }
+        };
+
+        RunParallelChunks(count, grainSize, scatterBody);
+
+        std::swap(entries, scratch);
+        moved = true;
+    }
+
+    if (moved) {
+        // Put the elements in their sorted order
+        T* ordered = (T*)(buffer + countsSize + entriesSize);
+
+        if (std::is_trivially_copyable<T>::value) {
+            auto gatherBody = [elements, entries, ordered](int /*chunk*/, int start, int end) {
+                for (int i = start; i < end; i++) {
+                    MemoryCopy(ordered + i, elements + entries[i].index, sizeof(T));
+                }
+            };
+
+            RunParallelChunks(count, grainSize, gatherBody);
+
+            auto moveBackBody = [elements, ordered](int /*chunk*/, int start, int end) {
+                MemoryCopy(elements + start, ordered + start, sizeof(T) * (u64)(end - start));
+            };
+
+            RunParallelChunks(count, grainSize, moveBackBody);
+        } else {
+            for (int i = 0; i < count; i++) {
+                new (ordered + i) T(std::move(elements[entries[i].index]));
+            }
+
+            for (int i = 0; i < count; i++) {
+                elements[i] = std::move(ordered[i]);
+                ordered[i].~T();
+            }
+        }
+    }
+
+    Free(buffer);
+}
+
+/**
+ * \brief Sorts the array by the key of every element in parallel, see `RadixSort()`.
+ *
+ * \param array The array.
+ * \param keyFunc Returns the key of an element.
+ * \param options The options.
+ */
+template<typename T, typename KeyLambda>
+void ParallelRadixSort(Array<T>& array, KeyLambda keyFunc, ParallelOptions options = ParallelOptions()) {
+    ParallelRadixSort(Slice<T>(array.Data(), array.Count()), keyFunc, options);
+}
+
+}
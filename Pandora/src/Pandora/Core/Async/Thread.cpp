@@ -24,9 +24,12 @@ void Thread::Detach() {
 }
 
 void Thread::Join() {
-    if (isDetached) return;
+    if (isDetached || !nativeData) return;
 
     SDL_WaitThread(SDL_THREAD, nullptr);
+
+    // The handle is freed once it's waited on, don't join it again on destruction
+    nativeData = nullptr;
 }
 
 void Thread::SetPriority(ThreadPriority priority) {
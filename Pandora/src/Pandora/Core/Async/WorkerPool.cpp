@@ -0,0 +1,201 @@
+#include "WorkerPool.h"
+
+#include <new>
+#include <thread>
+
+#include <SDL2/SDL.h>
+
+#include "Pandora/Core/Assert.h"
+#include "Pandora/Core/Async/Lock.h"
+
+namespace pd {
+
+// @GLOBAL
+WorkerPool workerPool;
+
+// The most worker threads that will be started
+const int MAX_WORKER_COUNT = 64;
+
+WorkerPool::~WorkerPool() {
+    Delete();
+}
+
+void WorkerPool::Create(int workerCount) {
+    Lock lock(jobLock);
+
+    if (created) return;
+
+    if (workerCount < 0) {
+        workerCount = SDL_GetCPUCount() - 1;
+    }
+
+    if (workerCount > MAX_WORKER_COUNT) {
+        workerCount = MAX_WORKER_COUNT;
+    }
+
+    stopping = false;
+
+    if (workerCount > 0) {
+        threads = (Thread*)Alloc(sizeof(Thread) * workerCount);
+        threadCount = workerCount;
+
+        for (int i = 0; i < threadCount; i++) {
+            new (&threads[i]) Thread();
+            threads[i].Create(WorkerMain, this, "Pandora Worker");
+        }
+    }
+
+    created = true;
+}
+
+void WorkerPool::Delete() {
+    if (!created) return;
+
+    stopping = true;
+
+    for (int i = 0; i < threadCount; i++) {
+        wakeUp.Post();
+    }
+
+    for (int i = 0; i < threadCount; i++) {
+        threads[i].~Thread();
+    }
+
+    if (threads) {
+        Free(threads);
+    }
+
+    threads = nullptr;
+    threadCount = 0;
+    created = false;
+}
+
+int WorkerPool::WorkerCount() const {
+    return threadCount;
+}
+
+void WorkerPool::Run(int count, int grainSize, ParallelChunkFunc* func, void* data) {
+    if (count <= 0) return;
+
+    PD_ASSERT_D(grainSize > 0, "grain size must be positive, given: %d", grainSize);
+
+    if (!created) {
+        Create();
+    }
+
+    ParallelJob job;
+    job.func = func;
+    job.data = data;
+    job.count = count;
+    job.grainSize = grainSize;
+    job.chunkCount = (int)(((i64)count + grainSize - 1) / grainSize);
+    job.tag = GetMemoryTag();
+
+    // Not worth waking anyone up for
+    if (job.chunkCount == 1 || threadCount == 0) {
+        for (int i = 0; i < job.chunkCount; i++) {
+            int start = i * grainSize;
+            int end = (count - start > grainSize) ? start + grainSize : count;
+
+            func(data, i, start, end);
+        }
+
+        return;
+    }
+
+    {
+        Lock lock(jobLock);
+        job.next = jobs;
+        jobs = &job;
+    }
+
+    // We take one chunk ourselves
+    int wakeCount = (job.chunkCount - 1 < threadCount) ? job.chunkCount - 1 : threadCount;
+    for (int i = 0; i < wakeCount; i++) {
+        wakeUp.Post();
+    }
+
+    int chunk = job.nextChunk.fetch_add(1);
+    if (chunk < job.chunkCount) {
+        RunChunks(&job, chunk);
+    }
+
+    // Help out with other jobs while the workers finish ours
+    while (job.finishedChunks.load(std::memory_order_acquire) < job.chunkCount) {
+        ParallelJob* other = ClaimChunk(chunk);
+
+        if (other) {
+            RunChunks(other, chunk);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    Lock lock(jobLock);
+
+    for (ParallelJob** link = &jobs; *link; link = &(*link)->next) {
+        if (*link == &job) {
+            *link = job.next;
+            break;
+        }
+    }
+}
+
+void WorkerPool::WorkerMain(void* data) {
+    WorkerPool* pool = (WorkerPool*)data;
+
+    while (true) {
+        pool->wakeUp.Wait();
+
+        if (pool->stopping) break;
+
+        int chunk = 0;
+        ParallelJob* job = nullptr;
+
+        while ((job = pool->ClaimChunk(chunk))) {
+            pool->RunChunks(job, chunk);
+        }
+    }
+
+    DeleteTemporaryAllocator();
+}
+
+ParallelJob* WorkerPool::ClaimChunk(int& chunk) {
+    Lock lock(jobLock);
+
+    // Claiming under the lock makes sure the job can't finish and disappear before we run the chunk
+    for (ParallelJob* job = jobs; job; job = job->next) {
+        if (job->nextChunk.load(std::memory_order_relaxed) >= job->chunkCount) continue;
+
+        chunk = job->nextChunk.fetch_add(1);
+        if (chunk < job->chunkCount) {
+            return job;
+        }
+    }
+
+    return nullptr;
+}
+
+void WorkerPool::RunChunks(ParallelJob* job, int chunk) {
+    ScopedMemoryTag tag(job->tag);
+
+    // Once the last chunk is finished the job can be freed, so it can't be read after that
+    int chunkCount = job->chunkCount;
+
+    while (true) {
+        int start = chunk * job->grainSize;
+        int end = (job->count - start > job->grainSize) ? start + job->grainSize : job->count;
+
+        job->func(job->data, chunk, start, end);
+
+        // Claim the next chunk before finishing this one, an unfinished chunk keeps the job alive
+        int nextChunk = job->nextChunk.fetch_add(1);
+        job->finishedChunks.fetch_add(1, std::memory_order_release);
+
+        if (nextChunk >= chunkCount) break;
+
+        chunk = nextChunk;
+    }
+}
+
+}
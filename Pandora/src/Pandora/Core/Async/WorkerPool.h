@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+
+#include "Pandora/Core/Types.h"
+#include "Pandora/Core/Async/Thread.h"
+#include "Pandora/Core/Async/Mutex.h"
+#include "Pandora/Core/Async/Semaphore.h"
+#include "Pandora/Core/Data/Allocator.h"
+
+namespace pd {
+
+/**
+ * \brief Runs one chunk of a parallel job.
+ *
+ * \param data The job data.
+ * \param chunk The index of the chunk.
+ * \param start The first index of the chunk.
+ * \param end One past the last index of the chunk.
+ */
+typedef void(ParallelChunkFunc)(void* data, int chunk, int start, int end);
+
+/**
+ * \brief A range of work that gets split up in chunks of `grainSize` elements.
+ */
+struct ParallelJob {
+    ParallelChunkFunc* func = nullptr;
+    void* data = nullptr;
+
+    int count = 0;
+    int grainSize = 0;
+    int chunkCount = 0;
+
+    // The memory tag of the thread that started the job
+    MemoryTag tag = MemoryTag::General;
+
+    std::atomic<int> nextChunk{ 0 };
+    std::atomic<int> finishedChunks{ 0 };
+
+    ParallelJob* next = nullptr;
+};
+
+/**
+ * \brief A pool of worker threads that run parallel jobs.
+ * The thread that starts a job helps out until it's finished, so jobs can be started from within jobs.
+ */
+class WorkerPool {
+public:
+    ~WorkerPool();
+
+    /**
+     * \brief Starts the worker threads. Gets called on the first job if it hasn't been called yet.
+     *
+     * \param workerCount How many threads to start, -1 starts one less than the amount of cores.
+     */
+    void Create(int workerCount = -1);
+
+    /**
+     * \brief Stops and joins all the worker threads.
+     * Call this at the end of your program, the `App` does this on destruction.
+     */
+    void Delete();
+
+    /**
+     * \return How many worker threads are running, not counting the threads that start jobs.
+     */
+    int WorkerCount() const;
+
+    /**
+     * \brief Splits `count` elements up in chunks and runs them on the workers.
+     * Blocks until all chunks are finished.
+     *
+     * \param count How many elements to process.
+     * \param grainSize How many elements every chunk holds, the last chunk may hold less.
+     * \param func The function to run for every chunk.
+     * \param data The data to pass to the function.
+     */
+    void Run(int count, int grainSize, ParallelChunkFunc* func, void* data);
+
+private:
+    static void WorkerMain(void* data);
+
+    /**
+     * \brief Claims a chunk of any job that still has chunks left.
+     *
+     * \param chunk The claimed chunk.
+     * \return The job the chunk belongs to, nullptr if there's nothing to do.
+     */
+    ParallelJob* ClaimChunk(int& chunk);
+
+    /**
+     * \brief Runs the chunk and keeps claiming chunks of the same job until it runs out.
+     * The job is guaranteed to be alive as long as one of its chunks is unfinished.
+     *
+     * \param job The job.
+     * \param chunk The first chunk, it must already be claimed.
+     */
+    void RunChunks(ParallelJob* job, int chunk);
+
+    Thread* threads = nullptr;
+    int threadCount = 0;
+
+    std::atomic<bool> created{ false };
+    std::atomic<bool> stopping{ false };
+
+    // Guards the job list and creation
+    Mutex jobLock;
+    ParallelJob* jobs = nullptr;
+
+    // Gets posted once for every chunk that a worker could pick up
+    Semaphore wakeUp{ 0 };
+};
+
+extern WorkerPool workerPool;
+
+}
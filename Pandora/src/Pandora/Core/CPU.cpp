@@ -0,0 +1,86 @@
+#include "CPU.h"
+
+#if defined(PD_X86)
+  #if defined(PD_WINDOWS)
+    #include <intrin.h>
+  #else
+    #include <cpuid.h>
+  #endif
+#endif
+
+namespace pd {
+
+#if defined(PD_X86)
+
+inline void CPUID(u32 leaf, u32 subleaf, u32 out[4]) {
+#if defined(PD_WINDOWS)
+    __cpuidex((int*)out, (int)leaf, (int)subleaf);
+#else
+    __cpuid_count(leaf, subleaf, out[0], out[1], out[2], out[3]);
+#endif
+}
+
+inline u64 GetExtendedControlRegister() {
+#if defined(PD_WINDOWS)
+    return _xgetbv(0);
+#else
+    u32 low, high;
+    __asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+    return ((u64)high << 32) | low;
+#endif
+}
+
+inline CPUFeatures DetectCPUFeatures() {
+    CPUFeatures features;
+
+    u32 regs[4];
+    CPUID(0, 0, regs);
+    u32 maxLeaf = regs[0];
+
+    if (maxLeaf < 1) return features;
+
+    CPUID(1, 0, regs);
+    u32 ecx = regs[2];
+    u32 edx = regs[3];
+
+    features.sse2 = (edx & (1 << 26)) != 0;
+    features.ssse3 = (ecx & (1 << 9)) != 0;
+    features.sse41 = (ecx & (1 << 19)) != 0;
+    features.sse42 = (ecx & (1 << 20)) != 0;
+    features.popcnt = (ecx & (1 << 23)) != 0;
+    features.aes = (ecx & (1 << 25)) != 0;
+
+    // The OS has to save the YMM registers on context switches as well
+    bool osSavesYMM = false;
+    if ((ecx & (1 << 27)) != 0) {
+        osSavesYMM = (GetExtendedControlRegister() & 0x6) == 0x6;
+    }
+
+    features.avx = osSavesYMM && (ecx & (1 << 28)) != 0;
+
+    if (maxLeaf >= 7) {
+        CPUID(7, 0, regs);
+        u32 ebx = regs[1];
+
+        features.avx2 = features.avx && (ebx & (1 << 5)) != 0;
+        features.bmi1 = (ebx & (1 << 3)) != 0;
+        features.bmi2 = (ebx & (1 << 8)) != 0;
+    }
+
+    return features;
+}
+
+#else
+
+inline CPUFeatures DetectCPUFeatures() {
+    return CPUFeatures();
+}
+
+#endif
+
+const CPUFeatures& GetCPUFeatures() {
+    static CPUFeatures features = DetectCPUFeatures();
+    return features;
+}
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Pandora/Core/Types.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+  #define PD_X86
+#endif
+
+// Lets a function use instructions the rest of the program isn't compiled with.
+// MSVC allows any intrinsic without it.
+#if defined(PD_X86) && (defined(__GNUC__) || defined(__clang__))
+  #define PD_TARGET(isa) __attribute__((target(isa)))
+#else
+  #define PD_TARGET(isa)
+#endif
+
+namespace pd {
+
+/**
+ * \brief The instruction set extensions supported by the CPU and the OS.
+ */
+struct CPUFeatures {
+    bool sse2 = false;
+    bool ssse3 = false;
+    bool sse41 = false;
+    bool sse42 = false;
+    bool avx = false;
+    bool avx2 = false;
+    bool aes = false;
+    bool popcnt = false;
+    bool bmi1 = false;
+    bool bmi2 = false;
+};
+
+/**
+ * \brief Detects the features once, subsequent calls are free.
+ * 
+ * \return The supported features. All false on non-x86 CPUs.
+ */
+const CPUFeatures& GetCPUFeatures();
+
+}
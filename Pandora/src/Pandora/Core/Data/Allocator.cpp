@@ -2,10 +2,18 @@
 
 #include <malloc.h>
 #include <memory>
+#include <atomic>
+
+#if defined(PD_WINDOWS)
+#include <Windows.h>
+#elif defined(PD_LINUX)
+#include <sys/mman.h>
+#endif
 
 #include "Pandora/Core/Assert.h"
 #include "Pandora/Core/Math/Math.h"
 #include "Pandora/Core/Data/Memory.h"
+#include "Pandora/Core/Data/LeakTracker.h"
 
 // Disable "Dereferencing NULL pointer"
 #pragma warning(push)
@@ -13,31 +21,161 @@
 
 namespace pd {
 
+//
+// Memory tags
+//
+
+const int MEMORY_TAG_COUNT = (int)MemoryTag::Count;
+
+const char* MEMORY_TAG_NAMES[MEMORY_TAG_COUNT] = {
+    "General",
+    "Renderer",
+    "Text",
+    "Resources",
+    "JSON",
+    "Audio",
+    "Box",
+    "Game"
+};
+
+struct MemoryTagCounters {
+    std::atomic<u64> currentBytes{ 0 };
+    std::atomic<u64> peakBytes{ 0 };
+    std::atomic<u64> liveAllocations{ 0 };
+    std::atomic<u64> totalAllocations{ 0 };
+    std::atomic<u64> frameAllocations{ 0 };
+    std::atomic<u64> lastFrameAllocations{ 0 };
+};
+
+// @GLOBAL
+static MemoryTagCounters tagCounters[MEMORY_TAG_COUNT];
+
+// @GLOBAL
+static std::atomic<u64> sizeHistogram[MEMORY_HISTOGRAM_BUCKETS];
+
+// @GLOBAL
+static thread_local MemoryTag currentTag = MemoryTag::General;
+
+inline int HistogramBucket(u64 size) {
+    int bucket = 0;
+    while (bucket < MEMORY_HISTOGRAM_BUCKETS - 1 && ((u64)16 << bucket) < size) {
+        bucket += 1;
+    }
+
+    return bucket;
+}
+
+/**
+ * \brief Counts an allocation request, this includes reallocations and temporary allocations.
+ */
+inline void CountAllocation(MemoryTag tag, u64 size) {
+    MemoryTagCounters& counters = tagCounters[(int)tag];
+    counters.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+    counters.frameAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    sizeHistogram[HistogramBucket(size)].fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void TrackBytes(MemoryTag tag, u64 added, u64 removed) {
+    MemoryTagCounters& counters = tagCounters[(int)tag];
+
+    if (removed > added) {
+        counters.currentBytes.fetch_sub(removed - added, std::memory_order_relaxed);
+        return;
+    }
+
+    u64 current = counters.currentBytes.fetch_add(added - removed, std::memory_order_relaxed) + added - removed;
+
+    u64 peak = counters.peakBytes.load(std::memory_order_relaxed);
+    while (current > peak && !counters.peakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {}
+}
+
+inline void TrackAlloc(MemoryTag tag, u64 size) {
+    tagCounters[(int)tag].liveAllocations.fetch_add(1, std::memory_order_relaxed);
+    TrackBytes(tag, size, 0);
+}
+
+inline void TrackFree(MemoryTag tag, u64 size) {
+    tagCounters[(int)tag].liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+    TrackBytes(tag, 0, size);
+}
+
 //
 // Persistent allocator
 //
 
 // @GLOBAL
-static u64 persistentAllocated = 0;
+static std::atomic<u64> persistentAllocated{ 0 };
 
 struct AllocationHeader {
     Allocator type;
+
+    // The subsystem that made the allocation
+    MemoryTag tag;
+
+    // How many bytes the allocation got moved forward to satisfy the alignment
+    u16 offset;
+
+    // Only used by the temporary allocator
+    u32 generation;
+
     u64 size;
 };
 
-inline void* PersistentAlloc(u64 size) {
-    AllocationHeader* ptr = (AllocationHeader*)malloc(size + sizeof(AllocationHeader));
-    PD_ASSERT_D(ptr != nullptr, "failed to allocate %lld bytes with the persistent allocator", size);
+static_assert(sizeof(AllocationHeader) == DEFAULT_ALIGNMENT, "The allocation header must keep allocations aligned");
 
+inline bool IsValidAlignment(u64 alignment) {
+    return alignment > 0 && (alignment & (alignment - 1)) == 0 && alignment <= MAX_ALIGNMENT;
+}
 
+inline void* PersistentAlloc(u64 size, u64 alignment = DEFAULT_ALIGNMENT, MemoryTag tag = currentTag) {
+    PD_ASSERT_D(IsValidAlignment(alignment), "invalid alignment %llu, must be a power of 2 up to %llu", alignment, MAX_ALIGNMENT);
+
+    // malloc already gives us memory aligned to the header size
+    u64 padding = (alignment > DEFAULT_ALIGNMENT) ? alignment - DEFAULT_ALIGNMENT : 0;
+
+    byte* memory = (byte*)malloc(size + sizeof(AllocationHeader) + padding);
+    PD_ASSERT_D(memory != nullptr, "failed to allocate %lld bytes with the persistent allocator", size);
+
+    u64 address = (u64)(memory + sizeof(AllocationHeader));
+    u64 offset = AlignUp(address, alignment) - address;
+
+    AllocationHeader* ptr = (AllocationHeader*)(memory + offset);
     ptr->type = Allocator::Persistent;
+    ptr->tag = tag;
+    ptr->offset = (u16)offset;
     ptr->size = size;
 
     persistentAllocated += size;
+    CountAllocation(tag, size);
+    TrackAlloc(tag, size);
+
     return ptr + 1;
 }
 
-inline void* PersistentRealloc(void* ptr, u64 size) {
+inline void PersistentFree(void* ptr);
+
+inline void* PersistentRealloc(void* ptr, u64 size, u64 alignment = DEFAULT_ALIGNMENT) {
+    if (alignment > DEFAULT_ALIGNMENT || (ptr && ((AllocationHeader*)ptr)[-1].offset != 0)) {
+        // realloc doesn't keep our alignment so we have to move it ourselves
+        if (ptr && (u64)ptr % alignment == 0 && ((AllocationHeader*)ptr)[-1].size >= size) {
+            return ptr;
+        }
+
+        // Moved allocations keep the tag they were made with
+        MemoryTag tag = (ptr) ? ((AllocationHeader*)ptr)[-1].tag : currentTag;
+        void* newPtr = PersistentAlloc(size, alignment, tag);
+
+        if (ptr) {
+            MemoryCopy(newPtr, ptr, Min(size, ((AllocationHeader*)ptr)[-1].size));
+            PersistentFree(ptr);
+        }
+
+        return newPtr;
+    }
+
+    MemoryTag tag = currentTag;
+
     if (ptr) {
         u64 prevSize = ((u64*)ptr)[-1];
         bool sub = size < prevSize;
@@ -46,10 +184,16 @@ inline void* PersistentRealloc(void* ptr, u64 size) {
         } else {
             persistentAllocated += size - prevSize;
         }
+
+        tag = ((AllocationHeader*)ptr)[-1].tag;
+        TrackBytes(tag, size, prevSize);
     } else {
         persistentAllocated += size;
+        TrackAlloc(tag, size);
     }
 
+    CountAllocation(tag, size);
+
     byte* alignedPtr = (byte*)ptr;
     if (ptr) {
         alignedPtr -= sizeof(AllocationHeader);
@@ -58,6 +202,9 @@ inline void* PersistentRealloc(void* ptr, u64 size) {
     AllocationHeader* newPtr = (AllocationHeader*)realloc(alignedPtr, size + sizeof(AllocationHeader));
     PD_ASSERT_D(newPtr != nullptr, "failed to reallocate %lld bytes with the persistent allocator", size);
 
+    newPtr->type = Allocator::Persistent;
+    newPtr->tag = tag;
+    newPtr->offset = 0;
     newPtr->size = size;
 
     return newPtr + 1;
@@ -69,8 +216,9 @@ inline void PersistentFree(void* ptr) {
     if (ptr) {
         AllocationHeader* header = &((AllocationHeader*)ptr)[-1];
         persistentAllocated -= header->size;
+        TrackFree(header->tag, header->size);
 
-        alignedPtr -= sizeof(AllocationHeader);
+        alignedPtr -= sizeof(AllocationHeader) + header->offset;
     }
 
     free(alignedPtr);
@@ -80,107 +228,698 @@ inline void PersistentFree(void* ptr) {
 // Temporary allocator
 //
 
+// Every thread gets its own arena so worker threads can use the temporary
+// allocator without stepping on each other. The arena gets reset every frame,
+// if a frame allocates more than the capacity we wrap back to the start and
+// bump the generation so stale allocations can be detected.
+
 // @GLOBAL
-struct {
+static u64 temporaryCapacity = (u64)Megabytes(16);
+
+const int MAX_TEMPORARY_SCOPE_DEPTH = 64;
+
+struct TemporaryArena {
+    ~TemporaryArena() {
+        if (memory) {
+            free(memory);
+        }
+    }
+
     byte* memory = nullptr;
     u64 bufferSize = 0;
     u64 usedBytes = 0;
-} tempAllocData;
+
+    // Incremented every time the arena gets reset or wraps around
+    u32 generation = 0;
+
+    // How many markers are currently pushed
+    int scopeDepth = 0;
+
+    // Where every pushed scope starts, popping one releases everything after it
+    u64 scopeOffsets[MAX_TEMPORARY_SCOPE_DEPTH];
+
+    TemporaryStats stats;
+};
+
+// @GLOBAL
+static thread_local TemporaryArena tempArena;
 
 inline void InitTemporaryMemory() {
-    if (!tempAllocData.memory) {
-        // @TODO: make this controllable
-        tempAllocData.bufferSize = (u64)Megabytes(16);
-        tempAllocData.memory = (byte*)malloc(tempAllocData.bufferSize); // 16MB
+    if (!tempArena.memory) {
+        tempArena.bufferSize = temporaryCapacity;
+        tempArena.memory = (byte*)malloc(tempArena.bufferSize);
+        tempArena.usedBytes = 0;
     }
 }
 
-inline void* TemporaryAlloc(u64 size) {
+inline void ReleaseTemporaryMemory(u64 offset) {
+#if defined(PD_DEBUG)
+    // Poison the released memory so stale temporaries are easy to spot
+    if (tempArena.memory && offset < tempArena.usedBytes) {
+        MemorySet(tempArena.memory + offset, tempArena.usedBytes - offset, 0xCD);
+    }
+#endif
+
+    tempArena.usedBytes = offset;
+}
+
+inline void* TemporaryAlloc(u64 size, u64 alignment = DEFAULT_ALIGNMENT) {
     InitTemporaryMemory();
 
+    PD_ASSERT_D(IsValidAlignment(alignment), "invalid alignment %llu, must be a power of 2 up to %llu", alignment, MAX_ALIGNMENT);
+
     size += sizeof(AllocationHeader);
 
-    // Check if we can fit the allocation, if not we flow back to the Start of the memory
-    if (tempAllocData.usedBytes + size > tempAllocData.bufferSize) {
-        tempAllocData.usedBytes = 0;
+    // Keep every allocation 16-byte aligned
+    u64 alignedSize = AlignUp(size, (u64)sizeof(AllocationHeader));
+
+    // The arena memory comes from malloc so the offsets have to be aligned on top of the base address
+    u64 base = (u64)tempArena.memory;
+    auto paddingAt = [base, alignment](u64 offset) {
+        return AlignUp(base + offset + sizeof(AllocationHeader), alignment) - (base + offset + sizeof(AllocationHeader));
+    };
+
+    if (!tempArena.memory || paddingAt(0) + alignedSize > tempArena.bufferSize) {
+        PD_ASSERT_D(false, "failed to allocate %llu bytes with the temporary allocator (capacity: %llu)",
+                    size - sizeof(AllocationHeader), tempArena.bufferSize);
+        return nullptr;
     }
 
-    byte* memory = tempAllocData.memory + tempAllocData.usedBytes;
+    // Check if we can fit the allocation, if not we flow back to the start of the memory
+    if (tempArena.usedBytes + paddingAt(tempArena.usedBytes) + alignedSize > tempArena.bufferSize) {
+        PD_ASSERT_D(tempArena.scopeDepth == 0,
+                    "temporary arena wrapped inside a scoped arena, live temporaries are overwritten (capacity: %llu)",
+                    tempArena.bufferSize);
+
+        tempArena.usedBytes = 0;
+        tempArena.generation += 1;
+    }
 
-    // Encode allocated bufferSize
-    if (!memory) return nullptr;
+    tempArena.usedBytes += paddingAt(tempArena.usedBytes);
 
+    byte* memory = tempArena.memory + tempArena.usedBytes;
+
+    // Encode allocated size
     ((AllocationHeader*)memory)->type = Allocator::Temporary;
+    ((AllocationHeader*)memory)->tag = currentTag;
+    ((AllocationHeader*)memory)->offset = 0;
+    ((AllocationHeader*)memory)->generation = tempArena.generation;
     ((AllocationHeader*)memory)->size = size - sizeof(AllocationHeader);
 
-    tempAllocData.usedBytes += size;
+    tempArena.usedBytes += alignedSize;
+
+    // Temporary memory is never freed so we only count the churn
+    CountAllocation(currentTag, size - sizeof(AllocationHeader));
 
     return memory + sizeof(AllocationHeader);
 }
 
-inline void* TemporaryRealloc(void* ptr, u64 size) {
+inline void* TemporaryRealloc(void* ptr, u64 size, u64 alignment = DEFAULT_ALIGNMENT) {
     InitTemporaryMemory();
 
     // Replicate malloc/realloc behaviour of allocating on receiving a nullptr
     if (!ptr) {
-        return TemporaryAlloc(size);
+        return TemporaryAlloc(size, alignment);
     }
 
+    PD_ASSERT_D(IsTemporaryAllocationValid(ptr),
+                "reallocating a temporary allocation that has been released or overwritten");
+
     byte* memory = (byte*)ptr - sizeof(AllocationHeader);
-    u64 oldSize = ((AllocationHeader*)memory)->size;
+    AllocationHeader* header = (AllocationHeader*)memory;
+    u64 oldSize = header->size;
+
+    u64 offset = (u64)(memory - tempArena.memory);
+    u64 oldEnd = offset + AlignUp(oldSize + sizeof(AllocationHeader), (u64)sizeof(AllocationHeader));
+    u64 newEnd = offset + AlignUp(size + sizeof(AllocationHeader), (u64)sizeof(AllocationHeader));
+
+    // If we're the last allocation made we can just grab the remaining space
+    bool isLastAllocation = header->generation == tempArena.generation && oldEnd == tempArena.usedBytes &&
+                            (u64)ptr % alignment == 0;
+    if (isLastAllocation && newEnd <= tempArena.bufferSize) {
+        header->size = size;
+
+        // Nothing got allocated in the scopes pushed after the block, they start after it now.
+        // Otherwise popping them would release the part that grew past their marker.
+        u64 scopeOffset = (tempArena.scopeDepth > 0) ? tempArena.scopeOffsets[tempArena.scopeDepth - 1] : 0;
+        if (offset >= scopeOffset || newEnd > oldEnd) {
+            tempArena.usedBytes = newEnd;
+
+            for (int i = tempArena.scopeDepth - 1; i >= 0 && tempArena.scopeOffsets[i] > offset; i--) {
+                tempArena.scopeOffsets[i] = newEnd;
+            }
+        }
 
-    // @TODO: optimize this where it checks if we're the last allocation made and if so we just grab remaining space if possible.
-    // This saves us having to allocate and copy
-    byte* newPtr = (byte*)TemporaryAlloc(size);
-    MemoryCopy(newPtr, ptr, Min(size, oldSize), true);
+        if (size > oldSize) {
+            tempArena.stats.inPlaceGrows += 1;
+        }
+
+        CountAllocation(header->tag, size);
+
+        return ptr;
+    }
+
+    byte* newPtr = (byte*)TemporaryAlloc(size, alignment);
+    if (!newPtr) return nullptr;
+
+    u64 copySize = Min(size, oldSize);
+
+    // The new block can overlap the old one when the arena wrapped around
+    MemoryMove(newPtr, ptr, copySize);
+
+    tempArena.stats.copyingGrows += 1;
+    tempArena.stats.bytesCopied += copySize;
 
     return newPtr;
 }
 
+void SetTemporaryCapacity(u64 sizeInBytes) {
+    temporaryCapacity = sizeInBytes;
+
+    if (tempArena.memory && tempArena.bufferSize != sizeInBytes) {
+        PD_ASSERT_D(tempArena.scopeDepth == 0, "changing the temporary capacity inside a scoped arena");
+
+        free(tempArena.memory);
+        tempArena.memory = nullptr;
+        tempArena.generation += 1;
+
+        InitTemporaryMemory();
+    }
+}
+
+u64 GetTemporaryCapacity() {
+    return (tempArena.memory) ? tempArena.bufferSize : temporaryCapacity;
+}
+
+u64 GetTemporaryUsedBytes() {
+    return tempArena.usedBytes;
+}
+
+TemporaryMarker PushTemporaryMarker() {
+    TemporaryMarker marker;
+    marker.offset = tempArena.usedBytes;
+    marker.generation = tempArena.generation;
+
+    PD_ASSERT_D(tempArena.scopeDepth < MAX_TEMPORARY_SCOPE_DEPTH, "too many nested temporary markers, max. %d",
+                MAX_TEMPORARY_SCOPE_DEPTH);
+
+    tempArena.scopeOffsets[tempArena.scopeDepth] = marker.offset;
+    tempArena.scopeDepth += 1;
+
+    return marker;
+}
+
+void PopTemporaryMarker(TemporaryMarker marker) {
+    PD_ASSERT_D(tempArena.scopeDepth > 0, "popping a temporary marker that was never pushed");
+    PD_ASSERT_D(marker.generation != tempArena.generation || marker.offset <= tempArena.usedBytes,
+                "temporary markers popped out of order, given: %llu, used: %llu",
+                marker.offset, tempArena.usedBytes);
+
+    tempArena.scopeDepth -= 1;
+
+    // Starts past the marker if a block from before it grew in place
+    u64 scopeOffset = tempArena.scopeOffsets[tempArena.scopeDepth];
+
+    // If the arena got reset or wrapped since the marker was pushed the offset is meaningless
+    if (marker.generation == tempArena.generation && scopeOffset <= tempArena.usedBytes) {
+        ReleaseTemporaryMemory(scopeOffset);
+    }
+}
+
+void ResetTemporaryAllocator() {
+    PD_ASSERT_D(tempArena.scopeDepth == 0, "resetting the temporary allocator inside a scoped arena");
+
+    ReleaseTemporaryMemory(0);
+    tempArena.generation += 1;
+}
+
+TemporaryStats GetTemporaryStats() {
+    return tempArena.stats;
+}
+
+void ResetTemporaryStats() {
+    tempArena.stats = TemporaryStats();
+}
+
+bool IsTemporaryAllocationValid(void* ptr) {
+    if (!ptr || !tempArena.memory) return false;
+
+    byte* memory = (byte*)ptr - sizeof(AllocationHeader);
+
+    // Not part of this thread's arena
+    if (memory < tempArena.memory || memory >= tempArena.memory + tempArena.bufferSize) return false;
+
+    AllocationHeader* header = (AllocationHeader*)memory;
+    return header->type == Allocator::Temporary &&
+           header->generation == tempArena.generation &&
+           memory + sizeof(AllocationHeader) + header->size <= tempArena.memory + tempArena.usedBytes;
+}
+
+//
+// Pool allocator
+//
+
+// Small allocations are served from fixed-size blocks without any header.
+// All slabs live in one reserved address range, this lets us find out if a
+// pointer belongs to the pool and which size class it has by its address alone.
+// Every thread keeps a small cache of free blocks per size class so the
+// common case doesn't need to touch the shared free lists.
+// Slabs are also owned by a single memory tag, that way freed blocks can be
+// attributed to their subsystem without a header.
+
+const u64 POOL_SLAB_SIZE = 64 * 1024;
+const u64 POOL_RESERVE_SIZE = 256 * 1024 * 1024;
+const u64 POOL_SLAB_COUNT = POOL_RESERVE_SIZE / POOL_SLAB_SIZE;
+
+const int POOL_CLASS_COUNT = 12;
+const u32 POOL_CLASS_SIZES[POOL_CLASS_COUNT] = {
+    16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256
+};
+
+// Every size class has a free list per memory tag
+const int POOL_LIST_COUNT = POOL_CLASS_COUNT * MEMORY_TAG_COUNT;
+
+const int POOL_CACHE_MAX = 64;
+const int POOL_CACHE_BATCH = 32;
+
+struct PoolBlock {
+    PoolBlock* next;
+};
+
+// A spinlock because it needs no construction, `New()` might get called during static initialization
+struct PoolLock {
+    PoolLock(std::atomic_flag& flag) : flag(flag) {
+        while (flag.test_and_set(std::memory_order_acquire)) {}
+    }
+
+    ~PoolLock() {
+        flag.clear(std::memory_order_release);
+    }
+
+private:
+    std::atomic_flag& flag;
+};
+
+// @GLOBAL
+struct {
+    byte* memory = nullptr;
+    u64 usedSlabs = 0;
+
+    // Size class index and memory tag of every slab
+    byte slabClasses[POOL_SLAB_COUNT] = {};
+    MemoryTag slabTags[POOL_SLAB_COUNT] = {};
+
+    PoolBlock* freeLists[POOL_LIST_COUNT] = {};
+    std::atomic_flag listLocks[POOL_LIST_COUNT] = {};
+    std::atomic_flag slabLock = ATOMIC_FLAG_INIT;
+
+    std::atomic<u64> allocated{ 0 };
+} poolData;
+
+struct PoolThreadCache {
+    ~PoolThreadCache();
+
+    PoolBlock* freeLists[POOL_LIST_COUNT] = {};
+    int counts[POOL_LIST_COUNT] = {};
+};
+
+// @GLOBAL
+static thread_local PoolThreadCache poolCache;
+
+inline bool IsPoolMemory(const void* ptr) {
+    return poolData.memory && (byte*)ptr >= poolData.memory && (byte*)ptr < poolData.memory + POOL_RESERVE_SIZE;
+}
+
+inline int PoolClassIndex(u64 size, u64 alignment = DEFAULT_ALIGNMENT) {
+    if (size == 0) {
+        size = 1;
+    }
+
+    int classIndex = (size <= 128) ? (int)((size + 15) / 16) - 1 : 8 + (int)((size - 129) / 32);
+
+    // Slabs are aligned to the slab size so any block size that is a multiple
+    // of the alignment gives us aligned blocks
+    while (classIndex < POOL_CLASS_COUNT && POOL_CLASS_SIZES[classIndex] % alignment != 0) {
+        classIndex += 1;
+    }
+
+    return classIndex;
+}
+
+inline int PoolClassOf(const void* ptr) {
+    return poolData.slabClasses[((byte*)ptr - poolData.memory) / POOL_SLAB_SIZE];
+}
+
+inline MemoryTag PoolTagOf(const void* ptr) {
+    return poolData.slabTags[((byte*)ptr - poolData.memory) / POOL_SLAB_SIZE];
+}
+
+inline int PoolListIndex(int classIndex, MemoryTag tag) {
+    return (int)tag * POOL_CLASS_COUNT + classIndex;
+}
+
+inline int PoolListOf(const void* ptr) {
+    return PoolListIndex(PoolClassOf(ptr), PoolTagOf(ptr));
+}
+
+inline bool InitPoolMemory() {
+    if (poolData.memory) return true;
+
+    PoolLock lock(poolData.slabLock);
+    if (poolData.memory) return true;
+
+#if defined(PD_WINDOWS)
+    poolData.memory = (byte*)VirtualAlloc(nullptr, POOL_RESERVE_SIZE, MEM_RESERVE, PAGE_NOACCESS);
+#elif defined(PD_LINUX)
+    void* memory = mmap(nullptr, POOL_RESERVE_SIZE, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    poolData.memory = (memory != MAP_FAILED) ? (byte*)memory : nullptr;
+#endif
+
+    return poolData.memory != nullptr;
+}
+
+/**
+ * \brief Commits a new slab and carves it into blocks of the size class.
+ * The list lock must be held.
+ */
+inline bool CarvePoolSlab(int listIndex) {
+    int classIndex = listIndex % POOL_CLASS_COUNT;
+
+    byte* slab = nullptr;
+
+    {
+        PoolLock lock(poolData.slabLock);
+        if (poolData.usedSlabs >= POOL_SLAB_COUNT) return false;
+
+        slab = poolData.memory + poolData.usedSlabs * POOL_SLAB_SIZE;
+
+#if defined(PD_WINDOWS)
+        if (!VirtualAlloc(slab, POOL_SLAB_SIZE, MEM_COMMIT, PAGE_READWRITE)) return false;
+#elif defined(PD_LINUX)
+        if (mprotect(slab, POOL_SLAB_SIZE, PROT_READ | PROT_WRITE) != 0) return false;
+#endif
+
+        poolData.slabClasses[poolData.usedSlabs] = (byte)classIndex;
+        poolData.slabTags[poolData.usedSlabs] = (MemoryTag)(listIndex / POOL_CLASS_COUNT);
+        poolData.usedSlabs += 1;
+    }
+
+    u64 blockSize = POOL_CLASS_SIZES[classIndex];
+    u64 blockCount = POOL_SLAB_SIZE / blockSize;
+
+    // Link the blocks back to front so they get handed out in address order
+    PoolBlock* head = poolData.freeLists[listIndex];
+    for (u64 i = blockCount; i > 0; i--) {
+        PoolBlock* block = (PoolBlock*)(slab + (i - 1) * blockSize);
+        block->next = head;
+        head = block;
+    }
+
+    poolData.freeLists[listIndex] = head;
+    return true;
+}
+
+inline bool RefillPoolCache(int listIndex) {
+    PoolLock lock(poolData.listLocks[listIndex]);
+
+    if (!poolData.freeLists[listIndex] && !CarvePoolSlab(listIndex)) {
+        return false;
+    }
+
+    for (int i = 0; i < POOL_CACHE_BATCH && poolData.freeLists[listIndex]; i++) {
+        PoolBlock* block = poolData.freeLists[listIndex];
+        poolData.freeLists[listIndex] = block->next;
+
+        block->next = poolCache.freeLists[listIndex];
+        poolCache.freeLists[listIndex] = block;
+        poolCache.counts[listIndex] += 1;
+    }
+
+    return true;
+}
+
+inline void FlushPoolCache(int listIndex, int count) {
+    if (count <= 0 || !poolCache.freeLists[listIndex]) return;
+
+    PoolLock lock(poolData.listLocks[listIndex]);
+
+    for (int i = 0; i < count && poolCache.freeLists[listIndex]; i++) {
+        PoolBlock* block = poolCache.freeLists[listIndex];
+        poolCache.freeLists[listIndex] = block->next;
+        poolCache.counts[listIndex] -= 1;
+
+        block->next = poolData.freeLists[listIndex];
+        poolData.freeLists[listIndex] = block;
+    }
+}
+
+PoolThreadCache::~PoolThreadCache() {
+    // The pool might already be deleted at this point
+    if (!poolData.memory) return;
+
+    for (int i = 0; i < POOL_LIST_COUNT; i++) {
+        FlushPoolCache(i, counts[i]);
+    }
+}
+
+inline void* PoolAlloc(u64 size, u64 alignment = DEFAULT_ALIGNMENT, MemoryTag tag = currentTag) {
+    if (size > POOL_CLASS_SIZES[POOL_CLASS_COUNT - 1] || !InitPoolMemory()) {
+        return PersistentAlloc(size, alignment, tag);
+    }
+
+    int classIndex = PoolClassIndex(size, alignment);
+
+    if (classIndex >= POOL_CLASS_COUNT) {
+        return PersistentAlloc(size, alignment, tag);
+    }
+
+    int listIndex = PoolListIndex(classIndex, tag);
+
+    if (!poolCache.freeLists[listIndex] && !RefillPoolCache(listIndex)) {
+        // We ran out of reserved space
+        return PersistentAlloc(size, alignment, tag);
+    }
+
+    PoolBlock* block = poolCache.freeLists[listIndex];
+    poolCache.freeLists[listIndex] = block->next;
+    poolCache.counts[listIndex] -= 1;
+
+    u64 blockSize = POOL_CLASS_SIZES[classIndex];
+    poolData.allocated += blockSize;
+
+    CountAllocation(tag, blockSize);
+    TrackAlloc(tag, blockSize);
+
+    return block;
+}
+
+inline void PoolFree(void* ptr) {
+    if (!ptr) return;
+
+    // Allocations that didn't fit in a size class came from the persistent allocator
+    if (!IsPoolMemory(ptr)) {
+        PersistentFree(ptr);
+        return;
+    }
+
+    u64 blockSize = POOL_CLASS_SIZES[PoolClassOf(ptr)];
+    poolData.allocated -= blockSize;
+    TrackFree(PoolTagOf(ptr), blockSize);
+
+    int listIndex = PoolListOf(ptr);
+
+    PoolBlock* block = (PoolBlock*)ptr;
+    block->next = poolCache.freeLists[listIndex];
+    poolCache.freeLists[listIndex] = block;
+    poolCache.counts[listIndex] += 1;
+
+    // Give half of the cache back when it gets too big
+    if (poolCache.counts[listIndex] > POOL_CACHE_MAX) {
+        FlushPoolCache(listIndex, POOL_CACHE_BATCH);
+    }
+}
+
+inline void* PoolRealloc(void* ptr, u64 size, u64 alignment = DEFAULT_ALIGNMENT) {
+    if (!ptr) {
+        return PoolAlloc(size, alignment);
+    }
+
+    u64 oldSize = 0;
+    MemoryTag tag = MemoryTag::General;
+
+    if (IsPoolMemory(ptr)) {
+        int classIndex = PoolClassOf(ptr);
+        tag = PoolTagOf(ptr);
+
+        // Still fits in the same size class
+        if (size <= POOL_CLASS_SIZES[POOL_CLASS_COUNT - 1] && PoolClassIndex(size, alignment) == classIndex) {
+            return ptr;
+        }
+
+        oldSize = POOL_CLASS_SIZES[classIndex];
+    } else {
+        // Both sizes are too big for the pool
+        if (size > POOL_CLASS_SIZES[POOL_CLASS_COUNT - 1]) {
+            return PersistentRealloc(ptr, size, alignment);
+        }
+
+        oldSize = ((AllocationHeader*)ptr)[-1].size;
+        tag = ((AllocationHeader*)ptr)[-1].tag;
+    }
+
+    void* newPtr = PoolAlloc(size, alignment, tag);
+    MemoryCopy(newPtr, ptr, Min(size, oldSize));
+    PoolFree(ptr);
+
+    return newPtr;
+}
+
+void DeletePoolAllocator() {
+    if (!poolData.memory) return;
+
+    PD_ASSERT_D(poolData.allocated == 0, "deleting the pool allocator while %llu bytes are still allocated",
+                poolData.allocated.load());
+
+#if defined(PD_WINDOWS)
+    VirtualFree(poolData.memory, 0, MEM_RELEASE);
+#elif defined(PD_LINUX)
+    munmap(poolData.memory, POOL_RESERVE_SIZE);
+#endif
+
+    poolData.memory = nullptr;
+    poolData.usedSlabs = 0;
+
+    for (int i = 0; i < POOL_LIST_COUNT; i++) {
+        poolData.freeLists[i] = nullptr;
+        poolCache.freeLists[i] = nullptr;
+        poolCache.counts[i] = 0;
+    }
+}
+
 //
 // Allocator API
 //
 
-void* Alloc(u64 size, Allocator type) {
+// Temporary allocations are never freed so the leak tracker ignores them
+
+void* Alloc(u64 size, Allocator type, u64 alignment) {
+    void* ptr = nullptr;
+
     if (type == Allocator::Persistent) {
-        return PersistentAlloc(size);
+        ptr = PersistentAlloc(size, alignment);
     } else if (type == Allocator::Temporary) {
-        return TemporaryAlloc(size);
+        return TemporaryAlloc(size, alignment);
+    } else if (type == Allocator::Pool) {
+        ptr = PoolAlloc(size, alignment);
+    }
+
+    if (IsLeakTracking()) {
+        TrackAllocation(ptr, size);
     }
 
-    return nullptr;
+    return ptr;
 }
 
-void* Realloc(void* ptr, u64 size, Allocator type) {
+void* Realloc(void* ptr, u64 size, Allocator type, u64 alignment) {
+    void* newPtr = nullptr;
+
     if (type == Allocator::Persistent) {
-        return PersistentRealloc(ptr, size);
+        newPtr = PersistentRealloc(ptr, size, alignment);
     } else if (type == Allocator::Temporary) {
-        return TemporaryRealloc(ptr, size);
+        return TemporaryRealloc(ptr, size, alignment);
+    } else if (type == Allocator::Pool) {
+        newPtr = PoolRealloc(ptr, size, alignment);
+    }
+
+    if (IsLeakTracking()) {
+        UntrackAllocation(ptr);
+        TrackAllocation(newPtr, size);
     }
 
-    return nullptr;
+    return newPtr;
 }
 
 void Free(void* ptr, Allocator type) {
+    if (type == Allocator::None || type == Allocator::Temporary) return;
+
+    if (IsLeakTracking()) {
+        UntrackAllocation(ptr);
+    }
+
     if (type == Allocator::Persistent) {
         PersistentFree(ptr);
+    } else if (type == Allocator::Pool) {
+        PoolFree(ptr);
     }
 }
 
 void DeleteTemporaryAllocator() {
-    if (tempAllocData.memory) {
-        free(tempAllocData.memory);
-        tempAllocData.bufferSize;
-        tempAllocData.usedBytes = 0;
+    if (tempArena.memory) {
+        free(tempArena.memory);
+        tempArena.memory = nullptr;
+        tempArena.bufferSize = 0;
+        tempArena.usedBytes = 0;
+        tempArena.generation += 1;
     }
 }
 
 u64 GetAllocatedBytes() {
-    return persistentAllocated;
+    return persistentAllocated + poolData.allocated;
+}
+
+void SetMemoryTag(MemoryTag tag) {
+    PD_ASSERT_D(tag < MemoryTag::Count, "invalid memory tag %d", (int)tag);
+    currentTag = tag;
+}
+
+MemoryTag GetMemoryTag() {
+    return currentTag;
+}
+
+const char* GetMemoryTagName(MemoryTag tag) {
+    return (tag < MemoryTag::Count) ? MEMORY_TAG_NAMES[(int)tag] : "Unknown";
+}
+
+MemoryTagStats GetMemoryTagStats(MemoryTag tag) {
+    PD_ASSERT_D(tag < MemoryTag::Count, "invalid memory tag %d", (int)tag);
+
+    MemoryTagCounters& counters = tagCounters[(int)tag];
+
+    MemoryTagStats stats;
+    stats.currentBytes = counters.currentBytes.load(std::memory_order_relaxed);
+    stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+    stats.liveAllocations = counters.liveAllocations.load(std::memory_order_relaxed);
+    stats.totalAllocations = counters.totalAllocations.load(std::memory_order_relaxed);
+    stats.frameAllocations = counters.lastFrameAllocations.load(std::memory_order_relaxed);
+
+    return stats;
+}
+
+u64 GetAllocationHistogram(int bucket) {
+    PD_ASSERT_D(bucket >= 0 && bucket < MEMORY_HISTOGRAM_BUCKETS, "histogram bucket %d out of range", bucket);
+    return sizeHistogram[bucket].load(std::memory_order_relaxed);
+}
+
+void ResetFrameMemoryStats() {
+    for (int i = 0; i < MEMORY_TAG_COUNT; i++) {
+        tagCounters[i].lastFrameAllocations.store(tagCounters[i].frameAllocations.exchange(0, std::memory_order_relaxed),
+                                                  std::memory_order_relaxed);
+    }
+}
+
+void ResetPeakMemoryStats() {
+    for (int i = 0; i < MEMORY_TAG_COUNT; i++) {
+        tagCounters[i].peakBytes.store(tagCounters[i].currentBytes.load(std::memory_order_relaxed),
+                                       std::memory_order_relaxed);
+    }
 }
 
 u64 GetAllocatedSize(void* ptr, Allocator type) {
-    if (type == Allocator::Persistent || type == Allocator::Temporary) {
+    if (IsPoolMemory(ptr)) {
+        return POOL_CLASS_SIZES[PoolClassOf(ptr)];
+    }
+
+    if (type == Allocator::Persistent || type == Allocator::Pool || type == Allocator::Temporary) {
         return ((AllocationHeader*)ptr)[-1].size;
     }
 
@@ -188,6 +927,11 @@ u64 GetAllocatedSize(void* ptr, Allocator type) {
 }
 
 Allocator GetAllocator(void* ptr) {
+    // Pool blocks don't have a header
+    if (IsPoolMemory(ptr)) {
+        return Allocator::Pool;
+    }
+
     return ((AllocationHeader*)ptr)[-1].type;
 }
 
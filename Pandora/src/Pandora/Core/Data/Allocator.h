@@ -9,21 +9,57 @@ namespace pd {
 
 /**
  * \brief `Persistent` allocates from the persistent allocation pool.
- * `Temporary` allocates from a ring buffer. Does not need to be freed.
+ * `Temporary` allocates from the calling thread's arena. Does not need to be freed.
+ * `Pool` allocates small fixed-size blocks without a header.
+ * Allocations too big for the pool fall back to the persistent allocator.
  * `None` does nothing.
  */
 enum class Allocator : byte {
     None,
     Persistent,
-    Temporary
+    Temporary,
+    Pool
 };
 
+/**
+ * \brief The subsystem an allocation is made for.
+ * Every allocation gets tagged with the calling thread's current tag.
+ */
+enum class MemoryTag : byte {
+    General,
+    Renderer,
+    Text,
+    Resources,
+    JSON,
+    Audio,
+    Box,
+    Game,
+    Count
+};
+
+/**
+ * \brief How many buckets the allocation size histogram has.
+ * Bucket `i` counts allocations up to `16 << i` bytes, the last bucket counts everything bigger.
+ */
+const int MEMORY_HISTOGRAM_BUCKETS = 16;
+
+/**
+ * \brief The alignment every allocation gets by default.
+ */
+const u64 DEFAULT_ALIGNMENT = 16;
+
+/**
+ * \brief The biggest alignment that can be requested.
+ */
+const u64 MAX_ALIGNMENT = 4096;
+
 /**
  * \param size The allocation size in bytes.
  * \param type The allocator to use.
+ * \param alignment The alignment in bytes. Must be a power of 2.
  * \return The allocated memory. Will return a nullptr if allocation fails.
  */
-void* Alloc(u64 size, Allocator type = Allocator::Persistent);
+void* Alloc(u64 size, Allocator type = Allocator::Persistent, u64 alignment = DEFAULT_ALIGNMENT);
 
 /**
  * \brief Reallocates an existing buffer.
@@ -33,9 +69,10 @@ void* Alloc(u64 size, Allocator type = Allocator::Persistent);
  * When nullptr is passed it will `Alloc()` an new buffer.
  * \param size The new size in bytes.
  * \param type The allocator to use. Must match the previously used allocator.
+ * \param alignment The alignment in bytes. Must be a power of 2.
  * \return The reallocated buffer. Will return nullptr if reallocation fails.
  */
-void* Realloc(void* ptr, u64 size, Allocator type = Allocator::Persistent);
+void* Realloc(void* ptr, u64 size, Allocator type = Allocator::Persistent, u64 alignment = DEFAULT_ALIGNMENT);
 
 /**
  * \brief Frees the buffer.
@@ -46,16 +83,197 @@ void* Realloc(void* ptr, u64 size, Allocator type = Allocator::Persistent);
 void Free(void* ptr, Allocator type = Allocator::Persistent);
 
 /**
- * \brief Frees all the memory associated with the temporary allocator.
+ * \brief Frees all the memory associated with the calling thread's temporary allocator.
  * Call this at the end of your program.
  */
 void DeleteTemporaryAllocator();
 
+/**
+ * \brief Releases all the memory associated with the pool allocator.
+ * Call this at the end of your program, after all pooled objects are freed.
+ */
+void DeletePoolAllocator();
+
+/**
+ * \brief A position in the calling thread's temporary arena.
+ */
+struct TemporaryMarker {
+    u64 offset = 0;
+    u32 generation = 0;
+};
+
+/**
+ * \brief Sets the size of the temporary arenas.
+ * Applies to the calling thread's arena and every arena that gets created afterwards.
+ * All temporary allocations made on the calling thread are invalidated.
+ *
+ * \param sizeInBytes The arena size in bytes.
+ */
+void SetTemporaryCapacity(u64 sizeInBytes);
+
+/**
+ * \return The size of the calling thread's temporary arena in bytes.
+ */
+u64 GetTemporaryCapacity();
+
+/**
+ * \return How many bytes of the calling thread's temporary arena are in use.
+ */
+u64 GetTemporaryUsedBytes();
+
+/**
+ * \brief Marks the current position of the calling thread's temporary arena.
+ *
+ * \return The marker. Pass it to `PopTemporaryMarker()` to release everything allocated after it.
+ */
+TemporaryMarker PushTemporaryMarker();
+
+/**
+ * \brief Releases all temporary allocations made after the marker.
+ * Markers must be popped in the reverse order they were pushed.
+ *
+ * \param marker The marker returned by `PushTemporaryMarker()`.
+ */
+void PopTemporaryMarker(TemporaryMarker marker);
+
+/**
+ * \brief Releases all temporary allocations of the calling thread.
+ * Gets called by the `App` at the start of every frame.
+ */
+void ResetTemporaryAllocator();
+
+/**
+ * \brief Checks if a temporary allocation has not been released or overwritten
+ * because the arena wrapped around.
+ *
+ * \param ptr The previously allocated buffer.
+ * \return Whether or not the allocation is still alive.
+ */
+bool IsTemporaryAllocationValid(void* ptr);
+
+/**
+ * \brief Counters of how `Realloc()` satisfied temporary allocations.
+ */
+struct TemporaryStats {
+    // The allocation was the most recent one and got extended in place
+    u64 inPlaceGrows = 0;
+
+    // The allocation had to be moved to a new block
+    u64 copyingGrows = 0;
+
+    // How many bytes were copied by copying grows
+    u64 bytesCopied = 0;
+};
+
+/**
+ * \return The reallocation counters of the calling thread's temporary arena.
+ */
+TemporaryStats GetTemporaryStats();
+
+/**
+ * \brief Resets the reallocation counters of the calling thread's temporary arena.
+ */
+void ResetTemporaryStats();
+
+/**
+ * \brief Pushes a temporary marker on construction and pops it on destruction.
+ */
+class ScopedArena {
+public:
+    ScopedArena() : marker(PushTemporaryMarker()) {}
+
+    ~ScopedArena() {
+        PopTemporaryMarker(marker);
+    }
+
+private:
+    TemporaryMarker marker;
+};
+
 /**
  * \return How many bytes haven't been freed yet.
  */
 u64 GetAllocatedBytes();
 
+/**
+ * \brief Sets the memory tag of the calling thread.
+ *
+ * \param tag The tag new allocations will be made with.
+ */
+void SetMemoryTag(MemoryTag tag);
+
+/**
+ * \return The memory tag of the calling thread.
+ */
+MemoryTag GetMemoryTag();
+
+/**
+ * \param tag The tag.
+ * \return The name of the tag.
+ */
+const char* GetMemoryTagName(MemoryTag tag);
+
+/**
+ * \brief The live statistics of a memory tag.
+ * Temporary allocations only count towards the allocation counts.
+ */
+struct MemoryTagStats {
+    // How many bytes haven't been freed yet
+    u64 currentBytes = 0;
+
+    // The highest `currentBytes` has been
+    u64 peakBytes = 0;
+
+    // How many allocations haven't been freed yet
+    u64 liveAllocations = 0;
+
+    // How many allocations and reallocations have been made in total
+    u64 totalAllocations = 0;
+
+    // How many allocations and reallocations were made in the last frame
+    u64 frameAllocations = 0;
+};
+
+/**
+ * \param tag The tag.
+ * \return The statistics of the tag.
+ */
+MemoryTagStats GetMemoryTagStats(MemoryTag tag);
+
+/**
+ * \param bucket The bucket index, see `MEMORY_HISTOGRAM_BUCKETS`.
+ * \return How many allocations fell in the size bucket.
+ */
+u64 GetAllocationHistogram(int bucket);
+
+/**
+ * \brief Ends the frame for the per-frame allocation counts.
+ * Gets called by the `App` at the start of every frame.
+ */
+void ResetFrameMemoryStats();
+
+/**
+ * \brief Resets the peak of every tag to its current amount of bytes.
+ */
+void ResetPeakMemoryStats();
+
+/**
+ * \brief Sets the memory tag on construction and restores the previous one on destruction.
+ */
+class ScopedMemoryTag {
+public:
+    ScopedMemoryTag(MemoryTag tag) : previous(GetMemoryTag()) {
+        SetMemoryTag(tag);
+    }
+
+    ~ScopedMemoryTag() {
+        SetMemoryTag(previous);
+    }
+
+private:
+    MemoryTag previous;
+};
+
 /**
  * \param ptr The previously allocated buffer.
  * \param type The allocator to use.
@@ -70,7 +288,8 @@ u64 GetAllocatedSize(void* ptr, Allocator type = Allocator::Persistent);
 Allocator GetAllocator(void* ptr);
 
 /**
- * \brief Allocates and constructs a new `T` with the persistent allocator.
+ * \brief Allocates and constructs a new `T` with the pool allocator.
+ * Objects that are too big for the pool use the persistent allocator.
  * 
  * \tparam T The type to allocate and construct.
  * \tparam Args The constructor arguments.
@@ -79,7 +298,7 @@ Allocator GetAllocator(void* ptr);
  */
 template<typename T, typename ...Args>
 T* New(Args&&... args) {
-    T* t = (T*)Alloc(sizeof(T));
+    T* t = (T*)Alloc(sizeof(T), Allocator::Pool, alignof(T));
     new (t) T(std::forward<Args>(args)...);
 
     return t;
@@ -94,7 +313,9 @@ T* New(Args&&... args) {
 template<typename T>
 void Delete(T* t) {
     t->~T();
-    Free(t);
+
+    // The pool knows by the address whether `t` is a pooled block or a persistent allocation
+    Free(t, Allocator::Pool);
 }
 
 }
@@ -2,6 +2,8 @@
 
 #include <memory.h>
 #include <new>
+#include <type_traits>
+#include <utility>
 
 #include "Pandora/Core/Assert.h"
 #include "Pandora/Core/Types.h"
@@ -9,18 +11,45 @@
 #include "Pandora/Core/Data/Memory.h"
 #include "Pandora/Core/Data/Slice.h"
 #include "Pandora/Core/Data/Optional.h"
+#include "Pandora/Core/Data/Sort.h"
 #include "Pandora/Core/Logging/PrintType.h"
 
 namespace pd {
 
+/**
+ * \brief How an array grows its buffer when it runs out of space.
+ */
+struct ArrayGrowthPolicy {
+    // How many elements the first allocation holds
+    int initialCount = 32;
+
+    // How much the buffer grows by each time it runs out, must be bigger than 1
+    f32 growFactor = 2.0f;
+};
+
 template<typename T>
 class Array {
 public:
 
     /**
      * \param allocator The allocator to use.
+     * \param alignment The alignment of the buffer in bytes. Is never less than `alignof(T)`.
+     */
+    Array(Allocator allocator = Allocator::Persistent, u32 alignment = alignof(T));
+
+    /**
+     * \brief Copies all elements of `other` into a new buffer with the same allocator.
+     * 
+     * \param other The other array.
+     */
+    Array(const Array<T>& other);
+
+    /**
+     * \brief Takes over the buffer of `other`, leaving it empty.
+     * 
+     * \param other The other array.
      */
-    Array(Allocator allocator = Allocator::Persistent);
+    Array(Array<T>&& other);
 
     virtual ~Array();
 
@@ -60,7 +89,16 @@ public:
      * \return The index of the newly constructed element.
      */
     template<typename ...Args>
-    int Add(Args ...args);
+    int Add(Args&&... args);
+
+    /**
+     * \brief Constructs a new element in place at the end of the array.
+     * 
+     * \param args The constructor arguments, they are perfectly forwarded.
+     * \return The newly constructed element.
+     */
+    template<typename ...Args>
+    T& EmplaceBack(Args&&... args);
 
     /**
      * \brief Adds a range of elements to the end of the array.
@@ -125,11 +163,47 @@ public:
 
     /**
      * \brief Adds `reservationCount` default-constructed elements.
+     * Use `ReserveCapacity()` to only make room for them.
      * 
      * \param reservationCount How many elements to reserve.
      */
     void Reserve(int reservationCount);
 
+    /**
+     * \brief Makes sure the buffer can hold at least `capacity` elements without growing.
+     * Does not construct any elements or change the count.
+     * 
+     * \param capacity How many elements the buffer needs to hold.
+     */
+    void ReserveCapacity(int capacity);
+
+    /**
+     * \brief Shrinks the buffer so it holds exactly `Count()` elements.
+     * Frees the buffer if the array is empty.
+     */
+    void ShrinkToFit();
+
+    /**
+     * \brief Adds `addCount` elements at the end of the array without constructing them.
+     * Only allowed for trivially copyable types, every element needs to be written before it's read.
+     * 
+     * \param addCount How many elements to add.
+     * \return The index of the first added element.
+     */
+    int AddUninitialized(int addCount);
+
+    /**
+     * \brief Sets how the buffer grows when it runs out of space.
+     * 
+     * \param policy The growth policy.
+     */
+    void SetGrowthPolicy(ArrayGrowthPolicy policy);
+
+    /**
+     * \return How the buffer grows when it runs out of space.
+     */
+    inline ArrayGrowthPolicy GrowthPolicy() const;
+
     /**
      * \brief Removes the element at the specified index.
      * This operation is ordered.
@@ -162,16 +236,39 @@ public:
     inline void Clear();
 
     /**
-     * \brief Sorts the buffer using quicksort.
+     * \brief Sorts the buffer using pattern-defeating quicksort.
+     * This sort is not stable, use `StableSort()` if equal elements need to keep their order.
      * 
      * \tparam LessLambda The sort function. Generic lambdas are possible.
-     * \param func The sort function. Needs to return false if `a` is less than `b`.
+     * \param func The sort function. Needs to return true if `a` is less than `b`.
      * \param offset The offset from the start.
      * \param count How many elements to sort. Pass -1 for all remaining elements.
      */
     template<typename LessLambda>
     void Sort(LessLambda func, int offset = 0, int count = -1);
 
+    /**
+     * \brief Sorts the buffer using merge sort. Equal elements keep their order.
+     * 
+     * \tparam LessLambda The sort function. Generic lambdas are possible.
+     * \param func The sort function. Needs to return true if `a` is less than `b`.
+     * \param offset The offset from the start.
+     * \param count How many elements to sort. Pass -1 for all remaining elements.
+     */
+    template<typename LessLambda>
+    void StableSort(LessLambda func, int offset = 0, int count = -1);
+
+    /**
+     * \brief Sorts the buffer by an integer or float key using radix sort. Equal keys keep their order.
+     * 
+     * \tparam KeyLambda The key function. Generic lambdas are possible.
+     * \param func The key function. Needs to return the key of the element.
+     * \param offset The offset from the start.
+     * \param count How many elements to sort. Pass -1 for all remaining elements.
+     */
+    template<typename KeyLambda>
+    void RadixSort(KeyLambda func, int offset = 0, int count = -1);
+
     /**
      * \brief Finds a specific element in the buffer.
      * 
@@ -225,6 +322,11 @@ public:
      */
     inline u64 BufferSize() const;
 
+    /**
+     * \return How many elements fit in the buffer before it has to grow.
+     */
+    inline int Capacity() const;
+
     /**
      * \return How many elements are in the array.
      */
@@ -235,6 +337,11 @@ public:
      */
     inline Allocator Allocator() const;
 
+    /**
+     * \return The alignment of the buffer in bytes.
+     */
+    inline u32 Alignment() const;
+
     /**
      * \brief Creates a slice based on the array.
      * 
@@ -257,8 +364,11 @@ public:
 
     T& operator[](int i) const;
 
-    // Delete memory and Copy by reference
-    void operator=(const Array<T>& other);
+    // Destructs all elements and copies the elements of `other`
+    Array<T>& operator=(const Array<T>& other);
+
+    // Takes over the buffer when both arrays use the same allocator, moves the elements otherwise
+    Array<T>& operator=(Array<T>&& other);
 
     template<typename U>
     struct ArrayIt {
@@ -308,6 +418,29 @@ protected:
      */
     void Construct(int index, int count);
 
+    /**
+     * \brief Copy-constructs elements at the end of the array, the buffer must be big enough.
+     * Trivially copyable types are copied in bulk.
+     * 
+     * \param elements The elements to copy.
+     * \param count How many elements to copy.
+     */
+    void CopyConstruct(const T* elements, int count);
+
+    /**
+     * \brief Whether or not the array owns a heap buffer that can be handed over to another array.
+     */
+    inline bool CanStealBuffer() const;
+
+    /**
+     * \brief Resolves the count of a sorting range.
+     * 
+     * \param offset The offset from the start.
+     * \param count How many elements to sort, -1 gets replaced by all remaining elements.
+     * \return Whether or not there's anything to sort.
+     */
+    inline bool ClampSortRange(int offset, int& count) const;
+
     /**
      * \brief Destructs elements in the given range.
      * 
@@ -320,6 +453,8 @@ protected:
     T* memory = nullptr;
     u64 bufferSize = 0;
     int count = 0;
+    u32 alignment = alignof(T);
+    ArrayGrowthPolicy growthPolicy;
 };
 
 template<typename T, int maxCapacity>
@@ -329,6 +464,15 @@ public:
         this->bufferSize = maxCapacity * sizeof(T);
     }
 
+    BoundedArray(const BoundedArray<T, maxCapacity>& other) : BoundedArray() {
+        this->AddRange(other.Data(), other.Count());
+    }
+
+    BoundedArray<T, maxCapacity>& operator=(const BoundedArray<T, maxCapacity>& other) {
+        Array<T>::operator=(other);
+        return *this;
+    }
+
     virtual ~BoundedArray() {
         // For some reason when ~Array() calls Data() it calls it's own version
         // and not the overloaded version
@@ -345,7 +489,7 @@ public:
 
 private:
     // The reason this is a byte array and not an array of `T` is because we don't to automatically construct or destruct any elements
-    byte stackMemory[maxCapacity * sizeof(T)] = {};
+    alignas(T) byte stackMemory[maxCapacity * sizeof(T)] = {};
 };
 
 // Print
@@ -382,7 +526,32 @@ inline void PrintType(Array<U>& type, FormatInfo& info) {
 //
 
 template<typename T>
-inline Array<T>::Array(pd::Allocator allocator) : allocator(allocator) {}
+inline Array<T>::Array(pd::Allocator allocator, u32 alignment) : allocator(allocator) {
+    PD_ASSERT_D((alignment & (alignment - 1)) == 0, "alignment must be a power of 2, given: %u", alignment);
+
+    if (alignment > this->alignment) {
+        this->alignment = alignment;
+    }
+}
+
+template<typename T>
+inline Array<T>::Array(const Array<T>& other)
+    : Array((other.allocator == Allocator::None) ? Allocator::Persistent : other.allocator, other.alignment) {
+    growthPolicy = other.growthPolicy;
+
+    if (other.Count() > 0) {
+        Grow(other.Count(), false);
+        CopyConstruct(other.Data(), other.Count());
+    }
+}
+
+template<typename T>
+inline Array<T>::Array(Array<T>&& other)
+    : Array((other.allocator == Allocator::None) ? Allocator::Persistent : other.allocator, other.alignment) {
+    growthPolicy = other.growthPolicy;
+
+    operator=(std::move(other));
+}
 
 template<typename T>
 inline Array<T>::~Array() {
@@ -420,19 +589,43 @@ inline int Array<T>::Add(const T& t) {
 
 template<typename T>
 inline int Array<T>::Add(const T* t) {
-    Grow(count + 1);
-    Data()[count] = *((T*)t);
+    // The element might live in our own buffer which can move when growing
+    if (t >= Data() && t < Data() + count) {
+        int index = (int)(t - Data());
 
-    return count++;
+        Grow(count + 1, false);
+        t = Data() + index;
+    } else {
+        Grow(count + 1, false);
+    }
+
+    CopyConstruct(t, 1);
+
+    return count - 1;
 }
 
 template<typename T>
 template<typename ...Args>
-inline int Array<T>::Add(Args ...args) {
-    Grow(count + 1);
-    new (&Data()[count]) T(std::forward<Args>(args)...);
+inline int Array<T>::Add(Args&&... args) {
+    EmplaceBack(std::forward<Args>(args)...);
+
+    return count - 1;
+}
+
+template<typename T>
+template<typename ...Args>
+inline T& Array<T>::EmplaceBack(Args&&... args) {
+    if ((u64)(count + 1) * sizeof(T) > bufferSize) {
+        // The arguments might reference our own elements which move when growing
+        T t(std::forward<Args>(args)...);
+
+        Grow(count + 1, false);
+        new (&Data()[count]) T(std::move(t));
+    } else {
+        new (&Data()[count]) T(std::forward<Args>(args)...);
+    }
 
-    return count++;
+    return Data()[count++];
 }
 
 template<typename T>
@@ -445,12 +638,17 @@ template<typename T>
 inline int Array<T>::AddRange(T* memory, int count) {
     int startIndex = this->count;
 
-    Grow(startIndex + count);
-    for (int i = 0; i < count; i++) {
-        Data()[startIndex + i] = memory[i];
+    // The range might be part of our own buffer which can move when growing
+    if (memory >= Data() && memory < Data() + this->count) {
+        int index = (int)(memory - Data());
+
+        Grow(startIndex + count, false);
+        memory = Data() + index;
+    } else {
+        Grow(startIndex + count, false);
     }
 
-    this->count += count;
+    CopyConstruct(memory, count);
 
     return startIndex;
 }
@@ -474,12 +672,17 @@ inline void Array<T>::Insert(int index, const T* t) {
         // If we're trying to insert at the end we can just Add it
         Add(t);
     } else {
+        // Copy it first, it might be one of the elements that are getting moved
+        T copy(*t);
+
         Resize(count + 1);
         // Move everything to the right
-        MemoryCopy(Data() + index + 1,
+        MemoryMove(Data() + index + 1,
                    Data() + index,
-                   (count++ - index) * sizeof(T), true);
-        Data()[index] = *t;
+                   (count++ - index) * sizeof(T));
+
+        // The old element got moved, so the slot is uninitialized
+        new (Data() + index) T(std::move(copy));
     }
 }
 
@@ -508,9 +711,9 @@ inline void Array<T>::Swap(int a, int b) {
     PD_ASSERT_D(a >= 0 && a < Count() && b >= 0 && b < Count(),
                 "illegal swap indices, valid: 0:%d, given %d,%d", Count(), a, b);
 
-    T tmp = Data()[a];
-    Data()[a] = Data()[b];
-    Data()[b] = tmp;
+    T tmp = std::move(Data()[a]);
+    Data()[a] = std::move(Data()[b]);
+    Data()[b] = std::move(tmp);
 }
 
 template<typename T>
@@ -523,6 +726,61 @@ inline void Array<T>::Reserve(int reservationCount) {
     count += reservationCount;
 }
 
+template<typename T>
+inline void Array<T>::ReserveCapacity(int capacity) {
+    PD_ASSERT_D(capacity >= 0, "capacity must be positive, given: %d", capacity);
+
+    u64 newSize = (u64)capacity * sizeof(T);
+    if (newSize <= bufferSize) return;
+
+    // Bounded arrays can't grow
+    if (Data() != memory || allocator == pd::Allocator::None) return;
+
+    memory = (T*)Realloc(memory, newSize, allocator, alignment);
+    bufferSize = newSize;
+}
+
+template<typename T>
+inline void Array<T>::ShrinkToFit() {
+    if (Data() != memory || allocator == pd::Allocator::None || !memory) return;
+
+    if (count == 0) {
+        Free(memory, allocator);
+        memory = nullptr;
+        bufferSize = 0;
+    } else if (SizeInBytes() < bufferSize) {
+        memory = (T*)Realloc(memory, SizeInBytes(), allocator, alignment);
+        bufferSize = SizeInBytes();
+    }
+}
+
+template<typename T>
+inline int Array<T>::AddUninitialized(int addCount) {
+    static_assert(std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value,
+                  "T must be trivially copyable and destructible to skip construction.");
+    PD_ASSERT_D(addCount >= 0, "add count must be positive, given: %d", addCount);
+
+    int startIndex = count;
+
+    Grow(count + addCount, false);
+    count += addCount;
+
+    return startIndex;
+}
+
+template<typename T>
+inline void Array<T>::SetGrowthPolicy(ArrayGrowthPolicy policy) {
+    PD_ASSERT_D(policy.initialCount > 0, "initial count must be positive, given: %d", policy.initialCount);
+    PD_ASSERT_D(policy.growFactor > 1.0f, "grow factor must be bigger than 1, given: %f", policy.growFactor);
+
+    growthPolicy = policy;
+}
+
+template<typename T>
+inline ArrayGrowthPolicy Array<T>::GrowthPolicy() const {
+    return growthPolicy;
+}
+
 template<typename T>
 inline void Array<T>::Remove(int index) {
     PD_ASSERT_D(index >= 0 && index < Count(),
@@ -534,7 +792,7 @@ inline void Array<T>::Remove(int index) {
         // If it's the last element we can just decrease the count
         count -= 1;
     } else {
-        MemoryCopy(Data() + index,
+        MemoryMove(Data() + index,
                    Data() + index + 1,
                    ((u64)count - (u64)index) * sizeof(T));
 
@@ -550,7 +808,7 @@ inline void Array<T>::RemoveUnordered(int index) {
     count -= 1;
     if (index != count) {
         // Put the last element in it's place
-        At(index) = At(count);
+        At(index) = std::move(At(count));
     }
     Destruct(count, 1);
 }
@@ -567,9 +825,9 @@ inline void Array<T>::RemoveRange(int index, int count) {
     Destruct(index, count);
 
     this->count -= count;
-    MemoryCopy(Data() + index,
+    MemoryMove(Data() + index,
                Data() + index + count,
-               (this->count - index) * sizeof(T), true);
+               (this->count - index) * sizeof(T));
 }
 
 template<typename T>
@@ -581,7 +839,30 @@ inline void Array<T>::Clear() {
 template<typename T>
 template<typename LessLambda>
 inline void Array<T>::Sort(LessLambda func, int offset, int count) {
-    if (Count() == 0 || (count >= 0 && offset >= (offset + count - 1))) return;
+    if (!ClampSortRange(offset, count)) return;
+
+    IntroSort(Data() + offset, count, func);
+}
+
+template<typename T>
+template<typename LessLambda>
+inline void Array<T>::StableSort(LessLambda func, int offset, int count) {
+    if (!ClampSortRange(offset, count)) return;
+
+    pd::StableSort(Data() + offset, count, func);
+}
+
+template<typename T>
+template<typename KeyLambda>
+inline void Array<T>::RadixSort(KeyLambda func, int offset, int count) {
+    if (!ClampSortRange(offset, count)) return;
+
+    pd::RadixSort(Data() + offset, count, func);
+}
+
+template<typename T>
+inline bool Array<T>::ClampSortRange(int offset, int& count) const {
+    if (Count() == 0 || (count >= 0 && offset >= (offset + count - 1))) return false;
 
     if (count <= 0) {
         count = this->count - offset;
@@ -590,36 +871,7 @@ inline void Array<T>::Sort(LessLambda func, int offset, int count) {
     PD_ASSERT_D(offset >= 0 && offset < Count() && offset + count <= Count(),
                 "illegal sorting range, valid: 0:%d, given: %d:%d", Count(), offset, count);
 
-    // Quick sort baby!
-
-    const auto partition = [func, this](T* memory, int start, int end) {
-        int i = start;
-        for (int j = start; j < end; j++) {
-            if (func(memory[j], memory[end])) {
-                Swap(i, j);
-                i += 1;
-            }
-        }
-
-        Swap(i, end);
-        return i;
-    };
-
-    // Recursive lambda, see https://stackoverflow.com/a/40873505
-    // The `-> void` is required on `quickSortImpl` or else it thinks is fooled
-    // into believing it returns auto and it throws a big fat error
-    const auto quickSort = [partition](T* memory, int start, int end) {
-        auto quickSortImpl = [partition](T* memory, int start, int end, auto& quick) -> void {
-            if (start < end) {
-                int p = partition(memory, start, end);
-                quick(memory, start, p - 1, quick);
-                quick(memory, p + 1, end, quick);
-            }
-        };
-        quickSortImpl(memory, start, end, quickSortImpl);
-    };
-
-    quickSort(Data(), offset, offset + count - 1);
+    return true;
 }
 
 template<typename T>
@@ -649,18 +901,13 @@ inline void Array<T>::ChangeAllocator(pd::Allocator allocator) {
 
     if (allocator == pd::Allocator::None) {
         Delete();
-    } else if (allocator == pd::Allocator::Persistent) {
-        T* newMemory = (T*)Alloc(bufferSize, allocator);
-        MemoryCopy(newMemory, memory, bufferSize);
-
-        // We know that `memory` doesn't use the persistent allocator so we don't need to free it
-        memory = newMemory;
-    } else if (allocator == pd::Allocator::Temporary) {
-        T* newMemory = (T*)Alloc(bufferSize, allocator);
+    } else {
+        T* newMemory = (T*)Alloc(bufferSize, allocator, alignment);
         MemoryCopy(newMemory, memory, bufferSize);
 
-        if (this->allocator == pd::Allocator::Persistent) {
-            Free(memory);
+        // Does nothing for temporary memory
+        if (memory) {
+            Free(memory, this->allocator);
         }
 
         memory = newMemory;
@@ -699,6 +946,11 @@ inline u64 Array<T>::BufferSize() const {
     return bufferSize;
 }
 
+template<typename T>
+inline int Array<T>::Capacity() const {
+    return (int)(bufferSize / sizeof(T));
+}
+
 template<typename T>
 inline int Array<T>::Count() const {
     return count;
@@ -709,6 +961,11 @@ inline Allocator Array<T>::Allocator() const {
     return allocator;
 }
 
+template<typename T>
+inline u32 Array<T>::Alignment() const {
+    return alignment;
+}
+
 template<typename T>
 inline Slice<T> Array<T>::Slice(int offset, int count) {
     if (count < 0) {
@@ -734,32 +991,71 @@ inline T& Array<T>::operator[](int i) const {
 }
 
 template<typename T>
-inline void Array<T>::operator=(const Array<T>& other) {
-    Delete();
+inline Array<T>& Array<T>::operator=(const Array<T>& other) {
+    if (&other == this) return *this;
 
-    Reserve(other.Count());
+    Clear();
 
-    for (int i = 0; i < other.Count(); i++) {
-        Data()[i] = other.Data()[i];
+    Grow(other.Count(), false);
+    CopyConstruct(other.Data(), other.Count());
+
+    return *this;
+}
+
+template<typename T>
+inline Array<T>& Array<T>::operator=(Array<T>&& other) {
+    if (&other == this) return *this;
+
+    if (CanStealBuffer() && other.CanStealBuffer() &&
+        (allocator == other.allocator || !memory) && other.alignment >= alignment) {
+        Delete();
+
+        // The buffer is at least as aligned as we need, keep its alignment for reallocating it
+        allocator = other.allocator;
+        alignment = other.alignment;
+        memory = other.memory;
+        bufferSize = other.bufferSize;
+        count = other.count;
+
+        other.memory = nullptr;
+        other.bufferSize = 0;
+        other.count = 0;
+    } else {
+        Clear();
+        Grow(other.Count(), false);
+
+        if (std::is_trivially_copyable<T>::value) {
+            MemoryCopy(Data(), other.Data(), other.SizeInBytes());
+        } else {
+            for (int i = 0; i < other.Count(); i++) {
+                new (Data() + i) T(std::move(other.Data()[i]));
+            }
+        }
+
+        count = other.count;
+        other.Clear();
     }
+
+    return *this;
 }
 
 template<typename T>
 inline void Array<T>::Grow(int newCount, bool construct) {
-    // Should these be in here?
-    const int INITIAL_LENGTH = 32;
-    const int GROW_FACTOR = 2;
-
     if (newCount > bufferSize / sizeof(T)) {
-        if (!Data()) {
-            bufferSize = INITIAL_LENGTH * sizeof(T);
+        u64 newSize = bufferSize;
+
+        if (!Data() || newSize == 0) {
+            newSize = (u64)growthPolicy.initialCount * sizeof(T);
         }
 
-        while (bufferSize < newCount * sizeof(T)) {
-            bufferSize *= GROW_FACTOR;
+        while (newSize < (u64)newCount * sizeof(T)) {
+            // Always grow by at least one element so small factors still make progress
+            u64 grown = (u64)((f64)newSize * (f64)growthPolicy.growFactor);
+            newSize = (grown > newSize + sizeof(T)) ? grown / sizeof(T) * sizeof(T) : newSize + sizeof(T);
         }
 
-        memory = (T*)Realloc(Data(), bufferSize, allocator);
+        memory = (T*)Realloc(Data(), newSize, allocator, alignment);
+        bufferSize = newSize;
     }
 
     // Construct new memory
@@ -770,8 +1066,9 @@ inline void Array<T>::Grow(int newCount, bool construct) {
 
 template<typename T>
 inline void Array<T>::Construct(int index, int count) {
-    if (count == 1) {
-        new (Data() + index) T();
+    if (std::is_trivially_default_constructible<T>::value) {
+        // Value-initializing a trivial type zeroes it
+        MemorySet(Data() + index, (u64)count * sizeof(T), 0);
     } else {
         for (int i = 0; i < count; i++) {
             new (Data() + index + i) T();
@@ -780,14 +1077,33 @@ inline void Array<T>::Construct(int index, int count) {
 }
 
 template<typename T>
-inline void Array<T>::Destruct(int index, int count) {
-    if (count == 1) {
-        At(index).~T();
+inline void Array<T>::CopyConstruct(const T* elements, int count) {
+    if (count <= 0) return;
+
+    if (std::is_trivially_copyable<T>::value) {
+        MemoryMove(Data() + this->count, elements, (u64)count * sizeof(T));
     } else {
-        for (int i = index; i < count; i++) {
-            At(i).~T();
+        for (int i = 0; i < count; i++) {
+            new (Data() + this->count + i) T(elements[i]);
         }
     }
+
+    this->count += count;
+}
+
+template<typename T>
+inline bool Array<T>::CanStealBuffer() const {
+    // Bounded arrays keep their elements inline
+    return memory == Data() && allocator != pd::Allocator::None;
+}
+
+template<typename T>
+inline void Array<T>::Destruct(int index, int count) {
+    if (std::is_trivially_destructible<T>::value) return;
+
+    for (int i = index; i < index + count; i++) {
+        At(i).~T();
+    }
 }
 
 }
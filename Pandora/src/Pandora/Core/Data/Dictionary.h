@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <utility>
 
 #include "Pandora/Core/Types.h"
 #include "Pandora/Core/Data/Memory.h"
@@ -10,25 +11,78 @@
 namespace pd {
 
 /**
- * \brief Compares to keys by hasing them and comparing the hash.
+ * \brief Compares two keys.
+ * The dictionary only calls this when the hashes of the keys match.
  *
  * \tparam K The key type.
  * \param a The first key.
  * \param b The second key.
- * \return Whether or not the hashes match.
+ * \return Whether or not the keys are equal.
  */
 template<typename K>
 bool CompareKeys(const K& a, const K& b) {
-    return DoHash(a) == DoHash(b);
+    return a == b;
 }
 
+/**
+ * \brief Describes how keys of type `K` can be looked up with a value of type `L`
+ * without constructing a `K`. Specialize it with `enabled = true` to allow it,
+ * `Hash()` must give the same hash as `DoHash()` does for the equivalent `K`.
+ *
+ * \tparam K The key type.
+ * \tparam L The lookup type.
+ */
+template<typename K, typename L>
+struct KeyLookup {
+    static const bool enabled = false;
+};
+
+template<typename K>
+struct KeyLookup<K, K> {
+    static const bool enabled = true;
+
+    static u64 Hash(const K& key) {
+        return DoHash(key);
+    }
+
+    static bool Equals(const K& a, const K& b) {
+        return CompareKeys(a, b);
+    }
+
+    static void ToKey(K& out, const K& key) {
+        out = key;
+    }
+};
+
+template<>
+struct KeyLookup<String, StringView> {
+    static const bool enabled = true;
+
+    static u64 Hash(const StringView& key) {
+        return DoHash(key);
+    }
+
+    static bool Equals(const String& a, const StringView& b) {
+        return a == b;
+    }
+
+    static void ToKey(String& out, const StringView& key) {
+        out.Set(key);
+    }
+};
+
 
 template<typename K, typename V>
 struct DictEntry {
     static_assert(std::is_default_constructible<K>::value, "K must be default constructible.");
     static_assert(std::is_default_constructible<V>::value, "V must be default constructible.");
 
-    i8 dist = -1;
+    // How far the entry is from its ideal bucket, -1 if the bucket is empty
+    i32 dist = -1;
+
+    // The full hash of the key, so lookups and rehashing never hash stored keys again
+    u64 hash = 0;
+
     K key = K();
     V val = V();
 };
@@ -37,6 +91,9 @@ struct DictEntry {
 template<typename K, typename V>
 class Dictionary {
     using Entry = DictEntry<K, V>;
+
+    template<typename L>
+    using EnableLookup = typename std::enable_if<KeyLookup<K, L>::enabled>::type;
 public:
 
     Dictionary(Allocator allocator = Allocator::Persistent) : allocator(allocator) {}
@@ -44,6 +101,10 @@ public:
         operator=(other);
     }
 
+    Dictionary(Dictionary<K, V>&& other) : allocator(other.allocator) {
+        operator=(std::move(other));
+    }
+
     virtual ~Dictionary();
 
     /**
@@ -58,12 +119,67 @@ public:
      */
     bool Contains(const K& key) const;
 
+    /**
+     * \brief Looks up the key without constructing a `K`, see `KeyLookup`.
+     *
+     * \param key The key.
+     * \return Whether or not the key was found in the dictionary.
+     */
+    template<typename L, typename = EnableLookup<L>>
+    bool Contains(const L& key) const;
+
+    /**
+     * \param key The key.
+     * \return The value associated with the key, nullptr if it wasn't found.
+     */
+    V* Find(const K& key) const;
+
+    /**
+     * \brief Looks up the key without constructing a `K`, see `KeyLookup`.
+     *
+     * \param key The key.
+     * \return The value associated with the key, nullptr if it wasn't found.
+     */
+    template<typename L, typename = EnableLookup<L>>
+    V* Find(const L& key) const;
+
+    /**
+     * \brief Looks up the key with a hash that was computed earlier.
+     *
+     * \param key The key.
+     * \param hash The hash of the key, it must match `KeyLookup<K, L>::Hash(key)`.
+     * \return The value associated with the key, nullptr if it wasn't found.
+     */
+    template<typename L, typename = EnableLookup<L>>
+    V* Find(const L& key, u64 hash) const;
+
     /**
      * \param key The key.
      * \return The value associated with the key. Inserts it if it wasn't found.
      */
     V& Get(const K& key);
 
+    /**
+     * \brief Looks up the key without constructing a `K`, see `KeyLookup`.
+     * A `K` is only constructed when the key has to be inserted.
+     *
+     * \param key The key.
+     * \return The value associated with the key. Inserts it if it wasn't found.
+     */
+    template<typename L, typename = EnableLookup<L>>
+    V& Get(const L& key);
+
+    /**
+     * \brief Looks up the key with a hash that was computed earlier.
+     * A `K` is only constructed when the key has to be inserted.
+     *
+     * \param key The key.
+     * \param hash The hash of the key, it must match `KeyLookup<K, L>::Hash(key)`.
+     * \return The value associated with the key. Inserts it if it wasn't found.
+     */
+    template<typename L, typename = EnableLookup<L>>
+    V& Get(const L& key, u64 hash);
+
     /**
      * \brief Sets the value assocaited with the key.
      *
@@ -91,6 +207,15 @@ public:
      */
     bool Remove(const K& key);
 
+    /**
+     * \brief Removes the key-value pair without constructing a `K`, see `KeyLookup`.
+     *
+     * \param key The key.
+     * \return Whether or not it got removed successfully.
+     */
+    template<typename L, typename = EnableLookup<L>>
+    bool Remove(const L& key);
+
     /**
      * \return The raw data pointer of the dictionary.
      */
@@ -123,18 +248,41 @@ public:
 
         // Delete and make buffer as big as `other`
         Delete();
-        Init();
+        if (!other.Data()) return *this;
 
-        while (Capacity() != other.Capacity()) {
-            GrowAndRehash();
-        }
+        bufferSize = other.BufferSize();
+        Init();
 
+        // Same buffer size so every entry can go in the same bucket
         for (int i = 0; i < other.Capacity(); i++) {
             if (other.Data()[i].dist >= 0) {
-                Data()[i] = other.Data()[i];
+                new (Data() + i) Entry(other.Data()[i]);
             }
         }
 
+        count = other.count;
+
+        return *this;
+    }
+
+    // Takes over the buffer when both dictionaries use the same allocator, copies the entries otherwise
+    Dictionary<K, V>& operator=(Dictionary<K, V>&& other) {
+        if (&other == this) return *this;
+
+        if (allocator != other.allocator) {
+            return operator=((const Dictionary<K, V>&)other);
+        }
+
+        Delete();
+
+        memory = other.memory;
+        bufferSize = other.bufferSize;
+        count = other.count;
+
+        other.memory = nullptr;
+        other.bufferSize = 0;
+        other.count = 0;
+
         return *this;
     }
 
@@ -190,6 +338,35 @@ protected:
      */
     void GrowAndRehash();
 
+    /**
+     * \brief Moves the entry into the first free bucket, displacing entries closer to their ideal bucket.
+     * The hash of the entry must be set. Does not check the load.
+     *
+     * \param targetEntry The entry to insert.
+     * \return The bucket the entry ended up in.
+     */
+    int InsertEntry(Entry&& targetEntry);
+
+    /**
+     * \param key The key.
+     * \param hash The hash of the key.
+     * \return The bucket holding the key, -1 if it wasn't found.
+     */
+    template<typename L>
+    int FindBucket(const L& key, u64 hash) const;
+
+    /**
+     * \brief Removes the entry in the bucket and shifts the following entries back.
+     *
+     * \param bucket The bucket, must hold an entry.
+     */
+    void RemoveBucket(int bucket);
+
+    /**
+     * \brief Grows the buffer if inserting another entry would go over the maximum load.
+     */
+    inline void ReserveForInsert();
+
     pd::Allocator allocator = Allocator::None;
 
     Entry* memory = nullptr;
@@ -226,74 +403,65 @@ inline void Dictionary<K, V>::Delete() {
 
 template<typename K, typename V>
 inline bool Dictionary<K, V>::Contains(const K& key) const {
-    if (!Data()) return false;
+    return Find(key) != nullptr;
+}
 
-    u64 bucketCount = bufferSize / sizeof(Entry);
-    u64 hash = DoHash(key);
-    u64 bucket = hash & (bucketCount - 1);
+template<typename K, typename V>
+template<typename L, typename>
+inline bool Dictionary<K, V>::Contains(const L& key) const {
+    return Find(key) != nullptr;
+}
 
-    bool looped = false;
-    while (true) {
-        Entry* entry = &memory[bucket];
+template<typename K, typename V>
+inline V* Dictionary<K, V>::Find(const K& key) const {
+    return Find<K>(key, DoHash(key));
+}
 
-        if (entry->dist < 0) {
-            // Unsuccessful lookup
-            return false;
-        } else if (CompareKeys(key, entry->key)) {
-            return true;
-        } else if (looped) {
-            // Unsuccessful lookup
-            return false;
-        }
+template<typename K, typename V>
+template<typename L, typename>
+inline V* Dictionary<K, V>::Find(const L& key) const {
+    return Find(key, KeyLookup<K, L>::Hash(key));
+}
 
-        bucket += 1;
+template<typename K, typename V>
+template<typename L, typename>
+inline V* Dictionary<K, V>::Find(const L& key, u64 hash) const {
+    if (!Data() || count == 0) return nullptr;
 
-        if (bucket >= bucketCount) {
-            looped = true;
-            bucket = 0;
-        }
-    }
+    int bucket = FindBucket(key, hash);
 
-    return false;
+    return (bucket >= 0) ? &memory[bucket].val : nullptr;
 }
 
 template<typename K, typename V>
 inline V& Dictionary<K, V>::Get(const K& key) {
-    Init();
+    return Get<K>(key, DoHash(key));
+}
 
-    u64 bucketCount = bufferSize / sizeof(Entry);
-    u64 hash = DoHash(key);
-    u64 bucket = hash & (bucketCount - 1);
-    u64 idealBucket = bucket;
+template<typename K, typename V>
+template<typename L, typename>
+inline V& Dictionary<K, V>::Get(const L& key) {
+    return Get(key, KeyLookup<K, L>::Hash(key));
+}
 
-    bool looped = false;
-    while (true) {
-        Entry* entry = &memory[bucket];
+template<typename K, typename V>
+template<typename L, typename>
+inline V& Dictionary<K, V>::Get(const L& key, u64 hash) {
+    Init();
 
-        if (entry->dist < 0) {
-            Insert(key);
-            return Get(key);
-        } else if (CompareKeys(key, entry->key)) {
-            return entry->val;
-        } else if (looped) {
-            // If we looped and we're back at the bucket we started at,
-            // that means we have searched every possible spot.
-            if (bucket == idealBucket) {
-                Insert(key);
-                return Get(key);
-            }
-        }
+    int bucket = FindBucket(key, hash);
+    if (bucket >= 0) {
+        return memory[bucket].val;
+    }
 
-        bucket += 1;
+    // Grow first so the bucket we get back stays valid
+    ReserveForInsert();
 
-        if (bucket >= bucketCount) {
-            looped = true;
-            bucket = 0;
-        }
-    }
+    Entry targetEntry;
+    targetEntry.hash = hash;
+    KeyLookup<K, L>::ToKey(targetEntry.key, key);
 
-    Insert(key);
-    return Get(key);
+    return memory[InsertEntry(std::move(targetEntry))].val;
 }
 
 template<typename K, typename V>
@@ -312,94 +480,123 @@ template<typename K, typename V>
 inline bool Dictionary<K, V>::Insert(const K& key, Optional<V> val) {
     Init();
 
-    u64 bucketCount = bufferSize / sizeof(Entry);
     u64 hash = DoHash(key);
-    u64 bucket = hash & (bucketCount - 1);
+    if (FindBucket(key, hash) >= 0) return false;
 
-    const f32 REHASH_LOAD = 0.5f;
+    ReserveForInsert();
 
     Entry targetEntry;
-    targetEntry.dist = 0;
+    targetEntry.hash = hash;
     targetEntry.key = key;
 
     if (val) {
-        targetEntry.val = *val;
+        targetEntry.val = std::move(*val);
     }
 
+    InsertEntry(std::move(targetEntry));
+
+    return true;
+}
+
+template<typename K, typename V>
+inline int Dictionary<K, V>::InsertEntry(Entry&& targetEntry) {
+    u64 bucketMask = bufferSize / sizeof(Entry) - 1;
+    u64 bucket = targetEntry.hash & bucketMask;
+
+    targetEntry.dist = 0;
+
+    // Where the entry we were asked to insert ends up
+    int placed = -1;
+
     while (true) {
         Entry* entry = &memory[bucket];
 
         if (entry->dist < 0) {
-            new (entry) Entry();
-            *entry = targetEntry;
+            new (entry) Entry(std::move(targetEntry));
             count += 1;
 
-            // Check for rehash
-            int rehashThreshold = (int)(f32(Capacity()) * REHASH_LOAD);
-            if (count > rehashThreshold) {
-                GrowAndRehash();
-            }
-
-            return true;
-        } else {
-            if (targetEntry.dist > entry->dist) {
-                // Steal the spot and search for the new target
-                Entry& tmp = memory[bucket];
+            return (placed < 0) ? (int)bucket : placed;
+        } else if (targetEntry.dist > entry->dist) {
+            // Steal the spot and search for a new one for the displaced entry
+            std::swap(targetEntry, *entry);
 
-                targetEntry = memory[bucket];
-                memory[bucket] = tmp;
+            if (placed < 0) {
+                placed = (int)bucket;
             }
         }
 
-        bucket += 1;
+        bucket = (bucket + 1) & bucketMask;
         targetEntry.dist += 1;
+    }
+}
 
-        if (bucket >= bucketCount) {
-            bucket = 0;
-        }
+template<typename K, typename V>
+template<typename L>
+inline int Dictionary<K, V>::FindBucket(const L& key, u64 hash) const {
+    u64 bucketMask = bufferSize / sizeof(Entry) - 1;
+    u64 bucket = hash & bucketMask;
+
+    for (i32 dist = 0; ; dist++) {
+        const Entry& entry = memory[bucket];
+
+        // Entries are sorted by their distance, if we're further away than
+        // the entry in this bucket our key would have been placed here
+        if (entry.dist < dist) return -1;
+
+        // Only compare the keys themselves when the full hashes match
+        if (entry.hash == hash && KeyLookup<K, L>::Equals(entry.key, key)) return (int)bucket;
+
+        bucket = (bucket + 1) & bucketMask;
     }
+}
 
-    return false;
+template<typename K, typename V>
+inline void Dictionary<K, V>::ReserveForInsert() {
+    const f32 REHASH_LOAD = 0.5f;
+
+    int rehashThreshold = (int)(f32(Capacity()) * REHASH_LOAD);
+    if (count + 1 > rehashThreshold) {
+        GrowAndRehash();
+    }
 }
 
 template<typename K, typename V>
 inline bool Dictionary<K, V>::Remove(const K& key) {
-    Init();
+    return Remove<K>(key);
+}
 
-    u64 bucketCount = bufferSize / sizeof(Entry);
-    u64 hash = DoHash(key);
-    u64 bucket = hash & (bucketCount - 1);
+template<typename K, typename V>
+template<typename L, typename>
+inline bool Dictionary<K, V>::Remove(const L& key) {
+    if (!Data() || count == 0) return false;
 
-    bool searchForKey = true;
-    while (true) {
-        Entry* entry = &memory[bucket];
+    int bucket = FindBucket(key, KeyLookup<K, L>::Hash(key));
+    if (bucket < 0) return false;
 
-        if (searchForKey && entry->dist >= 0 && CompareKeys(entry->key, key)) {
-            // Clear slot
-            entry->dist = -1;
-            entry->key.~K();
-            entry->val.~V();
-
-            count -= 1;
-            searchForKey = false;
-        } else if (!searchForKey) {
-            if (entry->dist > 0) {
-                memory[bucket - 1] = memory[bucket];
-                memory[bucket - 1].dist -= 1;
-            } else {
-                memory[bucket - 1].dist = -1;
-                return true;
-            }
-        }
+    RemoveBucket(bucket);
 
-        bucket += 1;
+    return true;
+}
 
-        if (bucket >= bucketCount) {
-            bucket = 0;
-        }
+template<typename K, typename V>
+inline void Dictionary<K, V>::RemoveBucket(int bucket) {
+    u64 bucketMask = bufferSize / sizeof(Entry) - 1;
+
+    memory[bucket].~Entry();
+    count -= 1;
+
+    // Shift the following entries back until one is in its ideal bucket or the bucket is empty
+    u64 next = ((u64)bucket + 1) & bucketMask;
+    while (memory[next].dist > 0) {
+        new (&memory[bucket]) Entry(std::move(memory[next]));
+        memory[bucket].dist -= 1;
+        memory[next].~Entry();
+
+        bucket = (int)next;
+        next = (next + 1) & bucketMask;
     }
 
-    return false;
+    MemorySet(&memory[bucket], sizeof(Entry), -1);
 }
 
 template<typename K, typename V>
@@ -441,7 +638,7 @@ inline void Dictionary<K, V>::Init() {
             bufferSize = INITIAL_LENGTH * sizeof(Entry);
         }
 
-        memory = (DictEntry<K, V>*)Alloc(bufferSize, allocator);
+        memory = (DictEntry<K, V>*)Alloc(bufferSize, allocator, alignof(Entry));
         MemorySet(memory, bufferSize, -1);
     }
 }
@@ -454,13 +651,14 @@ inline void Dictionary<K, V>::GrowAndRehash() {
 
     Entry* oldMemory = memory;
     bufferSize *= 2; // Keep power of 2
-    memory = (Entry*)Alloc(bufferSize, allocator);
+    memory = (Entry*)Alloc(bufferSize, allocator, alignof(Entry));
     MemorySet(memory, bufferSize, -1);
 
-    // Insert old keys
+    // Move the old entries over, their hashes are stored so no keys get hashed again
+    count = 0;
     for (int i = 0; i < oldBucketCount; i++) {
         if (oldMemory[i].dist >= 0) {
-            Insert(oldMemory[i].key, oldMemory[i].val);
+            InsertEntry(std::move(oldMemory[i]));
         }
     }
 
@@ -472,9 +670,7 @@ inline void Dictionary<K, V>::GrowAndRehash() {
         }
     }
 
-    if (allocator == Allocator::Persistent) {
-        Free(oldMemory);
-    }
+    Free(oldMemory, allocator);
 }
 
 template<typename K, typename V>
@@ -0,0 +1,624 @@
+#pragma once
+
+#include <new>
+#include <utility>
+#include <type_traits>
+
+#include "Pandora/Core/Types.h"
+#include "Pandora/Core/CPU.h"
+#include "Pandora/Core/Data/Memory.h"
+#include "Pandora/Core/Data/Hash.h"
+#include "Pandora/Core/Data/Allocator.h"
+#include "Pandora/Core/Data/Optional.h"
+
+#if defined(PD_X86)
+#include <emmintrin.h>
+#endif
+
+#if defined(PD_WINDOWS)
+#include <intrin.h>
+#endif
+
+namespace pd {
+
+/**
+ * \brief How many control bytes get probed at once.
+ */
+const int FLAT_MAP_GROUP_WIDTH = 16;
+
+/**
+ * \brief The control byte of an empty slot. Full slots store the low 7 bits of their hash.
+ */
+const byte FLAT_MAP_EMPTY = 0x80;
+
+/**
+ * \brief Counts the zero bits below the lowest set bit.
+ *
+ * \param mask The mask, must not be 0.
+ * \return The index of the lowest set bit.
+ */
+inline int FlatMapLowestBit(u32 mask) {
+#if defined(PD_WINDOWS)
+    unsigned long index = 0;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+template<typename K, typename V>
+struct FlatMapSlot {
+    K key;
+    V val;
+};
+
+/**
+ * \brief An open-addressing hash map with linear probing.
+ * Every slot has a control byte in a separate array holding 7 bits of the hash of the key,
+ * so a probe checks 16 slots at once without touching the keys and values.
+ * Removal shifts entries back instead of leaving tombstones.
+ * Pointers to values are invalidated by inserting and removing.
+ *
+ * \tparam K The key type, must be hashable with `DoHash()` and comparable with `==`.
+ * \tparam V The value type.
+ */
+template<typename K, typename V>
+class FlatMap {
+    using Slot = FlatMapSlot<K, V>;
+public:
+    FlatMap(Allocator allocator = Allocator::Persistent) : allocator(allocator) {}
+
+    FlatMap(const FlatMap<K, V>& other) : allocator(other.allocator) {
+        operator=(other);
+    }
+
+    FlatMap(FlatMap<K, V>&& other) : allocator(other.allocator) {
+        operator=(std::move(other));
+    }
+
+    virtual ~FlatMap();
+
+    /**
+     * \brief Destructs all entries and frees the memory.
+     * Gets called on destruction.
+     */
+    void Delete();
+
+    /**
+     * \brief Destructs all entries but keeps the memory.
+     */
+    void Clear();
+
+    /**
+     * \brief Makes sure `count` entries fit without growing.
+     *
+     * \param count How many entries need to fit.
+     */
+    void Reserve(int count);
+
+    /**
+     * \param key The key.
+     * \return Whether or not the key was found in the map.
+     */
+    bool Contains(const K& key) const;
+
+    /**
+     * \param key The key.
+     * \return The value associated with the key, nullptr if it wasn't found.
+     */
+    V* Find(const K& key) const;
+
+    /**
+     * \brief Finds the value associated with the key, inserts a default value if it wasn't found.
+     * Only probes once in both cases.
+     *
+     * \param key The key.
+     * \param inserted Set to whether or not the key got inserted, can be nullptr.
+     * \return The value.
+     */
+    V& FindOrInsert(const K& key, bool* inserted = nullptr);
+
+    /**
+     * \param key The key.
+     * \return The value associated with the key. Inserts it if it wasn't found.
+     */
+    V& Get(const K& key);
+
+    /**
+     * \brief Sets the value associated with the key.
+     *
+     * \param key The key.
+     * \param val The new value.
+     * \param insertIfNotFound Whether or not it should insert the key-value pair if it wasn't found.
+     * \return Whether or not the value got set.
+     */
+    bool Set(const K& key, const V& val, bool insertIfNotFound = true);
+
+    /**
+     * \brief Inserts a new key-value pair.
+     *
+     * \param key The key.
+     * \param val The value.
+     * \return Whether or not it got inserted, false if the key already exists.
+     */
+    bool Insert(const K& key, Optional<V> val = Optional<V>());
+
+    /**
+     * \brief Removes the specified key-value pair.
+     *
+     * \param key The key.
+     * \return Whether or not it got removed.
+     */
+    bool Remove(const K& key);
+
+    /**
+     * \return How many key-value pairs are in the map.
+     */
+    inline int Count() const;
+
+    /**
+     * \return How many slots the map has.
+     */
+    inline int Capacity() const;
+
+    /**
+     * \return The allocator used for the buffer.
+     */
+    inline Allocator Allocator() const;
+
+    V& operator[](const K& key);
+
+    FlatMap<K, V>& operator=(const FlatMap<K, V>& other);
+
+    FlatMap<K, V>& operator=(FlatMap<K, V>&& other);
+
+    template<typename T, typename U>
+    struct FlatMapIt {
+        FlatMapIt(const FlatMap<T, U>& parent, int i) : parent(parent), i(i) {
+            // Start at the first full slot
+            if (i < 0) {
+                operator++();
+            }
+        }
+
+        FlatMapSlot<T, U>& operator*() const {
+            return parent.slots[i];
+        }
+
+        void operator++() {
+            do {
+                i += 1;
+            } while (i < parent.capacity && parent.control[i] == FLAT_MAP_EMPTY);
+        }
+
+        bool operator==(const FlatMapIt<T, U>& other) const {
+            return i == other.i && &parent == &other.parent;
+        }
+
+        bool operator!=(const FlatMapIt<T, U>& other) const {
+            return !operator==(other);
+        }
+
+    private:
+        const FlatMap<T, U>& parent;
+        int i;
+    };
+
+    FlatMapIt<K, V> begin() const;
+    FlatMapIt<K, V> end() const;
+
+protected:
+
+    /**
+     * \param hash The hash.
+     * \return The control byte for the hash.
+     */
+    static inline byte ControlOf(u64 hash);
+
+    /**
+     * \return A bit mask of which of the 16 control bytes starting at `index` equal `value`.
+     */
+    inline u32 MatchGroup(int index, byte value) const;
+
+    /**
+     * \brief Sets the control byte of a slot, including its copy past the end.
+     */
+    inline void SetControl(int index, byte value);
+
+    /**
+     * \brief Finds the slot holding the key or the empty slot where it would go.
+     *
+     * \param key The key.
+     * \param hash The hash of the key.
+     * \param found Set to whether or not the key was found.
+     * \return The slot index.
+     */
+    int Probe(const K& key, u64 hash, bool& found) const;
+
+    /**
+     * \return The first empty slot in the probe sequence of the hash.
+     */
+    int FindEmpty(u64 hash) const;
+
+    /**
+     * \brief Reallocates the map with the new capacity and moves all entries over.
+     *
+     * \param newCapacity The new capacity, must be a power of 2.
+     */
+    void Rehash(int newCapacity);
+
+    /**
+     * \return Whether or not another entry fits under the maximum load.
+     */
+    inline bool HasRoomForInsert() const;
+
+    pd::Allocator allocator = Allocator::None;
+
+    // One allocation holds the slots followed by the control bytes
+    Slot* slots = nullptr;
+    byte* control = nullptr;
+
+    int capacity = 0;
+    int count = 0;
+};
+
+//
+// Implementation
+//
+
+// The map grows when it's more than 7/8th full
+const int FLAT_MAP_LOAD_NUMERATOR = 7;
+const int FLAT_MAP_LOAD_DENOMINATOR = 8;
+
+template<typename K, typename V>
+inline FlatMap<K, V>::~FlatMap() {
+    Delete();
+}
+
+template<typename K, typename V>
+inline void FlatMap<K, V>::Delete() {
+    if (!slots) return;
+
+    Clear();
+    Free(slots, allocator);
+
+    slots = nullptr;
+    control = nullptr;
+    capacity = 0;
+}
+
+template<typename K, typename V>
+inline void FlatMap<K, V>::Clear() {
+    if (!slots) return;
+
+    for (int i = 0; i < capacity; i++) {
+        if (control[i] != FLAT_MAP_EMPTY) {
+            slots[i].~Slot();
+        }
+    }
+
+    MemorySet(control, capacity + FLAT_MAP_GROUP_WIDTH, FLAT_MAP_EMPTY);
+    count = 0;
+}
+
+template<typename K, typename V>
+inline void FlatMap<K, V>::Reserve(int count) {
+    int newCapacity = (capacity > 0) ? capacity : FLAT_MAP_GROUP_WIDTH;
+
+    while ((i64)count * FLAT_MAP_LOAD_DENOMINATOR > (i64)newCapacity * FLAT_MAP_LOAD_NUMERATOR) {
+        newCapacity *= 2;
+    }
+
+    if (newCapacity != capacity) {
+        Rehash(newCapacity);
+    }
+}
+
+template<typename K, typename V>
+inline bool FlatMap<K, V>::Contains(const K& key) const {
+    return Find(key) != nullptr;
+}
+
+template<typename K, typename V>
+inline V* FlatMap<K, V>::Find(const K& key) const {
+    if (count == 0) return nullptr;
+
+    bool found = false;
+    int index = Probe(key, DoHash(key), found);
+
+    return (found) ? &slots[index].val : nullptr;
+}
+
+template<typename K, typename V>
+inline V& FlatMap<K, V>::FindOrInsert(const K& key, bool* inserted) {
+    u64 hash = DoHash(key);
+
+    bool found = false;
+    int index = (capacity > 0) ? Probe(key, hash, found) : -1;
+
+    if (inserted) {
+        *inserted = !found;
+    }
+
+    if (found) {
+        return slots[index].val;
+    }
+
+    // Without tombstones the probe already ended on the empty slot the key goes in,
+    // we only need to search again if the map had to grow
+    if (!HasRoomForInsert()) {
+        Rehash((capacity > 0) ? capacity * 2 : FLAT_MAP_GROUP_WIDTH);
+        index = FindEmpty(hash);
+    }
+
+    new (&slots[index]) Slot{ key, V() };
+    SetControl(index, ControlOf(hash));
+    count += 1;
+
+    return slots[index].val;
+}
+
+template<typename K, typename V>
+inline V& FlatMap<K, V>::Get(const K& key) {
+    return FindOrInsert(key);
+}
+
+template<typename K, typename V>
+inline bool FlatMap<K, V>::Set(const K& key, const V& val, bool insertIfNotFound) {
+    if (insertIfNotFound) {
+        FindOrInsert(key) = val;
+        return true;
+    }
+
+    V* existing = Find(key);
+    if (existing) {
+        *existing = val;
+    }
+
+    return existing != nullptr;
+}
+
+template<typename K, typename V>
+inline bool FlatMap<K, V>::Insert(const K& key, Optional<V> val) {
+    bool inserted = false;
+    V& slot = FindOrInsert(key, &inserted);
+
+    if (inserted && val) {
+        slot = std::move(*val);
+    }
+
+    return inserted;
+}
+
+template<typename K, typename V>
+inline bool FlatMap<K, V>::Remove(const K& key) {
+    if (count == 0) return false;
+
+    bool found = false;
+    int hole = Probe(key, DoHash(key), found);
+
+    if (!found) return false;
+
+    slots[hole].~Slot();
+    SetControl(hole, FLAT_MAP_EMPTY);
+    count -= 1;
+
+    // Move entries after the hole back if the hole is between their ideal slot and where they are,
+    // otherwise probes would stop at the hole before reaching them
+    int mask = capacity - 1;
+    int index = hole;
+
+    while (true) {
+        index = (index + 1) & mask;
+
+        if (control[index] == FLAT_MAP_EMPTY) break;
+
+        int ideal = (int)((DoHash(slots[index].key) >> 7) & (u64)mask);
+
+        bool reachable = (hole <= index) ? (hole < ideal && ideal <= index)
+                                         : (hole < ideal || ideal <= index);
+        if (reachable) continue;
+
+        new (&slots[hole]) Slot(std::move(slots[index]));
+        SetControl(hole, control[index]);
+
+        slots[index].~Slot();
+        SetControl(index, FLAT_MAP_EMPTY);
+
+        hole = index;
+    }
+
+    return true;
+}
+
+template<typename K, typename V>
+inline int FlatMap<K, V>::Count() const {
+    return count;
+}
+
+template<typename K, typename V>
+inline int FlatMap<K, V>::Capacity() const {
+    return capacity;
+}
+
+template<typename K, typename V>
+inline Allocator FlatMap<K, V>::Allocator() const {
+    return allocator;
+}
+
+template<typename K, typename V>
+inline V& FlatMap<K, V>::operator[](const K& key) {
+    return FindOrInsert(key);
+}
+
+template<typename K, typename V>
+inline FlatMap<K, V>& FlatMap<K, V>::operator=(const FlatMap<K, V>& other) {
+    if (&other == this) return *this;
+
+    Clear();
+    Reserve(other.Count());
+
+    for (auto& slot : other) {
+        Insert(slot.key, slot.val);
+    }
+
+    return *this;
+}
+
+template<typename K, typename V>
+inline FlatMap<K, V>& FlatMap<K, V>::operator=(FlatMap<K, V>&& other) {
+    if (&other == this) return *this;
+
+    if (allocator != other.allocator) {
+        return operator=((const FlatMap<K, V>&)other);
+    }
+
+    Delete();
+
+    slots = other.slots;
+    control = other.control;
+    capacity = other.capacity;
+    count = other.count;
+
+    other.slots = nullptr;
+    other.control = nullptr;
+    other.capacity = 0;
+    other.count = 0;
+
+    return *this;
+}
+
+template<typename K, typename V>
+inline typename FlatMap<K, V>::template FlatMapIt<K, V> FlatMap<K, V>::begin() const {
+    return FlatMapIt<K, V>(*this, -1);
+}
+
+template<typename K, typename V>
+inline typename FlatMap<K, V>::template FlatMapIt<K, V> FlatMap<K, V>::end() const {
+    return FlatMapIt<K, V>(*this, capacity);
+}
+
+template<typename K, typename V>
+inline byte FlatMap<K, V>::ControlOf(u64 hash) {
+    // The slot index uses the bits above these
+    return (byte)(hash & 0x7F);
+}
+
+template<typename K, typename V>
+inline u32 FlatMap<K, V>::MatchGroup(int index, byte value) const {
+#if defined(PD_X86)
+    __m128i group = _mm_loadu_si128((const __m128i*)(control + index));
+    return (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)value)));
+#else
+    u32 mask = 0;
+    for (int i = 0; i < FLAT_MAP_GROUP_WIDTH; i++) {
+        mask |= (u32)(control[index + i] == value) << i;
+    }
+
+    return mask;
+#endif
+}
+
+template<typename K, typename V>
+inline void FlatMap<K, V>::SetControl(int index, byte value) {
+    control[index] = value;
+
+    // The first group is copied past the end so groups can be loaded without wrapping around
+    if (index < FLAT_MAP_GROUP_WIDTH) {
+        control[capacity + index] = value;
+    }
+}
+
+template<typename K, typename V>
+inline int FlatMap<K, V>::Probe(const K& key, u64 hash, bool& found) const {
+    int mask = capacity - 1;
+    int index = (int)((hash >> 7) & (u64)mask);
+    byte h2 = ControlOf(hash);
+
+    while (true) {
+        u32 matches = MatchGroup(index, h2);
+        u32 empties = MatchGroup(index, FLAT_MAP_EMPTY);
+
+        // Keys are never stored past an empty slot in their probe sequence
+        if (empties) {
+            matches &= (empties & (0 - empties)) - 1;
+        }
+
+        while (matches) {
+            int slot = (index + FlatMapLowestBit(matches)) & mask;
+
+            if (slots[slot].key == key) {
+                found = true;
+                return slot;
+            }
+
+            matches &= matches - 1;
+        }
+
+        if (empties) {
+            found = false;
+            return (index + FlatMapLowestBit(empties)) & mask;
+        }
+
+        index = (index + FLAT_MAP_GROUP_WIDTH) & mask;
+    }
+}
+
+template<typename K, typename V>
+inline int FlatMap<K, V>::FindEmpty(u64 hash) const {
+    int mask = capacity - 1;
+    int index = (int)((hash >> 7) & (u64)mask);
+
+    while (true) {
+        u32 empties = MatchGroup(index, FLAT_MAP_EMPTY);
+
+        if (empties) {
+            return (index + FlatMapLowestBit(empties)) & mask;
+        }
+
+        index = (index + FLAT_MAP_GROUP_WIDTH) & mask;
+    }
+}
+
+template<typename K, typename V>
+inline void FlatMap<K, V>::Rehash(int newCapacity) {
+    PD_ASSERT_D((newCapacity & (newCapacity - 1)) == 0 && newCapacity >= FLAT_MAP_GROUP_WIDTH,
+                "capacity must be a power of 2 of at least %d, given: %d", FLAT_MAP_GROUP_WIDTH, newCapacity);
+
+    Slot* oldSlots = slots;
+    byte* oldControl = control;
+    int oldCapacity = capacity;
+
+    u64 slotsSize = sizeof(Slot) * (u64)newCapacity;
+    u64 alignment = (alignof(Slot) > DEFAULT_ALIGNMENT) ? alignof(Slot) : DEFAULT_ALIGNMENT;
+
+    slots = (Slot*)Alloc(slotsSize + newCapacity + FLAT_MAP_GROUP_WIDTH, allocator, alignment);
+    control = (byte*)slots + slotsSize;
+    capacity = newCapacity;
+
+    MemorySet(control, newCapacity + FLAT_MAP_GROUP_WIDTH, FLAT_MAP_EMPTY);
+
+    for (int i = 0; i < oldCapacity; i++) {
+        if (oldControl[i] == FLAT_MAP_EMPTY) continue;
+
+        u64 hash = DoHash(oldSlots[i].key);
+        int index = FindEmpty(hash);
+
+        new (&slots[index]) Slot(std::move(oldSlots[i]));
+        SetControl(index, ControlOf(hash));
+
+        oldSlots[i].~Slot();
+    }
+
+    if (oldSlots) {
+        Free(oldSlots, allocator);
+    }
+}
+
+template<typename K, typename V>
+inline bool FlatMap<K, V>::HasRoomForInsert() const {
+    return (i64)(count + 1) * FLAT_MAP_LOAD_DENOMINATOR <= (i64)capacity * FLAT_MAP_LOAD_NUMERATOR;
+}
+
+}
@@ -0,0 +1,60 @@
+#include "Hash.h"
+
+#include "Pandora/Core/CPU.h"
+
+#if defined(PD_X86)
+#include "Pandora/Libs/MeowHash/meow_hash_x64_aesni.h"
+#endif
+
+namespace pd {
+
+typedef u64 HashBytesFunction(const void* data, u64 size);
+
+// Buffers up to this size are cheaper to hash a word at a time than to set up MeowHash for
+const u64 HASH_SMALL_SIZE = 32;
+
+// Used when the CPU has no AES-NI, the same hash strings use
+inline u64 HashBytesPortable(const void* data, u64 size) {
+    return HashString((const char*)data, size);
+}
+
+#if defined(PD_X86)
+
+inline u64 HashBytesMeow(const void* data, u64 size) {
+    if (size <= HASH_SMALL_SIZE) {
+        return HashBytesPortable(data, size);
+    }
+
+    return MeowU64From(MeowHash(MeowDefaultSeed, size, (void*)data), 0);
+}
+
+#endif
+
+//
+// Dispatch
+//
+
+// Starts out as a resolver, same as the memory functions
+
+inline u64 ResolveHashBytes(const void* data, u64 size);
+
+// @GLOBAL
+static HashBytesFunction* hashBytesFunction = ResolveHashBytes;
+
+inline u64 ResolveHashBytes(const void* data, u64 size) {
+    hashBytesFunction = HashBytesPortable;
+
+#if defined(PD_X86)
+    if (GetCPUFeatures().aes) {
+        hashBytesFunction = HashBytesMeow;
+    }
+#endif
+
+    return hashBytesFunction(data, size);
+}
+
+u64 HashBytes(const void* data, u64 size) {
+    return hashBytesFunction(data, size);
+}
+
+}
@@ -1,27 +1,170 @@
 #pragma once
 
+#include <type_traits>
+
 #include "Pandora/Core/Types.h"
 #include "Pandora/Core/Data/String.h"
-
-#include "Pandora/Libs/MeowHash/meow_hash_x64_aesni.h"
+#include "Pandora/Core/Data/Pair.h"
 
 namespace pd {
 
 /**
- * \brief Hashes the data.
- * 
+ * \brief Hashes a buffer.
+ * Uses MeowHash on CPUs with AES-NI and a portable hash otherwise,
+ * so hashes are only stable within the same process.
+ *
+ * \param data A pointer to the buffer.
+ * \param size The size of the buffer in bytes.
+ * \return The hash.
+ */
+u64 HashBytes(const void* data, u64 size);
+
+/**
+ * \brief Scrambles the bits of a 64-bit value, every input bit affects every output bit.
+ *
+ * \param value The value.
+ * \return The mixed value.
+ */
+constexpr u64 HashMix(u64 value) {
+    // The splitmix64 finalizer
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+/**
+ * \brief Combines two hashes, the order matters.
+ *
+ * \param seed The hash so far.
+ * \param hash The hash to add.
+ * \return The combined hash.
+ */
+constexpr u64 HashCombine(u64 seed, u64 hash) {
+    return HashMix(seed ^ (hash + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2)));
+}
+
+const u64 HASH_PRIME_1 = 0x9E3779B185EBCA87ull;
+const u64 HASH_PRIME_2 = 0xC2B2AE3D27D4EB4Full;
+const u64 HASH_PRIME_3 = 0x27D4EB2F165667C5ull;
+
+constexpr u64 HashRotateLeft(u64 value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+constexpr u64 HashRound(u64 hash, u64 word) {
+    hash ^= HashRotateLeft(word * HASH_PRIME_2, 31) * HASH_PRIME_1;
+    return HashRotateLeft(hash, 27) * HASH_PRIME_1 + HASH_PRIME_3;
+}
+
+/**
+ * \brief Reads 8 bytes as a little-endian word.
+ * Written out so compilers turn it into a single load.
+ */
+constexpr u64 HashLoadWord(const char* bytes) {
+    return (u64)(u8)bytes[0]         | (u64)(u8)bytes[1] << 8  |
+           (u64)(u8)bytes[2] << 16   | (u64)(u8)bytes[3] << 24 |
+           (u64)(u8)bytes[4] << 32   | (u64)(u8)bytes[5] << 40 |
+           (u64)(u8)bytes[6] << 48   | (u64)(u8)bytes[7] << 56;
+}
+
+/**
+ * \brief Reads less than 8 bytes as a little-endian word, the missing bytes are zero.
+ */
+constexpr u64 HashLoadTail(const char* bytes, u64 size) {
+    u64 word = 0;
+
+    for (u64 i = 0; i < size; i++) {
+        word |= (u64)(u8)bytes[i] << (i * 8);
+    }
+
+    return word;
+}
+
+/**
+ * \brief Hashes text 8 bytes at a time like xxHash64 does with one lane.
+ * This is the hash of every string type, `DoHash()` of a `String` or `StringView` and
+ * `"text"_hash` give the same value, so the literal can be used to look up string keys.
+ *
+ * \param text The text.
+ * \param size The size of the text in bytes, without a null terminator.
+ * \return The hash.
+ */
+constexpr u64 HashString(const char* text, u64 size) {
+    u64 hash = HASH_PRIME_3 ^ (size * HASH_PRIME_1);
+
+    while (size >= 8) {
+        hash = HashRound(hash, HashLoadWord(text));
+
+        text += 8;
+        size -= 8;
+    }
+
+    // The length is already mixed in so zero padding the tail can't cause collisions
+    if (size > 0) {
+        hash = HashRound(hash, HashLoadTail(text, size));
+    }
+
+    return HashMix(hash);
+}
+
+/**
+ * \brief Hashes a string literal at compile time, e.g. `"Shaders/Sprite"_hash`.
+ * Gives the same hash as `DoHash()` of the same text.
+ */
+constexpr u64 operator""_hash(const char* text, size_t size) {
+    return HashString(text, size);
+}
+
+/**
+ * \brief Picks how values of type `T` get hashed.
+ * By default it hashes the bytes of the object, specialize it for types
+ * that hold pointers or padding, `HashFields()` is useful for that.
+ *
+ * \tparam T The type to hash.
+ */
+template<typename T, typename Enable = void>
+struct Hasher {
+    static u64 Hash(const T& data) {
+        return HashBytes(&data, sizeof(T));
+    }
+};
+
+/**
+ * \brief Integers and enums only need their bits mixed.
+ */
+template<typename T>
+struct Hasher<T, typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type> {
+    static u64 Hash(const T& data) {
+        return HashMix((u64)data);
+    }
+};
+
+/**
+ * \brief Pointers hash the address, not what they point to.
+ */
+template<typename T>
+struct Hasher<T*> {
+    static u64 Hash(T* data) {
+        return HashMix((u64)(uintptr_t)data);
+    }
+};
+
+/**
+ * \brief Hashes the object.
+ *
  * \tparam T The object type.
- * \param data A pointer to the object to hash.
+ * \param data The object to hash.
  * \return The hash.
  */
 template<typename T>
 inline u64 DoHash(const T& data) {
-    return MeowU64From(MeowHash(MeowDefaultSeed, sizeof(T), (void*)&data), 0);
+    return Hasher<T>::Hash(data);
 }
 
 /**
  * \brief Hashes a buffer.
- * 
+ *
  * \tparam T The type of the buffer.
  * \param buffer A pointer to the buffer.
  * \param bufferSize The size of the buffer in bytes.
@@ -29,12 +172,12 @@ inline u64 DoHash(const T& data) {
  */
 template<typename T>
 inline u64 DoHash(T* buffer, u64 bufferSize) {
-    return MeowU64From(MeowHash(MeowDefaultSeed, bufferSize, (void*)buffer), 0);
+    return HashBytes(buffer, bufferSize);
 }
 
 /**
  * \brief Hashes the slice.
- * 
+ *
  * \tparam T The type of the slice.
  * \param data The slice.
  * \return The hash.
@@ -43,42 +186,67 @@ template<typename T>
 inline u64 DoHash(Slice<T> data) {
     return DoHash(data.Data(), data.SizeInBytes());
 }
+
+/**
+ * \brief Hashes every field and combines them, so padding bytes are never hashed.
+ *
+ * \param field The first field.
+ * \param fields The other fields.
+ * \return The combined hash.
+ */
+template<typename T>
+inline u64 HashFields(const T& field) {
+    return DoHash(field);
+}
+
+template<typename T, typename... Args>
+inline u64 HashFields(const T& field, const Args&... fields) {
+    return HashCombine(DoHash(field), HashFields(fields...));
+}
+
+template<typename K, typename V>
+struct Hasher<Pair<K, V>> {
+    static u64 Hash(const Pair<K, V>& data) {
+        return HashFields(data.key, data.val);
+    }
+};
+
 //
 // String hashing
 //
 
 /**
- * \brief Hashes the string.
- * 
- * \param data The string.
- * \return The hash.
+ * \brief Hashes the string with `HashString()`.
+ * The null terminator is left out so it hashes the same as a `StringView` of the same text.
  */
 template<>
-inline u64 DoHash(const String& data) {
-    return MeowU64From(MeowHash(MeowDefaultSeed, data.SizeInBytes(), data.Data()), 0);
-}
+struct Hasher<String> {
+    static u64 Hash(const String& data) {
+        u64 size = data.SizeInBytes();
+        return HashString((const char*)data.Data(), (size > 0) ? size - 1 : 0);
+    }
+};
 
 /**
- * \brief Hashes the bounded string.
- * 
+ * \brief Hashes the bounded string the same as a `String`.
+ *
  * \tparam cap The capacity of the string.
- * \param data The string.
- * \return The hash.
  */
 template<int cap>
-inline u64 DoHash(const BoundedString<cap>& data) {
-    return DoHash<String>(data);
-}
+struct Hasher<BoundedString<cap>> {
+    static u64 Hash(const BoundedString<cap>& data) {
+        return Hasher<String>::Hash(data);
+    }
+};
 
 /**
- * \brief Hashes the string view.
- * 
- * \param data The view.
- * \return The hash.
+ * \brief Hashes the string view with `HashString()`.
  */
 template<>
-inline u64 DoHash(const StringView& data) {
-    return MeowU64From(MeowHash(MeowDefaultSeed, data.SizeInBytes(), (void*)data.Data()), 0);
-}
+struct Hasher<StringView> {
+    static u64 Hash(const StringView& data) {
+        return HashString((const char*)data.Data(), data.SizeInBytes());
+    }
+};
 
 }
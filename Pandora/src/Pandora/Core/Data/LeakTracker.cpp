@@ -0,0 +1,381 @@
+#include "LeakTracker.h"
+
+#include <malloc.h>
+#include <stdlib.h>
+#include <atomic>
+
+#if defined(PD_WINDOWS)
+#include <Windows.h>
+#elif defined(PD_LINUX)
+#include <execinfo.h>
+#endif
+
+#include "Pandora/Core/IO/Console.h"
+
+namespace pd {
+
+// Live allocations are kept in a hash table that is split up in shards with
+// their own lock so threads rarely wait on each other. The records are
+// allocated with malloc so the tracker never calls back into the allocator.
+
+const int LEAK_SHARD_COUNT = 64;
+const int LEAK_INITIAL_BUCKETS = 256;
+const int LEAK_RECORDS_PER_BLOCK = 1024;
+
+// How many of the biggest call sites get printed by the report
+const int LEAK_REPORT_MAX_SITES = 32;
+
+struct LeakRecord {
+    void* ptr;
+    u64 size;
+    AllocationSite site;
+
+    void* frames[LEAK_BACKTRACE_DEPTH];
+    int frameCount;
+
+    LeakRecord* next;
+};
+
+struct LeakShard {
+    LeakRecord** buckets = nullptr;
+    u64 bucketCount = 0;
+    u64 recordCount = 0;
+
+    // Unused records
+    LeakRecord* freeRecords = nullptr;
+
+    // All blocks of records, the first record of every block links to the next block
+    LeakRecord* blocks = nullptr;
+
+    std::atomic_flag lock = ATOMIC_FLAG_INIT;
+};
+
+struct LeakShardLock {
+    LeakShardLock(LeakShard& shard) : shard(shard) {
+        while (shard.lock.test_and_set(std::memory_order_acquire)) {}
+    }
+
+    ~LeakShardLock() {
+        shard.lock.clear(std::memory_order_release);
+    }
+
+private:
+    LeakShard& shard;
+};
+
+// @GLOBAL
+static LeakShard leakShards[LEAK_SHARD_COUNT];
+
+// @GLOBAL
+static std::atomic<bool> leakTracking{ false };
+
+// @GLOBAL
+static std::atomic<bool> leakBacktraces{ false };
+
+// @GLOBAL
+static thread_local AllocationSite currentSite;
+
+// Set while the tracker itself is working so its own allocations are ignored
+// @GLOBAL
+static thread_local bool insideTracker = false;
+
+inline u64 HashPointer(void* ptr) {
+    // Allocations are at least 16-byte aligned so the low bits are always zero
+    return ((u64)ptr >> 4) * 0x9E3779B97F4A7C15ull;
+}
+
+inline LeakShard& ShardOf(u64 hash) {
+    return leakShards[hash >> 58];
+}
+
+inline u64 BucketOf(u64 hash, u64 bucketCount) {
+    // The low bits of the product only depend on the low bits of the pointer
+    return (hash >> 24) & (bucketCount - 1);
+}
+
+inline bool GrowShard(LeakShard& shard) {
+    u64 newCount = (shard.bucketCount == 0) ? LEAK_INITIAL_BUCKETS : shard.bucketCount * 2;
+
+    LeakRecord** newBuckets = (LeakRecord**)calloc(newCount, sizeof(LeakRecord*));
+    if (!newBuckets) return false;
+
+    for (u64 i = 0; i < shard.bucketCount; i++) {
+        LeakRecord* record = shard.buckets[i];
+
+        while (record) {
+            LeakRecord* next = record->next;
+
+            u64 index = BucketOf(HashPointer(record->ptr), newCount);
+            record->next = newBuckets[index];
+            newBuckets[index] = record;
+
+            record = next;
+        }
+    }
+
+    free(shard.buckets);
+    shard.buckets = newBuckets;
+    shard.bucketCount = newCount;
+
+    return true;
+}
+
+inline LeakRecord* NewRecord(LeakShard& shard) {
+    if (!shard.freeRecords) {
+        LeakRecord* block = (LeakRecord*)malloc(sizeof(LeakRecord) * LEAK_RECORDS_PER_BLOCK);
+        if (!block) return nullptr;
+
+        block[0].next = shard.blocks;
+        shard.blocks = block;
+
+        for (int i = LEAK_RECORDS_PER_BLOCK - 1; i > 0; i--) {
+            block[i].next = shard.freeRecords;
+            shard.freeRecords = &block[i];
+        }
+    }
+
+    LeakRecord* record = shard.freeRecords;
+    shard.freeRecords = record->next;
+
+    return record;
+}
+
+inline void ClearShard(LeakShard& shard) {
+    LeakShardLock lock(shard);
+
+    LeakRecord* block = shard.blocks;
+    while (block) {
+        LeakRecord* next = block[0].next;
+        free(block);
+        block = next;
+    }
+
+    free(shard.buckets);
+
+    shard.buckets = nullptr;
+    shard.bucketCount = 0;
+    shard.recordCount = 0;
+    shard.freeRecords = nullptr;
+    shard.blocks = nullptr;
+}
+
+inline int CaptureBacktrace(void** frames) {
+    // Skip `TrackAllocation()` and the allocator entry point, this function usually gets inlined
+    const int SKIPPED_FRAMES = 2;
+
+#if defined(PD_WINDOWS)
+    return (int)CaptureStackBackTrace(SKIPPED_FRAMES, LEAK_BACKTRACE_DEPTH, frames, nullptr);
+#elif defined(PD_LINUX)
+    void* buffer[LEAK_BACKTRACE_DEPTH + SKIPPED_FRAMES];
+    int count = backtrace(buffer, LEAK_BACKTRACE_DEPTH + SKIPPED_FRAMES) - SKIPPED_FRAMES;
+
+    for (int i = 0; i < count; i++) {
+        frames[i] = buffer[i + SKIPPED_FRAMES];
+    }
+
+    return (count > 0) ? count : 0;
+#else
+    return 0;
+#endif
+}
+
+void EnableLeakTracking(bool captureBacktraces) {
+    leakBacktraces = captureBacktraces;
+    leakTracking = true;
+}
+
+void DisableLeakTracking() {
+    leakTracking = false;
+
+    for (int i = 0; i < LEAK_SHARD_COUNT; i++) {
+        ClearShard(leakShards[i]);
+    }
+}
+
+bool IsLeakTracking() {
+    return leakTracking.load(std::memory_order_relaxed);
+}
+
+void SetAllocationSite(AllocationSite site) {
+    currentSite = site;
+}
+
+AllocationSite GetAllocationSite() {
+    return currentSite;
+}
+
+void TrackAllocation(void* ptr, u64 size) {
+    if (!ptr || insideTracker || !IsLeakTracking()) return;
+
+    u64 hash = HashPointer(ptr);
+    LeakShard& shard = ShardOf(hash);
+
+    void* frames[LEAK_BACKTRACE_DEPTH];
+    int frameCount = (leakBacktraces.load(std::memory_order_relaxed)) ? CaptureBacktrace(frames) : 0;
+
+    LeakShardLock lock(shard);
+
+    // Keep the chains short, if growing fails we keep using the old buckets
+    if (shard.recordCount >= shard.bucketCount && !GrowShard(shard) && shard.bucketCount == 0) return;
+
+    LeakRecord* record = NewRecord(shard);
+    if (!record) return;
+
+    record->ptr = ptr;
+    record->size = size;
+    record->site = currentSite;
+    record->frameCount = frameCount;
+
+    for (int i = 0; i < frameCount; i++) {
+        record->frames[i] = frames[i];
+    }
+
+    u64 index = BucketOf(hash, shard.bucketCount);
+    record->next = shard.buckets[index];
+    shard.buckets[index] = record;
+    shard.recordCount += 1;
+}
+
+void UntrackAllocation(void* ptr) {
+    if (!ptr || insideTracker || !IsLeakTracking()) return;
+
+    u64 hash = HashPointer(ptr);
+    LeakShard& shard = ShardOf(hash);
+
+    LeakShardLock lock(shard);
+    if (shard.bucketCount == 0) return;
+
+    // Allocations made before tracking was enabled just won't be found
+    LeakRecord** link = &shard.buckets[BucketOf(hash, shard.bucketCount)];
+    while (*link) {
+        LeakRecord* record = *link;
+
+        if (record->ptr == ptr) {
+            *link = record->next;
+
+            record->next = shard.freeRecords;
+            shard.freeRecords = record;
+            shard.recordCount -= 1;
+            return;
+        }
+
+        link = &record->next;
+    }
+}
+
+struct LeakGroup {
+    LeakRecord* record;
+    u64 bytes;
+    u64 count;
+};
+
+inline int CompareSites(const LeakRecord* a, const LeakRecord* b) {
+    if (a->site.file != b->site.file) return (a->site.file < b->site.file) ? -1 : 1;
+    if (a->site.line != b->site.line) return (a->site.line < b->site.line) ? -1 : 1;
+    if (a->site.function != b->site.function) return (a->site.function < b->site.function) ? -1 : 1;
+    if (a->frameCount != b->frameCount) return (a->frameCount < b->frameCount) ? -1 : 1;
+
+    for (int i = 0; i < a->frameCount; i++) {
+        if (a->frames[i] != b->frames[i]) return (a->frames[i] < b->frames[i]) ? -1 : 1;
+    }
+
+    return 0;
+}
+
+u64 ReportLeaks() {
+    insideTracker = true;
+
+    // Copy the records so we don't hold the locks while printing
+    u64 recordCount = 0;
+    for (int i = 0; i < LEAK_SHARD_COUNT; i++) {
+        LeakShardLock lock(leakShards[i]);
+        recordCount += leakShards[i].recordCount;
+    }
+
+    LeakRecord* records = (recordCount > 0) ? (LeakRecord*)malloc(sizeof(LeakRecord) * recordCount) : nullptr;
+    u64 copied = 0;
+
+    for (int i = 0; i < LEAK_SHARD_COUNT && records; i++) {
+        LeakShard& shard = leakShards[i];
+        LeakShardLock lock(shard);
+
+        for (u64 j = 0; j < shard.bucketCount; j++) {
+            for (LeakRecord* record = shard.buckets[j]; record && copied < recordCount; record = record->next) {
+                records[copied++] = *record;
+            }
+        }
+    }
+
+    if (copied == 0) {
+        free(records);
+        insideTracker = false;
+        return 0;
+    }
+
+    qsort(records, copied, sizeof(LeakRecord), [](const void* a, const void* b) {
+        return CompareSites((const LeakRecord*)a, (const LeakRecord*)b);
+    });
+
+    // Group the sorted records by call site
+    LeakGroup* groups = (LeakGroup*)malloc(sizeof(LeakGroup) * copied);
+    u64 groupCount = 0;
+    u64 totalBytes = 0;
+
+    for (u64 i = 0; i < copied; i++) {
+        if (groupCount == 0 || CompareSites(groups[groupCount - 1].record, &records[i]) != 0) {
+            groups[groupCount].record = &records[i];
+            groups[groupCount].bytes = 0;
+            groups[groupCount].count = 0;
+            groupCount += 1;
+        }
+
+        groups[groupCount - 1].bytes += records[i].size;
+        groups[groupCount - 1].count += 1;
+        totalBytes += records[i].size;
+    }
+
+    qsort(groups, groupCount, sizeof(LeakGroup), [](const void* a, const void* b) {
+        u64 bytesA = ((const LeakGroup*)a)->bytes;
+        u64 bytesB = ((const LeakGroup*)b)->bytes;
+        return (bytesA > bytesB) ? -1 : (bytesA < bytesB) ? 1 : 0;
+    });
+
+    console.Log("[{}Leak Report{}] {} bytes in {} allocations from {} call sites are still alive\n",
+                ConColor::Red, ConColor::White, totalBytes, copied, groupCount);
+
+    for (u64 i = 0; i < groupCount && i < LEAK_REPORT_MAX_SITES; i++) {
+        LeakRecord* record = groups[i].record;
+
+        const char* file = (record->site.file) ? record->site.file : "<unknown>";
+        const char* function = (record->site.function) ? record->site.function : "<unknown>";
+
+        console.Log("    {} bytes in {} allocations at {}:{} ({})\n",
+                    groups[i].bytes, groups[i].count, file, record->site.line, function);
+
+#if defined(PD_LINUX)
+        char** symbols = backtrace_symbols(record->frames, record->frameCount);
+
+        for (int j = 0; symbols && j < record->frameCount; j++) {
+            console.Log("        {}\n", (const char*)symbols[j]);
+        }
+
+        free(symbols);
+#else
+        for (int j = 0; j < record->frameCount; j++) {
+            console.Log("        {X#}\n", (u64)record->frames[j]);
+        }
+#endif
+    }
+
+    if (groupCount > LEAK_REPORT_MAX_SITES) {
+        console.Log("    ... and {} more call sites\n", groupCount - LEAK_REPORT_MAX_SITES);
+    }
+
+    free(groups);
+    free(records);
+
+    insideTracker = false;
+    return totalBytes;
+}
+
+}
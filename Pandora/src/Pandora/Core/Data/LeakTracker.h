@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Pandora/Core/Types.h"
+#include "Pandora/Core/Assert.h"
+
+namespace pd {
+
+/**
+ * \brief How many stack frames get captured per allocation when backtraces are enabled.
+ */
+const int LEAK_BACKTRACE_DEPTH = 8;
+
+/**
+ * \brief Where an allocation was made.
+ * The file is empty on release builds.
+ */
+struct AllocationSite {
+    const char* file = nullptr;
+    const char* function = nullptr;
+    int line = 0;
+};
+
+/**
+ * \brief Starts recording every live persistent and pool allocation.
+ * Allocations made before tracking started are not reported.
+ *
+ * \param captureBacktraces Whether or not to capture a backtrace of every allocation.
+ */
+void EnableLeakTracking(bool captureBacktraces = false);
+
+/**
+ * \brief Stops recording allocations and forgets all recorded ones.
+ */
+void DisableLeakTracking();
+
+/**
+ * \return Whether or not allocations are being recorded.
+ */
+bool IsLeakTracking();
+
+/**
+ * \brief Sets the call site the calling thread's allocations get recorded with.
+ *
+ * \param site The call site.
+ */
+void SetAllocationSite(AllocationSite site);
+
+/**
+ * \return The call site of the calling thread.
+ */
+AllocationSite GetAllocationSite();
+
+/**
+ * \brief Gets called by the allocator, records a live allocation.
+ *
+ * \param ptr The allocated buffer.
+ * \param size The allocation size in bytes.
+ */
+void TrackAllocation(void* ptr, u64 size);
+
+/**
+ * \brief Gets called by the allocator, forgets a live allocation.
+ *
+ * \param ptr The freed buffer.
+ */
+void UntrackAllocation(void* ptr);
+
+/**
+ * \brief Prints all recorded allocations that are still alive, grouped by call site.
+ *
+ * \return How many bytes are still alive.
+ */
+u64 ReportLeaks();
+
+/**
+ * \brief Sets the call site on construction and restores the previous one on destruction.
+ */
+class ScopedAllocationSite {
+public:
+    ScopedAllocationSite(AllocationSite site) : previous(GetAllocationSite()) {
+        SetAllocationSite(site);
+    }
+
+    ~ScopedAllocationSite() {
+        SetAllocationSite(previous);
+    }
+
+private:
+    AllocationSite previous;
+};
+
+}
+
+/**
+ * \brief Records the allocations made by the expression with the current file and line.
+ * E.g. `PD_TRACKED(pd::New<Foo>())` or `PD_TRACKED(pd::Alloc(64))`.
+ */
+#define PD_TRACKED(expr) (pd::ScopedAllocationSite({ PD_FILE, PD_FUNCTION, PD_LINE }), (expr))
+
+/**
+ * \brief Records all allocations in the current scope with the current file and line.
+ */
+#define PD_ALLOCATION_SITE() pd::ScopedAllocationSite pdAllocationSite({ PD_FILE, PD_FUNCTION, PD_LINE })
@@ -2,82 +2,483 @@
 
 #include <memory.h>
 
+#include "Pandora/Core/CPU.h"
 #include "Pandora/Core/Math/Math.h"
-#include "Pandora/Core/Data/Allocator.h"
+
+#if defined(PD_X86)
+#include <immintrin.h>
+#endif
+
+// Every function loads the bytes it is about to overwrite before storing them,
+// that's what lets copies and moves share the same code. Unaligned loads and
+// stores are as fast as aligned ones on everything that has SSE2, the tails are
+// handled by one last store that overlaps the previous one.
 
 namespace pd {
 
-inline void MemoryCopy(const void* destination, u64 destinationSize, const void* source, u64 copySize, bool useIntermediateBuffer) {
-    MemoryCopy(destination, source, Min(destinationSize, copySize), useIntermediateBuffer);
+// Copies bigger than this bypass the cache so they don't evict everything else
+const u64 MEMORY_STREAMING_THRESHOLD = 4 * 1024 * 1024;
+
+typedef void MemoryMoveFunction(byte* destination, const byte* source, u64 size);
+typedef void MemorySetFunction(byte* destination, u64 size, byte value);
+typedef bool MemoryCompareFunction(const byte* a, const byte* b, u64 size);
+
+template<typename T>
+inline T LoadUnaligned(const byte* ptr) {
+    // Compilers turn fixed-size copies into a single move
+    T t;
+    memcpy(&t, ptr, sizeof(T));
+    return t;
+}
+
+template<typename T>
+inline void StoreUnaligned(byte* ptr, T t) {
+    memcpy(ptr, &t, sizeof(T));
+}
+
+inline bool IsForwardSafe(byte* destination, const byte* source, u64 size) {
+    return destination <= source || destination >= source + size;
+}
+
+inline u64 PackByte(byte value) {
+    return (u64)value * 0x0101010101010101ull;
 }
 
-void MemoryCopy(const void* destination, const void* source, u64 copySize, bool useIntermediateBuffer) {
-    const void* intermediate = (useIntermediateBuffer) ? Alloc(copySize) : destination;
+//
+// Scalar
+//
 
-    // Copy 8 bytes at a time
-    for (int i = 0; i < copySize / sizeof(u64); i++) {
-        ((u64*)intermediate)[i] = ((u64*)source)[i];
+/**
+ * \brief Moves up to 15 bytes.
+ */
+template<typename T>
+inline void MoveOverlapped(byte* destination, const byte* source, u64 size) {
+    T head = LoadUnaligned<T>(source);
+    T tail = LoadUnaligned<T>(source + size - sizeof(T));
+
+    StoreUnaligned(destination, head);
+    StoreUnaligned(destination + size - sizeof(T), tail);
+}
+
+inline void MoveSmall(byte* destination, const byte* source, u64 size) {
+    if (size >= 8) {
+        MoveOverlapped<u64>(destination, source, size);
+    } else if (size >= 4) {
+        MoveOverlapped<u32>(destination, source, size);
+    } else if (size >= 2) {
+        MoveOverlapped<u16>(destination, source, size);
+    } else if (size == 1) {
+        *destination = *source;
     }
+}
+
+inline void SetSmall(byte* destination, u64 size, byte value) {
+    u64 packed = PackByte(value);
 
-    // Copy any remaining bytes
-    int base = (int)(copySize / sizeof(u64) * sizeof(u64));
-    for (int i = 0; i < copySize % sizeof(u64); i++) {
-        ((byte*)intermediate)[base + i] = ((byte*)source)[base + i];
+    if (size >= 8) {
+        StoreUnaligned(destination, packed);
+        StoreUnaligned(destination + size - 8, packed);
+    } else if (size >= 4) {
+        StoreUnaligned(destination, (u32)packed);
+        StoreUnaligned(destination + size - 4, (u32)packed);
+    } else if (size >= 2) {
+        StoreUnaligned(destination, (u16)packed);
+        StoreUnaligned(destination + size - 2, (u16)packed);
+    } else if (size == 1) {
+        *destination = value;
     }
+}
+
+template<typename T>
+inline bool CompareOverlapped(const byte* a, const byte* b, u64 size) {
+    return LoadUnaligned<T>(a) == LoadUnaligned<T>(b) &&
+           LoadUnaligned<T>(a + size - sizeof(T)) == LoadUnaligned<T>(b + size - sizeof(T));
+}
 
-    if (useIntermediateBuffer) {
-        // Copy 8 bytes at a time
-        for (int i = 0; i < copySize / sizeof(u64); i++) {
-            ((u64*)destination)[i] = ((u64*)intermediate)[i];
+inline bool CompareSmall(const byte* a, const byte* b, u64 size) {
+    if (size >= 8) {
+        return CompareOverlapped<u64>(a, b, size);
+    } else if (size >= 4) {
+        return CompareOverlapped<u32>(a, b, size);
+    } else if (size >= 2) {
+        return CompareOverlapped<u16>(a, b, size);
+    } else if (size == 1) {
+        return *a == *b;
+    }
+
+    return true;
+}
+
+inline void MoveScalar(byte* destination, const byte* source, u64 size) {
+    if (size < 16) {
+        MoveSmall(destination, source, size);
+        return;
+    }
+
+    if (IsForwardSafe(destination, source, size)) {
+        u64 tail = LoadUnaligned<u64>(source + size - 8);
+
+        for (u64 i = 0; i + 8 <= size; i += 8) {
+            StoreUnaligned(destination + i, LoadUnaligned<u64>(source + i));
         }
 
-        // Copy any remaining bytes
-        for (int i = 0; i < copySize % sizeof(u64); i++) {
-            ((byte*)destination)[base + i] = ((byte*)intermediate)[base + i];
+        StoreUnaligned(destination + size - 8, tail);
+    } else {
+        u64 head = LoadUnaligned<u64>(source);
+
+        for (u64 i = size; i >= 8; i -= 8) {
+            StoreUnaligned(destination + i - 8, LoadUnaligned<u64>(source + i - 8));
         }
 
-        Free((void*)intermediate);
+        StoreUnaligned(destination, head);
     }
 }
 
-void MemorySet(void* destination, u64 destinationSize, u64 setSize, byte value) {
-    MemorySet(destination, Min(destinationSize, setSize), value);
+inline void SetScalar(byte* destination, u64 size, byte value) {
+    if (size < 16) {
+        SetSmall(destination, size, value);
+        return;
+    }
+
+    u64 packed = PackByte(value);
+
+    for (u64 i = 0; i + 8 <= size; i += 8) {
+        StoreUnaligned(destination + i, packed);
+    }
+
+    StoreUnaligned(destination + size - 8, packed);
 }
 
-void MemorySet(void* destination, u64 setSize, byte value) {
-    u64 v = (u64)value;
-    u64 packedValue = (v << 56) | (v << 48) | (v << 40) | (v << 32) | (v << 24) | (v << 16) | (v << 8) | v;
+inline bool CompareScalar(const byte* a, const byte* b, u64 size) {
+    if (size < 16) {
+        return CompareSmall(a, b, size);
+    }
+
+    for (u64 i = 0; i + 8 <= size; i += 8) {
+        if (LoadUnaligned<u64>(a + i) != LoadUnaligned<u64>(b + i)) {
+            return false;
+        }
+    }
+
+    return LoadUnaligned<u64>(a + size - 8) == LoadUnaligned<u64>(b + size - 8);
+}
 
-    // Copy 8 bytes at a time
-    for (int i = 0; i < setSize / sizeof(u64); i++) {
-        ((u64*)destination)[i] = packedValue;
+#if defined(PD_X86)
+
+//
+// SSE2
+//
+
+PD_TARGET("sse2")
+inline void MoveSSE2(byte* destination, const byte* source, u64 size) {
+    if (size < 16) {
+        MoveSmall(destination, source, size);
+        return;
     }
 
-    // Copy any remaining bytes
-    int base = (int)(setSize / sizeof(u64) * sizeof(u64));
-    for (int i = 0; i < setSize % sizeof(u64); i++) {
-        ((byte*)destination)[base + i] = value;
+    if (IsForwardSafe(destination, source, size)) {
+        __m128i tail = _mm_loadu_si128((const __m128i*)(source + size - 16));
+
+        u64 i = 0;
+        for (; i + 64 <= size; i += 64) {
+            __m128i a = _mm_loadu_si128((const __m128i*)(source + i));
+            __m128i b = _mm_loadu_si128((const __m128i*)(source + i + 16));
+            __m128i c = _mm_loadu_si128((const __m128i*)(source + i + 32));
+            __m128i d = _mm_loadu_si128((const __m128i*)(source + i + 48));
+
+            _mm_storeu_si128((__m128i*)(destination + i), a);
+            _mm_storeu_si128((__m128i*)(destination + i + 16), b);
+            _mm_storeu_si128((__m128i*)(destination + i + 32), c);
+            _mm_storeu_si128((__m128i*)(destination + i + 48), d);
+        }
+
+        for (; i + 16 <= size; i += 16) {
+            _mm_storeu_si128((__m128i*)(destination + i), _mm_loadu_si128((const __m128i*)(source + i)));
+        }
+
+        _mm_storeu_si128((__m128i*)(destination + size - 16), tail);
+    } else {
+        __m128i head = _mm_loadu_si128((const __m128i*)source);
+
+        u64 i = size;
+        for (; i >= 64; i -= 64) {
+            __m128i a = _mm_loadu_si128((const __m128i*)(source + i - 16));
+            __m128i b = _mm_loadu_si128((const __m128i*)(source + i - 32));
+            __m128i c = _mm_loadu_si128((const __m128i*)(source + i - 48));
+            __m128i d = _mm_loadu_si128((const __m128i*)(source + i - 64));
+
+            _mm_storeu_si128((__m128i*)(destination + i - 16), a);
+            _mm_storeu_si128((__m128i*)(destination + i - 32), b);
+            _mm_storeu_si128((__m128i*)(destination + i - 48), c);
+            _mm_storeu_si128((__m128i*)(destination + i - 64), d);
+        }
+
+        for (; i >= 16; i -= 16) {
+            _mm_storeu_si128((__m128i*)(destination + i - 16), _mm_loadu_si128((const __m128i*)(source + i - 16)));
+        }
+
+        _mm_storeu_si128((__m128i*)destination, head);
+    }
+}
+
+PD_TARGET("sse2")
+inline void SetSSE2(byte* destination, u64 size, byte value) {
+    if (size < 16) {
+        SetSmall(destination, size, value);
+        return;
     }
 
+    __m128i packed = _mm_set1_epi8((char)value);
+
+    u64 i = 0;
+    for (; i + 64 <= size; i += 64) {
+        _mm_storeu_si128((__m128i*)(destination + i), packed);
+        _mm_storeu_si128((__m128i*)(destination + i + 16), packed);
+        _mm_storeu_si128((__m128i*)(destination + i + 32), packed);
+        _mm_storeu_si128((__m128i*)(destination + i + 48), packed);
+    }
+
+    for (; i + 16 <= size; i += 16) {
+        _mm_storeu_si128((__m128i*)(destination + i), packed);
+    }
+
+    _mm_storeu_si128((__m128i*)(destination + size - 16), packed);
 }
 
-bool MemoryCompare(void* a, void* b, u64 compareSize) {
-    // Compare 8 bytes at a time
-    for (int i = 0; i < compareSize / sizeof(u64); i++) {
-        if (((u64*)a)[i] != ((u64*)b)[i]) {
+PD_TARGET("sse2")
+inline bool CompareSSE2(const byte* a, const byte* b, u64 size) {
+    if (size < 16) {
+        return CompareSmall(a, b, size);
+    }
+
+    for (u64 i = 0; i + 16 <= size; i += 16) {
+        __m128i equal = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(a + i)),
+                                       _mm_loadu_si128((const __m128i*)(b + i)));
+
+        if (_mm_movemask_epi8(equal) != 0xFFFF) {
             return false;
         }
     }
 
-    // Compare any remaining bytes
-    int base = (int)(compareSize / sizeof(u64) * sizeof(u64));
-    for (int i = 0; i < compareSize % sizeof(u64); i++) {
-        if (((byte*)a)[base + i] != ((byte*)b)[base + i]) {
+    __m128i equal = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(a + size - 16)),
+                                   _mm_loadu_si128((const __m128i*)(b + size - 16)));
+
+    return _mm_movemask_epi8(equal) == 0xFFFF;
+}
+
+//
+// AVX2
+//
+
+PD_TARGET("avx2")
+inline void StreamAVX2(byte* destination, const byte* source, u64 size) {
+    // Streaming stores have to be aligned, the first store covers the unaligned start
+    __m256i head = _mm256_loadu_si256((const __m256i*)source);
+    __m256i tail = _mm256_loadu_si256((const __m256i*)(source + size - 32));
+
+    u64 i = AlignUp((u64)destination, (u64)32) - (u64)destination;
+    for (; i + 128 <= size; i += 128) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(source + i));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(source + i + 32));
+        __m256i c = _mm256_loadu_si256((const __m256i*)(source + i + 64));
+        __m256i d = _mm256_loadu_si256((const __m256i*)(source + i + 96));
+
+        _mm256_stream_si256((__m256i*)(destination + i), a);
+        _mm256_stream_si256((__m256i*)(destination + i + 32), b);
+        _mm256_stream_si256((__m256i*)(destination + i + 64), c);
+        _mm256_stream_si256((__m256i*)(destination + i + 96), d);
+    }
+
+    for (; i + 32 <= size; i += 32) {
+        _mm256_stream_si256((__m256i*)(destination + i), _mm256_loadu_si256((const __m256i*)(source + i)));
+    }
+
+    _mm_sfence();
+
+    _mm256_storeu_si256((__m256i*)destination, head);
+    _mm256_storeu_si256((__m256i*)(destination + size - 32), tail);
+}
+
+PD_TARGET("avx2")
+inline void MoveAVX2(byte* destination, const byte* source, u64 size) {
+    if (size < 32) {
+        MoveSSE2(destination, source, size);
+        return;
+    }
+
+    bool overlaps = destination < source + size && source < destination + size;
+
+    if (!overlaps && size >= MEMORY_STREAMING_THRESHOLD) {
+        StreamAVX2(destination, source, size);
+    } else if (IsForwardSafe(destination, source, size)) {
+        __m256i tail = _mm256_loadu_si256((const __m256i*)(source + size - 32));
+
+        u64 i = 0;
+        for (; i + 128 <= size; i += 128) {
+            __m256i a = _mm256_loadu_si256((const __m256i*)(source + i));
+            __m256i b = _mm256_loadu_si256((const __m256i*)(source + i + 32));
+            __m256i c = _mm256_loadu_si256((const __m256i*)(source + i + 64));
+            __m256i d = _mm256_loadu_si256((const __m256i*)(source + i + 96));
+
+            _mm256_storeu_si256((__m256i*)(destination + i), a);
+            _mm256_storeu_si256((__m256i*)(destination + i + 32), b);
+            _mm256_storeu_si256((__m256i*)(destination + i + 64), c);
+            _mm256_storeu_si256((__m256i*)(destination + i + 96), d);
+        }
+
+        for (; i + 32 <= size; i += 32) {
+            _mm256_storeu_si256((__m256i*)(destination + i), _mm256_loadu_si256((const __m256i*)(source + i)));
+        }
+
+        _mm256_storeu_si256((__m256i*)(destination + size - 32), tail);
+    } else {
+        __m256i head = _mm256_loadu_si256((const __m256i*)source);
+
+        u64 i = size;
+        for (; i >= 128; i -= 128) {
+            __m256i a = _mm256_loadu_si256((const __m256i*)(source + i - 32));
+            __m256i b = _mm256_loadu_si256((const __m256i*)(source + i - 64));
+            __m256i c = _mm256_loadu_si256((const __m256i*)(source + i - 96));
+            __m256i d = _mm256_loadu_si256((const __m256i*)(source + i - 128));
+
+            _mm256_storeu_si256((__m256i*)(destination + i - 32), a);
+            _mm256_storeu_si256((__m256i*)(destination + i - 64), b);
+            _mm256_storeu_si256((__m256i*)(destination + i - 96), c);
+            _mm256_storeu_si256((__m256i*)(destination + i - 128), d);
+        }
+
+        for (; i >= 32; i -= 32) {
+            _mm256_storeu_si256((__m256i*)(destination + i - 32), _mm256_loadu_si256((const __m256i*)(source + i - 32)));
+        }
+
+        _mm256_storeu_si256((__m256i*)destination, head);
+    }
+}
+
+PD_TARGET("avx2")
+inline void SetAVX2(byte* destination, u64 size, byte value) {
+    if (size < 32) {
+        SetSSE2(destination, size, value);
+        return;
+    }
+
+    __m256i packed = _mm256_set1_epi8((char)value);
+
+    u64 i = 0;
+    for (; i + 128 <= size; i += 128) {
+        _mm256_storeu_si256((__m256i*)(destination + i), packed);
+        _mm256_storeu_si256((__m256i*)(destination + i + 32), packed);
+        _mm256_storeu_si256((__m256i*)(destination + i + 64), packed);
+        _mm256_storeu_si256((__m256i*)(destination + i + 96), packed);
+    }
+
+    for (; i + 32 <= size; i += 32) {
+        _mm256_storeu_si256((__m256i*)(destination + i), packed);
+    }
+
+    _mm256_storeu_si256((__m256i*)(destination + size - 32), packed);
+}
+
+PD_TARGET("avx2")
+inline bool CompareAVX2(const byte* a, const byte* b, u64 size) {
+    if (size < 32) {
+        return CompareSSE2(a, b, size);
+    }
+
+    for (u64 i = 0; i + 32 <= size; i += 32) {
+        __m256i equal = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(a + i)),
+                                          _mm256_loadu_si256((const __m256i*)(b + i)));
+
+        if (_mm256_movemask_epi8(equal) != -1) {
             return false;
         }
     }
 
-    return true;
+    __m256i equal = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(a + size - 32)),
+                                      _mm256_loadu_si256((const __m256i*)(b + size - 32)));
+
+    return _mm256_movemask_epi8(equal) == -1;
+}
+
+#endif
+
+//
+// Dispatch
+//
+
+// The functions start out as resolvers so we don't depend on static initialization order,
+// the first call picks the best implementation for the CPU.
+
+inline void ResolveMove(byte* destination, const byte* source, u64 size);
+inline void ResolveSet(byte* destination, u64 size, byte value);
+inline bool ResolveCompare(const byte* a, const byte* b, u64 size);
+
+// @GLOBAL
+static MemoryMoveFunction* moveFunction = ResolveMove;
+
+// @GLOBAL
+static MemorySetFunction* setFunction = ResolveSet;
+
+// @GLOBAL
+static MemoryCompareFunction* compareFunction = ResolveCompare;
+
+inline void ResolveMemoryFunctions() {
+    moveFunction = MoveScalar;
+    setFunction = SetScalar;
+    compareFunction = CompareScalar;
+
+#if defined(PD_X86)
+    const CPUFeatures& features = GetCPUFeatures();
+
+    if (features.avx2) {
+        moveFunction = MoveAVX2;
+        setFunction = SetAVX2;
+        compareFunction = CompareAVX2;
+    } else if (features.sse2) {
+        moveFunction = MoveSSE2;
+        setFunction = SetSSE2;
+        compareFunction = CompareSSE2;
+    }
+#endif
+}
+
+inline void ResolveMove(byte* destination, const byte* source, u64 size) {
+    ResolveMemoryFunctions();
+    moveFunction(destination, source, size);
+}
+
+inline void ResolveSet(byte* destination, u64 size, byte value) {
+    ResolveMemoryFunctions();
+    setFunction(destination, size, value);
+}
+
+inline bool ResolveCompare(const byte* a, const byte* b, u64 size) {
+    ResolveMemoryFunctions();
+    return compareFunction(a, b, size);
+}
+
+void MemoryCopy(const void* destination, u64 destinationSize, const void* source, u64 copySize) {
+    MemoryCopy(destination, source, Min(destinationSize, copySize));
+}
+
+void MemoryCopy(const void* destination, const void* source, u64 copySize) {
+    moveFunction((byte*)destination, (const byte*)source, copySize);
+}
+
+void MemoryMove(void* destination, const void* source, u64 moveSize) {
+    moveFunction((byte*)destination, (const byte*)source, moveSize);
+}
+
+void MemorySet(void* destination, u64 destinationSize, u64 setSize, byte value) {
+    MemorySet(destination, Min(destinationSize, setSize), value);
+}
+
+void MemorySet(void* destination, u64 setSize, byte value) {
+    setFunction((byte*)destination, setSize, value);
+}
+
+bool MemoryCompare(void* a, void* b, u64 compareSize) {
+    return compareFunction((const byte*)a, (const byte*)b, compareSize);
 }
 
 }
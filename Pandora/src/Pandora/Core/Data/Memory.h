@@ -5,27 +5,36 @@
 namespace pd {
 
 /**
- * \brief Attempts to copy `copySize` bytes of `destination` to `source`.
+ * \brief Attempts to copy `copySize` bytes of `source` to `destination`.
+ * The buffers must not overlap, use `MemoryMove()` for that.
  * 
  * \param destination The destination buffer.
  * \param destinationSize The destination buffer size.
  * \param source The source buffer.
  * \param copySize How many bytes to copy.
- * \param useIntermediateBuffer Whether or not to copy to an intermediate buffer first.
  */
-inline void MemoryCopy(const void* destination, u64 destinationSize,
-                       const void* source, u64 copySize, bool useIntermediateBuffer = false);
+void MemoryCopy(const void* destination, u64 destinationSize,
+                const void* source, u64 copySize);
 
 /**
- * \brief Copies `copySize` bytes of `destination` to `source`.
+ * \brief Copies `copySize` bytes of `source` to `destination`.
+ * The buffers must not overlap, use `MemoryMove()` for that.
  * 
  * \param destination The destination buffer.
  * \param source The source buffer.
  * \param copySize How many bytes to copy.
- * \param useIntermediateBuffer Whether or not to copy to an intermediate buffer first.
  */
-void MemoryCopy(const void* destination, const void* source,
-                u64 copySize, bool useIntermediateBuffer = false);
+void MemoryCopy(const void* destination, const void* source, u64 copySize);
+
+/**
+ * \brief Copies `moveSize` bytes of `source` to `destination`.
+ * The buffers are allowed to overlap.
+ * 
+ * \param destination The destination buffer.
+ * \param source The source buffer.
+ * \param moveSize How many bytes to move.
+ */
+void MemoryMove(void* destination, const void* source, u64 moveSize);
 
 /**
  * \brief Attempts to set `setSize` bytes of `destination` to `value`.
@@ -35,7 +44,7 @@ void MemoryCopy(const void* destination, const void* source,
  * \param setSize How many bytes to set.
  * \param value The byte value to set.
  */
-inline void MemorySet(void* destination, u64 destinationSize, u64 setSize, byte value);
+void MemorySet(void* destination, u64 destinationSize, u64 setSize, byte value);
 
 /**
  * \brief Sets `setSize` bytes of `destination` to `value`.
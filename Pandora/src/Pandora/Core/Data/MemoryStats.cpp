@@ -0,0 +1,45 @@
+#include "MemoryStats.h"
+
+namespace pd {
+
+void MemoryStatsToJson(JsonValue& out) {
+    out.SetType(JsonType::Object);
+    out.AddField("allocatedBytes", JsonValue((f64)GetAllocatedBytes()));
+
+    JsonValue tags(JsonType::Object);
+    for (int i = 0; i < (int)MemoryTag::Count; i++) {
+        MemoryTagStats stats = GetMemoryTagStats((MemoryTag)i);
+
+        JsonValue tag(JsonType::Object);
+        tag.AddField("currentBytes", JsonValue((f64)stats.currentBytes));
+        tag.AddField("peakBytes", JsonValue((f64)stats.peakBytes));
+        tag.AddField("liveAllocations", JsonValue((f64)stats.liveAllocations));
+        tag.AddField("totalAllocations", JsonValue((f64)stats.totalAllocations));
+        tag.AddField("frameAllocations", JsonValue((f64)stats.frameAllocations));
+
+        tags.AddField(GetMemoryTagName((MemoryTag)i), tag);
+    }
+
+    out.AddField("tags", tags);
+
+    // The last bucket has no upper limit
+    JsonValue histogram(JsonType::Array);
+    for (int i = 0; i < MEMORY_HISTOGRAM_BUCKETS; i++) {
+        JsonValue bucket(JsonType::Object);
+        bucket.AddField("maxSize", (i < MEMORY_HISTOGRAM_BUCKETS - 1) ? JsonValue((f64)((u64)16 << i)) : JsonValue());
+        bucket.AddField("count", JsonValue((f64)GetAllocationHistogram(i)));
+
+        histogram.AddElement(bucket);
+    }
+
+    out.AddField("histogram", histogram);
+}
+
+bool WriteMemoryStats(StringView path) {
+    JsonValue stats;
+    MemoryStatsToJson(stats);
+
+    return stats.WriteToFile(path);
+}
+
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Pandora/Core/Data/Allocator.h"
+#include "Pandora/Core/Encoding/JSON.h"
+
+namespace pd {
+
+/**
+ * \brief Writes the live memory statistics of every tag and the allocation size histogram to JSON.
+ * 
+ * \param out The output value. Gets turned into an object.
+ */
+void MemoryStatsToJson(JsonValue& out);
+
+/**
+ * \brief Writes the live memory statistics to a JSON file.
+ * 
+ * \param path The output path.
+ * \return Whether or not it wrote it successfully.
+ */
+bool WriteMemoryStats(StringView path);
+
+}
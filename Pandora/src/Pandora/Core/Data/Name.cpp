@@ -0,0 +1,121 @@
+#include "Name.h"
+
+#include "Pandora/Core/Assert.h"
+#include "Pandora/Core/Async/Mutex.h"
+#include "Pandora/Core/Async/Lock.h"
+#include "Pandora/Core/Data/FlatMap.h"
+
+namespace pd {
+
+// Entries live in fixed pages so they never move, that's what lets
+// `View()` and `Hash()` read them without taking the lock
+const int NAME_PAGE_SIZE = 1024;
+const int NAME_MAX_PAGES = 4096;
+
+struct NameEntry {
+    const char* text = nullptr;
+    int count = 0;
+    int size = 0;
+    u64 hash = 0;
+};
+
+struct NameTable {
+    Mutex lock;
+    FlatMap<StringView, u32> ids;
+
+    NameEntry* pages[NAME_MAX_PAGES] = {};
+
+    // 0 is the empty name
+    u32 count = 1;
+};
+
+inline NameTable& GetNameTable() {
+    // Function static so names can be created during static initialization
+    // @GLOBAL
+    static NameTable table;
+    return table;
+}
+
+inline const NameEntry& GetNameEntry(u32 id) {
+    return GetNameTable().pages[id / NAME_PAGE_SIZE][id % NAME_PAGE_SIZE];
+}
+
+Name::Name(StringView text) {
+    if (text.SizeInBytes() == 0) return;
+
+    NameTable& table = GetNameTable();
+    Lock lock(table.lock);
+
+    u32* existing = table.ids.Find(text);
+    if (existing) {
+        id = *existing;
+        return;
+    }
+
+    u32 newID = table.count;
+    int page = (int)(newID / NAME_PAGE_SIZE);
+
+    PD_ASSERT(page < NAME_MAX_PAGES, "ran out of names, %d are in use", (int)newID);
+
+    if (!table.pages[page]) {
+        table.pages[page] = (NameEntry*)Alloc(sizeof(NameEntry) * NAME_PAGE_SIZE);
+    }
+
+    int size = (int)text.SizeInBytes();
+    char* copy = (char*)Alloc(u64(size) + 1);
+    MemoryCopy(copy, text.Data(), size);
+    copy[size] = '\0';
+
+    NameEntry& entry = table.pages[page][newID % NAME_PAGE_SIZE];
+    entry.text = copy;
+    entry.count = text.Count();
+    entry.size = size;
+    entry.hash = DoHash(text);
+
+    // Key on the copy, the text we were given might not outlive us
+    table.ids.Insert(StringView(copy, entry.count, size), newID);
+    table.count += 1;
+
+    id = newID;
+}
+
+StringView Name::View() const {
+    if (id == 0) return StringView();
+
+    const NameEntry& entry = GetNameEntry(id);
+    return StringView(entry.text, entry.count, entry.size);
+}
+
+u64 Name::Hash() const {
+    if (id == 0) return DoHash(StringView());
+
+    return GetNameEntry(id).hash;
+}
+
+void DeleteNames() {
+    NameTable& table = GetNameTable();
+    Lock lock(table.lock);
+
+    for (u32 i = 1; i < table.count; i++) {
+        Free((void*)GetNameEntry(i).text);
+    }
+
+    for (int i = 0; i < NAME_MAX_PAGES; i++) {
+        if (table.pages[i]) {
+            Free(table.pages[i]);
+            table.pages[i] = nullptr;
+        }
+    }
+
+    table.ids.Delete();
+    table.count = 1;
+}
+
+int GetNameCount() {
+    NameTable& table = GetNameTable();
+    Lock lock(table.lock);
+
+    return (int)table.count - 1;
+}
+
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Pandora/Core/Types.h"
+#include "Pandora/Core/Data/StringView.h"
+#include "Pandora/Core/Data/String.h"
+#include "Pandora/Core/Data/Hash.h"
+
+namespace pd {
+
+/**
+ * \brief A handle to a string in the global name table.
+ * Every distinct string gets interned once, after that names compare and hash by their ID.
+ * Creating a name locks the table, so create them up front and not every frame.
+ */
+class Name {
+public:
+    Name() = default;
+
+    /**
+     * \brief Interns the text if it isn't in the name table yet. Thread-safe.
+     *
+     * \param text The text.
+     */
+    explicit Name(StringView text);
+
+    /**
+     * \return The interned text, it stays valid until `DeleteNames()` is called.
+     */
+    StringView View() const;
+
+    /**
+     * \return The `DoHash()` hash of the text, computed once when it got interned.
+     */
+    u64 Hash() const;
+
+    /**
+     * \return The ID of the name, 0 for the empty name.
+     */
+    inline u32 ID() const;
+
+    /**
+     * \return Whether or not this is the empty name.
+     */
+    inline bool IsEmpty() const;
+
+    inline bool operator==(const Name& other) const;
+    inline bool operator!=(const Name& other) const;
+
+private:
+    u32 id = 0;
+};
+
+/**
+ * \brief Frees the name table, every name that was created before becomes invalid.
+ * The `App` does this on destruction.
+ */
+void DeleteNames();
+
+/**
+ * \return How many distinct names have been interned.
+ */
+int GetNameCount();
+
+inline u32 Name::ID() const {
+    return id;
+}
+
+inline bool Name::IsEmpty() const {
+    return id == 0;
+}
+
+inline bool Name::operator==(const Name& other) const {
+    return id == other.id;
+}
+
+inline bool Name::operator!=(const Name& other) const {
+    return id != other.id;
+}
+
+template<>
+struct Hasher<Name> {
+    static u64 Hash(const Name& data) {
+        return HashMix(data.ID());
+    }
+};
+
+inline void PrintType(Name& type, FormatInfo& info) {
+    StringView view = type.View();
+    PrintType(view, info);
+}
+
+}
@@ -108,7 +108,7 @@ private:
     bool hasValue = false;
 
     // We want to avoid calling the constructor/destructor of T
-    u8 rawValue[sizeof(T)] = {};
+    alignas(T) u8 rawValue[sizeof(T)] = {};
 };
 
 }
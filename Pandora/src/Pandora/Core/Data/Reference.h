@@ -26,6 +26,13 @@ public:
      */
     Ref(const Ref<T>& other);
 
+    /**
+     * \brief Takes over the other reference without touching the reference count.
+     * 
+     * \param other The other reference, it will be empty afterwards.
+     */
+    Ref(Ref<T>&& other);
+
     /**
      * \brief Calls `Reset` with `data`.
      * 
@@ -42,7 +49,7 @@ public:
      * \return The new reference.
      */
     template<typename ...Args>
-    static Ref<T> Create(Args ...args);
+    static Ref<T> Create(Args&&... args);
 
     /**
      * \brief Creates a new reference based on this reference.
@@ -97,6 +104,8 @@ public:
 
     Ref<T>& operator=(const Ref<T>& other);
 
+    Ref<T>& operator=(Ref<T>&& other);
+
     T* operator->() const;
 
     T& operator*() const;
@@ -165,9 +174,9 @@ private:
 
 template<typename T>
 template<typename ...Args>
-inline Ref<T> Ref<T>::Create(Args ...args) {
+inline Ref<T> Ref<T>::Create(Args&&... args) {
     Ref<T> ref;
-    ref.data = New<T>(args...);
+    ref.data = New<T>(std::forward<Args>(args)...);
     ref.type = RefType::Strong;
     ref.count = New<Ref::RefCount>(1, 0);
 
@@ -185,6 +194,11 @@ inline Ref<T>::Ref(const Ref<T>& other) {
     Copy(other);
 }
 
+template<typename T>
+inline Ref<T>::Ref(Ref<T>&& other) {
+    operator=(std::move(other));
+}
+
 template<typename T>
 inline Ref<T>::Ref(T* data) {
     Reset(data);
@@ -288,6 +302,22 @@ inline Ref<T>& Ref<T>::operator=(const Ref<T>& other) {
     return *this;
 }
 
+template<typename T>
+inline Ref<T>& Ref<T>::operator=(Ref<T>&& other) {
+    if (&other == this) return *this;
+
+    DecCount(type);
+
+    data = other.data;
+    count = other.count;
+    type = other.type;
+
+    other.data = nullptr;
+    other.count = nullptr;
+
+    return *this;
+}
+
 template<typename T>
 inline T* Ref<T>::operator->() const {
     return Get();
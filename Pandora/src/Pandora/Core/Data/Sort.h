@@ -0,0 +1,528 @@
+#pragma once
+
+#include <new>
+#include <utility>
+#include <type_traits>
+
+#include "Pandora/Core/Types.h"
+#include "Pandora/Core/Data/Allocator.h"
+#include "Pandora/Core/Data/Memory.h"
+
+namespace pd {
+
+/**
+ * \brief Ranges this small get sorted with insertion sort.
+ */
+const int SORT_INSERTION_THRESHOLD = 16;
+
+/**
+ * \brief Ranges bigger than this pick their pivot from the median of three medians.
+ */
+const int SORT_NINTHER_THRESHOLD = 128;
+
+/**
+ * \brief How many elements a partial insertion sort may move before it gives up.
+ */
+const int SORT_PARTIAL_INSERTION_LIMIT = 8;
+
+/**
+ * \brief Sorts the range using insertion sort. This sort is stable.
+ *
+ * \param data The first element.
+ * \param count How many elements to sort.
+ * \param less Needs to return true if `a` goes before `b`.
+ */
+template<typename T, typename LessLambda>
+void InsertionSort(T* data, int count, LessLambda& less) {
+    for (int i = 1; i < count; i++) {
+        if (!less(data[i], data[i - 1])) continue;
+
+        T tmp = std::move(data[i]);
+
+        int j = i;
+        do {
+            data[j] = std::move(data[j - 1]);
+            j -= 1;
+        } while (j > 0 && less(tmp, data[j - 1]));
+
+        data[j] = std::move(tmp);
+    }
+}
+
+/**
+ * \brief Tries to sort a nearly sorted range with insertion sort.
+ *
+ * \return Whether or not the range is sorted, false if it moved too many elements and gave up.
+ */
+template<typename T, typename LessLambda>
+bool PartialInsertionSort(T* data, int count, LessLambda& less) {
+    int moved = 0;
+
+    for (int i = 1; i < count; i++) {
+        if (!less(data[i], data[i - 1])) continue;
+
+        T tmp = std::move(data[i]);
+
+        int j = i;
+        do {
+            data[j] = std::move(data[j - 1]);
+            j -= 1;
+        } while (j > 0 && less(tmp, data[j - 1]));
+
+        data[j] = std::move(tmp);
+        moved += i - j;
+
+        if (moved > SORT_PARTIAL_INSERTION_LIMIT) return false;
+    }
+
+    return true;
+}
+
+/**
+ * \brief Restores the max-heap property for the element at `index`.
+ */
+template<typename T, typename LessLambda>
+void SiftDown(T* data, int index, int count, LessLambda& less) {
+    T tmp = std::move(data[index]);
+
+    while (true) {
+        int child = index * 2 + 1;
+        if (child >= count) break;
+
+        if (child + 1 < count && less(data[child], data[child + 1])) {
+            child += 1;
+        }
+
+        if (!less(tmp, data[child])) break;
+
+        data[index] = std::move(data[child]);
+        index = child;
+    }
+
+    data[index] = std::move(tmp);
+}
+
+/**
+ * \brief Sorts the range using heapsort. Guaranteed O(n log n) but slower than quicksort on average.
+ */
+template<typename T, typename LessLambda>
+void HeapSort(T* data, int count, LessLambda& less) {
+    for (int i = count / 2 - 1; i >= 0; i--) {
+        SiftDown(data, i, count, less);
+    }
+
+    for (int i = count - 1; i > 0; i--) {
+        std::swap(data[0], data[i]);
+        SiftDown(data, 0, i, less);
+    }
+}
+
+/**
+ * \brief Orders the three elements so `b` holds the median.
+ */
+template<typename T, typename LessLambda>
+void SortThree(T& a, T& b, T& c, LessLambda& less) {
+    if (less(b, a)) std::swap(a, b);
+    if (less(c, b)) std::swap(b, c);
+    if (less(b, a)) std::swap(a, b);
+}
+
+/**
+ * \brief Partitions the range around the first element.
+ *
+ * \param alreadyPartitioned Set to whether or not no elements needed to be swapped.
+ * \return The final index of the pivot.
+ */
+template<typename T, typename LessLambda>
+int PartitionRight(T* data, int count, LessLambda& less, bool& alreadyPartitioned) {
+    T pivot = std::move(data[0]);
+
+    int first = 0;
+    int last = count;
+
+    // The median of three guarantees there is an element that isn't less than the pivot
+    while (less(data[++first], pivot)) {}
+
+    if (first == 1) {
+        while (first < last && !less(data[--last], pivot)) {}
+    } else {
+        while (!less(data[--last], pivot)) {}
+    }
+
+    alreadyPartitioned = first >= last;
+
+    while (first < last) {
+        std::swap(data[first], data[last]);
+
+        while (less(data[++first], pivot)) {}
+        while (!less(data[--last], pivot)) {}
+    }
+
+    int pivotIndex = first - 1;
+    data[0] = std::move(data[pivotIndex]);
+    data[pivotIndex] = std::move(pivot);
+
+    return pivotIndex;
+}
+
+/**
+ * \brief Puts all elements equal to the pivot in the first element to the left.
+ * Used when the pivot equals the element before the range, so there are lots of duplicates.
+ *
+ * \return The index of the first element that's bigger than the pivot.
+ */
+template<typename T, typename LessLambda>
+int PartitionLeft(T* data, int count, LessLambda& less) {
+    T pivot = std::move(data[0]);
+
+    int first = 0;
+    int last = count;
+
+    while (less(pivot, data[--last])) {}
+
+    if (last + 1 == count) {
+        while (first < last && !less(pivot, data[++first])) {}
+    } else {
+        while (!less(pivot, data[++first])) {}
+    }
+
+    while (first < last) {
+        std::swap(data[first], data[last]);
+
+        while (less(pivot, data[--last])) {}
+        while (!less(pivot, data[++first])) {}
+    }
+
+    data[0] = std::move(data[last]);
+    data[last] = std::move(pivot);
+
+    return last + 1;
+}
+
+/**
+ * \brief The pattern-defeating quicksort loop.
+ *
+ * \param depthLimit How many bad partitions are allowed before switching to heapsort.
+ * \param leftmost Whether or not there are no elements to the left of the range.
+ */
+template<typename T, typename LessLambda>
+void IntroSortLoop(T* data, int count, LessLambda& less, int depthLimit, bool leftmost) {
+    // Recurse into the smaller partition and loop on the bigger one so the stack stays O(log n)
+    while (true) {
+        if (count <= SORT_INSERTION_THRESHOLD) {
+            InsertionSort(data, count, less);
+            return;
+        }
+
+        // Pick the pivot and move it to the front
+        int half = count / 2;
+        if (count > SORT_NINTHER_THRESHOLD) {
+            SortThree(data[0], data[half], data[count - 1], less);
+            SortThree(data[1], data[half - 1], data[count - 2], less);
+            SortThree(data[2], data[half + 1], data[count - 3], less);
+            SortThree(data[half - 1], data[half], data[half + 1], less);
+        } else {
+            SortThree(data[0], data[half], data[count - 1], less);
+        }
+        std::swap(data[0], data[half]);
+
+        // If the pivot equals the element before the range, the range only holds elements
+        // that are equal or bigger, so put all equal elements aside and continue with the rest
+        if (!leftmost && !less(data[-1], data[0])) {
+            int begin = PartitionLeft(data, count, less);
+            data += begin;
+            count -= begin;
+            continue;
+        }
+
+        bool alreadyPartitioned = false;
+        int pivot = PartitionRight(data, count, less, alreadyPartitioned);
+
+        int leftCount = pivot;
+        int rightCount = count - pivot - 1;
+
+        // A very unbalanced partition means a bad pivot, shuffle some elements to break up patterns
+        bool unbalanced = leftCount < count / 8 || rightCount < count / 8;
+        if (unbalanced) {
+            if (--depthLimit == 0) {
+                HeapSort(data, count, less);
+                return;
+            }
+
+            if (leftCount >= SORT_INSERTION_THRESHOLD) {
+                std::swap(data[0], data[leftCount / 4]);
+                std::swap(data[pivot - 1], data[pivot - leftCount / 4]);
+            }
+
+            if (rightCount >= SORT_INSERTION_THRESHOLD) {
+                std::swap(data[pivot + 1], data[pivot + 1 + rightCount / 4]);
+                std::swap(data[count - 1], data[count - rightCount / 4]);
+            }
+        } else if (alreadyPartitioned) {
+            // Sorted input doesn't need any swaps, try to finish it off cheaply
+            if (PartialInsertionSort(data, pivot, less) &&
+                PartialInsertionSort(data + pivot + 1, rightCount, less)) {
+                return;
+            }
+        }
+
+        if (leftCount < rightCount) {
+            IntroSortLoop(data, leftCount, less, depthLimit, leftmost);
+
+            data += pivot + 1;
+            count = rightCount;
+            leftmost = false;
+        } else {
+            IntroSortLoop(data + pivot + 1, rightCount, less, depthLimit, false);
+
+            count = leftCount;
+        }
+    }
+}
+
+/**
+ * \brief Sorts the range using pattern-defeating quicksort.
+ * Sorted, reversed and nearly sorted ranges take linear time, the worst case is O(n log n).
+ * This sort is not stable.
+ *
+ * \param data The first element.
+ * \param count How many elements to sort.
+ * \param less Needs to return true if `a` goes before `b`.
+ */
+template<typename T, typename LessLambda>
+void IntroSort(T* data, int count, LessLambda less) {
+    if (count <= 1) return;
+
+    int depthLimit = 1;
+    for (int n = count; n > 1; n >>= 1) {
+        depthLimit += 1;
+    }
+
+    IntroSortLoop(data, count, less, depthLimit, true);
+}
+
+/**
+ * \brief Merges two adjacent sorted runs. Ties go to the left run so the merge is stable.
+ *
+ * \param data The first element of the left run.
+ * \param leftCount How many elements the left run holds, the right run starts right after it.
+ * \param count How many elements both runs hold.
+ * \param buffer Must hold at least `leftCount` uninitialized elements.
+ * \param less Needs to return true if `a` goes before `b`.
+ */
+template<typename T, typename LessLambda>
+void MergeAdjacent(T* data, int leftCount, int count, T* buffer, LessLambda& less) {
+    if (leftCount <= 0 || leftCount >= count) return;
+
+    // The runs are already in order
+    if (!less(data[leftCount], data[leftCount - 1])) return;
+
+    // Move the left run out of the way and merge it back in
+    for (int i = 0; i < leftCount; i++) {
+        new (buffer + i) T(std::move(data[i]));
+    }
+
+    int left = 0;
+    int right = leftCount;
+    int out = 0;
+
+    while (left < leftCount && right < count) {
+        if (less(data[right], buffer[left])) {
+            data[out++] = std::move(data[right++]);
+        } else {
+            data[out++] = std::move(buffer[left++]);
+        }
+    }
+
+    while (left < leftCount) {
+        data[out++] = std::move(buffer[left++]);
+    }
+
+    if (!std::is_trivially_destructible<T>::value) {
+        for (int i = 0; i < leftCount; i++) {
+            buffer[i].~T();
+        }
+    }
+}
+
+/**
+ * \brief Merge sorts the range, `buffer` must hold at least `count / 2` uninitialized elements.
+ */
+template<typename T, typename LessLambda>
+void MergeSortImpl(T* data, int count, T* buffer, LessLambda& less) {
+    if (count <= SORT_INSERTION_THRESHOLD) {
+        InsertionSort(data, count, less);
+        return;
+    }
+
+    int half = count / 2;
+
+    MergeSortImpl(data, half, buffer, less);
+    MergeSortImpl(data + half, count - half, buffer, less);
+
+    MergeAdjacent(data, half, count, buffer, less);
+}
+
+/**
+ * \brief Sorts the range using merge sort. Equal elements keep their order.
+ * Allocates a buffer of half the range.
+ *
+ * \param data The first element.
+ * \param count How many elements to sort.
+ * \param less Needs to return true if `a` goes before `b`.
+ */
+template<typename T, typename LessLambda>
+void StableSort(T* data, int count, LessLambda less) {
+    if (count <= SORT_INSERTION_THRESHOLD) {
+        InsertionSort(data, count, less);
+        return;
+    }
+
+    T* buffer = (T*)Alloc((u64)(count / 2) * sizeof(T), Allocator::Persistent, alignof(T));
+    MergeSortImpl(data, count, buffer, less);
+    Free(buffer, Allocator::Persistent);
+}
+
+//
+// Radix sort keys
+//
+
+// Maps keys to unsigned integers that sort in the same order
+inline u8 ToRadixKey(u8 key) { return key; }
+inline u16 ToRadixKey(u16 key) { return key; }
+inline u32 ToRadixKey(u32 key) { return key; }
+inline u64 ToRadixKey(u64 key) { return key; }
+
+inline u8 ToRadixKey(i8 key) { return (u8)key ^ 0x80; }
+inline u16 ToRadixKey(i16 key) { return (u16)key ^ 0x8000; }
+inline u32 ToRadixKey(i32 key) { return (u32)key ^ 0x80000000u; }
+inline u64 ToRadixKey(i64 key) { return (u64)key ^ 0x8000000000000000ull; }
+
+inline u32 ToRadixKey(f32 key) {
+    u32 bits;
+    MemoryCopy(&bits, &key, sizeof(bits));
+
+    // Negative numbers need all bits flipped so they sort in reverse, positive numbers only the sign
+    return bits ^ ((u32)((i32)bits >> 31) | 0x80000000u);
+}
+
+inline u64 ToRadixKey(f64 key) {
+    u64 bits;
+    MemoryCopy(&bits, &key, sizeof(bits));
+
+    return bits ^ ((u64)((i64)bits >> 63) | 0x8000000000000000ull);
+}
+
+/**
+ * \brief Sorts the range by the key of every element using an 8-bit LSD radix sort.
+ * Equal keys keep their order. Takes linear time, the buffer for the keys and elements comes from the temporary arena if it fits.
+ * Supported key types are integers, `f32` and `f64`. NaNs sort to the ends.
+ *
+ * \param data The first element.
+ * \param count How many elements to sort.
+ * \param keyFunc Returns the key of an element.
+ */
+template<typename T, typename KeyLambda>
+void RadixSort(T* data, int count, KeyLambda keyFunc) {
+    if (count <= 1) return;
+
+    using Key = decltype(ToRadixKey(keyFunc(*data)));
+
+    // Input usually comes in order already, don't pay for the buffer and the histograms then
+    int firstUnsorted = 1;
+    for (Key previous = ToRadixKey(keyFunc(data[0])); firstUnsorted < count; firstUnsorted++) {
+        Key key = ToRadixKey(keyFunc(data[firstUnsorted]));
+        if (key < previous) break;
+        previous = key;
+    }
+
+    if (firstUnsorted == count) return;
+
+    struct Entry {
+        Key key;
+        u32 index;
+    };
+
+    const int RADIX = 256;
+    const int PASSES = (int)sizeof(Key);
+
+    // The keys, the scratch keys and the sorted elements share one buffer
+    const u64 alignment = (alignof(T) > alignof(Entry)) ? alignof(T) : alignof(Entry);
+    u64 entriesSize = ((u64)count * sizeof(Entry) * 2 + alignment - 1) / alignment * alignment;
+    u64 bufferSize = entriesSize + (u64)count * sizeof(T);
+
+    // Gets called every frame so use the temporary arena, unless the buffer would make it wrap around
+    ScopedArena arena;
+    u64 available = GetTemporaryCapacity() - GetTemporaryUsedBytes();
+    Allocator allocator = (bufferSize + alignment + DEFAULT_ALIGNMENT * 2 <= available) ? Allocator::Temporary : Allocator::Persistent;
+
+    byte* buffer = (byte*)Alloc(bufferSize, allocator, alignment);
+
+    Entry* entries = (Entry*)buffer;
+    Entry* scratch = entries + count;
+
+    // Count every digit of every pass in one go
+    u32 histograms[PASSES][RADIX] = {};
+
+    for (int i = 0; i < count; i++) {
+        Key key = ToRadixKey(keyFunc(data[i]));
+
+        entries[i].key = key;
+        entries[i].index = (u32)i;
+
+        for (int pass = 0; pass < PASSES; pass++) {
+            histograms[pass][(key >> (pass * 8)) & 0xFF] += 1;
+        }
+    }
+
+    bool moved = false;
+    for (int pass = 0; pass < PASSES; pass++) {
+        u32* histogram = histograms[pass];
+
+        // Every key has the same digit, nothing would move
+        if (histogram[(entries[0].key >> (pass * 8)) & 0xFF] == (u32)count) continue;
+
+        u32 offset = 0;
+        for (int i = 0; i < RADIX; i++) {
+            u32 digitCount = histogram[i];
+            histogram[i] = offset;
+            offset += digitCount;
+        }
+
+        for (int i = 0; i < count; i++) {
+            u32 digit = (entries[i].key >> (pass * 8)) & 0xFF;
+            scratch[histogram[digit]++] = entries[i];
+        }
+
+        std::swap(entries, scratch);
+        moved = true;
+    }
+
+    if (moved) {
+        // Put the elements in their sorted order
+        T* ordered = (T*)(buffer + entriesSize);
+
+        if (std::is_trivially_copyable<T>::value) {
+            for (int i = 0; i < count; i++) {
+                MemoryCopy(ordered + i, data + entries[i].index, sizeof(T));
+            }
+
+            MemoryCopy(data, ordered, (u64)count * sizeof(T));
+        } else {
+            for (int i = 0; i < count; i++) {
+                new (ordered + i) T(std::move(data[entries[i].index]));
+            }
+
+            for (int i = 0; i < count; i++) {
+                data[i] = std::move(ordered[i]);
+                ordered[i].~T();
+            }
+        }
+    }
+
+    if (allocator == Allocator::Persistent) {
+        Free(buffer, Allocator::Persistent);
+    }
+}
+
+}
@@ -5,6 +5,7 @@
 
 #include "Pandora/Core/Assert.h"
 #include "Pandora/Core/Data/Memory.h"
+#include "Pandora/Core/Encoding/UTF8.h"
 
 #include "Pandora/Libs/utf8/utf8.h"
 
@@ -18,19 +19,36 @@ String::String(const uchar* string, pd::Allocator allocator) :
     Set(string);
 }
 
-String::String(const String& other) : String(other.Data(), other.Allocator()) {}
+String::String(const String& other) :
+    String(other.Data(), (other.allocator == Allocator::None) ? Allocator::Persistent : other.allocator) {}
+
+String::String(String&& other) :
+    allocator((other.allocator == Allocator::None) ? Allocator::Persistent : other.allocator) {
+    operator=(std::move(other));
+}
 
 String::~String() {
     Delete();
 }
 
 void String::Delete() {
-    if (memory) {
+    if (isInline) {
+        isInline = false;
+    } else if (memory) {
         Free(memory, allocator);
     }
 
     memory = nullptr;
     bufferSize = 0;
+
+    InvalidateCache();
+}
+
+void String::Clear() {
+    if (Data()) {
+        ByteData()[0] = '\0';
+        InvalidateCache();
+    }
 }
 
 void String::Set(const uchar* string) {
@@ -40,10 +58,28 @@ void String::Set(const uchar* string) {
 
     Grow(size);
     utf8cpy(ByteData(), string);
+
+    InvalidateCache();
 }
 
 void String::Set(StringView text) {
-    Set(text.ToString());
+    // Growing could free the text if it's a view of ourselves
+    if (PointsIntoBuffer(text.Data())) {
+        Set(text.ToString());
+        return;
+    }
+
+    u64 size = text.SizeInBytes();
+    u64 currentSize = SizeInBytes();
+
+    if (size + 1 > currentSize) {
+        Grow((int)(size + 1 - currentSize));
+    }
+
+    MemoryCopy(ByteData(), text.Data(), size);
+    ByteData()[size] = '\0';
+
+    InvalidateCache();
 }
 
 void String::FormatF(const uchar* fmt, ...) {
@@ -67,11 +103,31 @@ void String::Append(const uchar* text) {
 
         Grow(subSize);
         utf8cat(Data(), text);
+
+        InvalidateCache();
     }
 }
 
 void String::Append(StringView text) {
-    Append(text.ToString());
+    u64 size = SizeInBytes();
+
+    if (size == 0) {
+        Set(text);
+        return;
+    }
+
+    if (PointsIntoBuffer(text.Data())) {
+        Append(text.ToString());
+        return;
+    }
+
+    u64 textSize = text.SizeInBytes();
+
+    Grow((int)textSize);
+    MemoryCopy(ByteData() + size - 1, text.Data(), textSize);
+    ByteData()[size - 1 + textSize] = '\0';
+
+    InvalidateCache();
 }
 
 void String::Append(codepoint point) {
@@ -86,8 +142,23 @@ void String::Append(codepoint point) {
     int pointSize = CodepointSize(point);
 
     Grow(pointSize);
-    utf8catcodepoint(ByteData() + size - 1, point, bufferSize - (u64)((i64)size - (i64)pointSize));
+    utf8catcodepoint(ByteData() + size - 1, point, BufferSize() - (u64)((i64)size - (i64)pointSize));
     ByteData()[size + pointSize - 1] = '\0';
+
+    InvalidateCache();
+}
+
+void String::ReserveCapacity(u64 sizeInBytes) {
+    u64 size = SizeInBytes();
+
+    if (sizeInBytes <= size) return;
+
+    Grow((int)(sizeInBytes - size));
+
+    // A new buffer has no text in it yet
+    if (size == 0) {
+        ByteData()[0] = '\0';
+    }
 }
 
 void String::Substr(String& out, int index, int count) {
@@ -111,6 +182,8 @@ void String::Substr(String& out, int index, int count) {
         out.Grow(subSize + 1);
         out.ByteData()[subSize] = '\0';
         MemoryCopy(out.ByteData(), ByteData() + offset, subSize);
+
+        out.InvalidateCache();
     }
 }
 
@@ -125,7 +198,11 @@ int String::PurgeChars(const uchar* chars) {
         GetNextCodepoint(u, &point);
 
         int pointSize = CodepointSize(point);
-        MemoryCopy(u, (byte*)u + pointSize, (byte*)u - ByteData() - pointSize, true);
+        MemoryMove(u, (byte*)u + pointSize, (byte*)u - ByteData() - pointSize);
+    }
+
+    if (removed > 0) {
+        InvalidateCache();
     }
 
     return removed;
@@ -262,13 +339,16 @@ void String::Insert(int index, const uchar* text) {
 
     int offset = ByteOffset(index);
 
-    u64 copySize = SizeInBytes() - textSize - offset;
+    // Includes the null terminator
+    u64 copySize = SizeInBytes() - offset;
 
-    MemoryCopy(ByteData() + offset + textSize,
+    MemoryMove(ByteData() + offset + textSize,
                ByteData() + offset,
-               SizeInBytes() - textSize - offset, true);
+               copySize);
 
     MemoryCopy(ByteData() + offset, text, textSize);
+
+    InvalidateCache();
 }
 
 void String::Remove(int index, int count) {
@@ -278,9 +358,11 @@ void String::Remove(int index, int count) {
     int removeStart = ByteOffset(index);
     int removeSize = ByteOffset(index, count);
 
-    MemoryCopy(ByteData() + removeStart,
+    MemoryMove(ByteData() + removeStart,
                ByteData() + removeStart + removeSize,
-               SizeInBytes() - removeStart - removeSize, true);
+               SizeInBytes() - removeStart - removeSize);
+
+    InvalidateCache();
 }
 
 int String::Replace(const uchar* find, const uchar* replace) {
@@ -326,12 +408,14 @@ void String::Split(const uchar* seperator, Array<String>& out, pd::Allocator str
 void String::ToUpper() {
     if (Data()) {
         utf8upr(Data());
+        InvalidateCache();
     }
 }
 
 void String::ToLower() {
     if (Data()) {
         utf8lwr(Data());
+        InvalidateCache();
     }
 }
 
@@ -340,18 +424,13 @@ void String::ChangeAllocator(pd::Allocator allocator) {
 
     if (allocator == pd::Allocator::None) {
         Delete();
-    } else if (allocator == pd::Allocator::Persistent) {
-        byte* newMemory = (byte*)Alloc(bufferSize, allocator);
-        MemoryCopy(newMemory, memory, bufferSize);
-
-        // We know that `memory` doesn't use the persistent allocator so we don't need to free it
-        memory = newMemory;
-    } else if (allocator == pd::Allocator::Temporary) {
+    } else if (!isInline) {
         byte* newMemory = (byte*)Alloc(bufferSize, allocator);
         MemoryCopy(newMemory, memory, bufferSize);
 
-        if (this->allocator == pd::Allocator::Persistent) {
-            Free(memory);
+        // Does nothing for temporary memory
+        if (memory) {
+            Free(memory, this->allocator);
         }
 
         memory = newMemory;
@@ -361,13 +440,18 @@ void String::ChangeAllocator(pd::Allocator allocator) {
 }
 
 bool String::IsValid() {
-    return bufferSize > 0 && IsValidUTF8(Data()) == 0;
+    return BufferSize() > 0 && IsValidUTF8(Data());
 }
 
 codepoint String::At(int index) const {
     PD_ASSERT_D(index >= 0 && index < Count(),
                u8"index out of range, valid: 0:%d, given: %d", Count(), index);
 
+    // Every codepoint is a single byte
+    if (IsASCII()) {
+        return ByteData()[index];
+    }
+
     codepoint point = 0;
     uchar* u = ByteData();
     for (int i = 0; i < index + 1; i++) {
@@ -385,6 +469,14 @@ codepoint String::Back() {
     return At(Count() - 1);
 }
 
+bool String::IsASCII() const {
+    if (cachedCount < 0) {
+        UpdateCache();
+    }
+
+    return cachedASCII;
+}
+
 StringView String::View(int offset, int count) const {
     if (count <= 0) {
         count = Count() - offset;
@@ -406,6 +498,10 @@ int String::ByteOffset(int index, int count) const {
     PD_ASSERT_D(index >= 0 && index < Count() && index + count <= Count(),
                u8"illegal byte offset range, valid: 0:%d, given: %d:%d", Count(), index, count);
 
+    if (IsASCII()) {
+        return count;
+    }
+
     int offset = 0;
 
     codepoint point = 0;
@@ -426,7 +522,7 @@ uchar* String::Data() const {
 }
 
 byte* String::ByteData() const {
-    return memory;
+    return (isInline) ? (byte*)inlineMemory : memory;
 }
 
 const char* String::CStr() const {
@@ -438,7 +534,11 @@ Allocator String::Allocator() const {
 }
 
 int String::Count() const {
-    return (Data()) ? UTF8Count(Data()) : 0;
+    if (cachedCount < 0) {
+        UpdateCache();
+    }
+
+    return cachedCount;
 }
 
 u64 String::SizeInBytes() const {
@@ -446,7 +546,7 @@ u64 String::SizeInBytes() const {
 }
 
 u64 String::BufferSize() const {
-    return bufferSize;
+    return (isInline) ? STRING_INLINE_SIZE : bufferSize;
 }
 
 codepoint String::operator[](int index) const {
@@ -459,7 +559,49 @@ String& String::operator=(const uchar* other) {
 }
 
 String& String::operator=(const String& other) {
-    Set(other.Data());
+    if (other.Data()) {
+        Set(other.Data());
+    } else {
+        Clear();
+    }
+
+    return *this;
+}
+
+String& String::operator=(String&& other) {
+    if (&other == this) return *this;
+
+    // Bounded strings can't take over a buffer
+    bool canTakeBuffer = (isInline || memory == ByteData()) && allocator != Allocator::None;
+
+    if (canTakeBuffer && other.CanStealBuffer() && (allocator == other.allocator || !Data())) {
+        Delete();
+
+        allocator = other.allocator;
+        memory = other.memory;
+        bufferSize = other.bufferSize;
+        cachedCount = other.cachedCount;
+        cachedASCII = other.cachedASCII;
+
+        other.memory = nullptr;
+        other.bufferSize = 0;
+        other.InvalidateCache();
+
+        return *this;
+    }
+
+    // An empty string has no buffer to copy from
+    if (other.Data()) {
+        Set(other.Data());
+    } else {
+        Clear();
+    }
+
+    // Short strings get copied, empty them so moving behaves the same for every length
+    if (other.isInline) {
+        other.Delete();
+    }
+
     return *this;
 }
 
@@ -497,11 +639,27 @@ bool String::operator!=(const char* other) const {
 }
 
 StringViewIt String::begin() const {
-    return View().begin();
+    u64 size = SizeInBytes();
+    return StringViewIt(ByteData(), ByteData() + ((size > 0) ? size - 1 : 0));
 }
 
 StringViewIt String::end() const {
-    return View().end();
+    u64 size = SizeInBytes();
+    byte* end = ByteData() + ((size > 0) ? size - 1 : 0);
+    return StringViewIt(end, end);
+}
+
+void String::UpdateCache() const {
+    cachedCount = 0;
+    cachedASCII = true;
+
+    if (!Data()) return;
+
+    u64 size = SizeInBytes() - 1;
+    cachedCount = UTF8Count(Data(), size);
+
+    // Fewer codepoints than bytes means there's a multi-byte codepoint somewhere
+    cachedASCII = (u64)cachedCount == size && pd::IsASCII(Data(), size);
 }
 
 void String::Grow(int bytes) {
@@ -509,16 +667,38 @@ void String::Grow(int bytes) {
     const int INITIAL_LENGTH = 64;
     const int GROW_FACTOR = 2;
 
-    if (SizeInBytes() + bytes >= bufferSize) {
+    u64 size = SizeInBytes();
+
+    // Short strings don't need the allocator at all
+    if (!Data() && allocator != Allocator::None && size + bytes < STRING_INLINE_SIZE) {
+        isInline = true;
+        inlineMemory[0] = '\0';
+        return;
+    }
+
+    u64 newSize = BufferSize();
+
+    if (size + bytes >= newSize) {
         if (!Data()) {
-            bufferSize = INITIAL_LENGTH;
+            newSize = INITIAL_LENGTH;
         }
 
-        while (bufferSize <= SizeInBytes() + bytes) {
-            bufferSize *= GROW_FACTOR;
+        while (newSize <= size + bytes) {
+            newSize *= GROW_FACTOR;
+        }
+
+        if (isInline) {
+            // The text has to be copied out before the pointer overwrites it
+            byte* newMemory = (byte*)Alloc(newSize, allocator);
+            MemoryCopy(newMemory, inlineMemory, size);
+
+            isInline = false;
+            memory = newMemory;
+        } else {
+            memory = (byte*)Realloc(ByteData(), newSize, allocator);
         }
 
-        memory = (byte*)Realloc(ByteData(), bufferSize, allocator);
+        bufferSize = newSize;
     }
 }
 
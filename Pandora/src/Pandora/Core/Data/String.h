@@ -3,16 +3,34 @@
 #include "Pandora/Core/Math/Math.h"
 #include "Pandora/Core/Data/Array.h"
 #include "Pandora/Core/IO/MemoryStream.h"
+#include "Pandora/Core/Data/StringBuilder.h"
 #include "Pandora/Core/Logging/Logging.h"
 
 namespace pd {
 
+/**
+ * \brief How many bytes a `String` can hold without allocating, including the null terminator.
+ */
+const int STRING_INLINE_SIZE = 24;
+
+/**
+ * \brief A null-terminated UTF-8 string.
+ * Strings of up to `STRING_INLINE_SIZE - 2` bytes are stored inside the string itself,
+ * so pointers to the text of a short string don't survive moving the string.
+ */
 class String {
 public:
     String(pd::Allocator allocator = Allocator::Persistent);
     String(const uchar* string, pd::Allocator allocator = Allocator::Persistent);
     String(const String& other);
 
+    /**
+     * \brief Takes over the buffer of `other`, leaving it empty.
+     * 
+     * \param other The other string.
+     */
+    String(String&& other);
+
     virtual ~String();
 
     /**
@@ -21,6 +39,11 @@ public:
      */
     void Delete();
 
+    /**
+     * \brief Empties the text but keeps the buffer.
+     */
+    void Clear();
+
     /**
      * \param text The new string text.
      */
@@ -47,10 +70,22 @@ public:
      */
     template<typename... Args>
     void Format(StringView fmt, const Args&... args) {
-        MemoryStream stream(32, true, pd::Allocator::Temporary);
-        pd::Log(stream, fmt, args...);
-        stream.WriteByte('\0');
-        Set(stream.Data());
+        StringBuilder builder(pd::Allocator::Temporary, 64);
+        pd::Log(builder, fmt, args...);
+        builder.ToString(*this);
+    }
+
+    /**
+     * \brief Format the string using a format string that was parsed at compile time.
+     * 
+     * \param fmt The format string.
+     * \param args The format arguments.
+     */
+    template<typename Text, typename... Args>
+    void Format(FormatString<Text> fmt, const Args&... args) {
+        StringBuilder builder(pd::Allocator::Temporary, 64);
+        pd::Log(builder, fmt, args...);
+        builder.ToString(*this);
     }
 
     /**
@@ -68,6 +103,14 @@ public:
      */
     void Append(codepoint text);
 
+    /**
+     * \brief Makes sure the buffer can hold at least `sizeInBytes` bytes without growing.
+     * Does not change the text.
+     * 
+     * \param sizeInBytes The size in bytes, including the null terminator.
+     */
+    void ReserveCapacity(u64 sizeInBytes);
+
     /**
      * \brief Sets `out` to the specified substring.
      * 
@@ -218,7 +261,8 @@ public:
 
     /**
      * \brief Gets the codepoint at the specified index.
-     * This operation is O(n).
+     * This operation is O(1) for ASCII strings and O(n) otherwise,
+     * iterate over the string to go through all codepoints.
      * 
      * \param index The index.
      * \return The codepoint.
@@ -232,10 +276,15 @@ public:
 
     /**
      * \return The last codepoint.
-     * This location is O(n).
+     * This location is O(n) for non-ASCII strings.
      */
     codepoint Back();
 
+    /**
+     * \return Whether or not every codepoint is ASCII.
+     */
+    bool IsASCII() const;
+
     /**
      * \brief Creates a string view based on this string.
      * 
@@ -283,7 +332,7 @@ public:
     Allocator Allocator() const;
 
     /**
-     * \brief Calculates the length of the string.
+     * \brief Calculates the length of the string, it's cached until the string changes.
      * 
      * \return How many codepoints are in the string, exlcuding the null terminator.
      */
@@ -307,6 +356,9 @@ public:
 
     String& operator=(const String& other);
 
+    // Takes over the buffer when both strings use the same allocator, copies the text otherwise
+    String& operator=(String&& other);
+
     bool operator==(const String& other) const;
     bool operator==(StringView other) const;
     bool operator==(const char* other) const;
@@ -328,13 +380,62 @@ protected:
      */
     void Grow(int bytes);
 
+    /**
+     * \brief Forgets the cached count, every function that changes the text calls this.
+     */
+    inline void InvalidateCache() {
+        cachedCount = -1;
+    }
+
+    /**
+     * \brief Counts the codepoints and checks if they're all ASCII.
+     */
+    void UpdateCache() const;
+
+    /**
+     * \brief Whether or not the string owns a heap buffer that can be handed over to another string.
+     */
+    inline bool CanStealBuffer() const {
+        // Bounded strings and short strings keep their text inline
+        return !isInline && memory && memory == ByteData() && allocator != pd::Allocator::None;
+    }
+
+    /**
+     * \param ptr The pointer to check.
+     * \return Whether or not `ptr` points into our buffer.
+     */
+    inline bool PointsIntoBuffer(const void* ptr) const {
+        const byte* data = ByteData();
+        return data && ptr >= data && ptr < data + BufferSize();
+    }
+
+    // A short string stores its text where the buffer pointer and size would be,
+    // so only read `memory` and `bufferSize` when `isInline` is false
+    union {
+        struct {
+            byte* memory;
+
+            // BufferSize of the memory in bytes
+            u64 bufferSize;
+        };
+
+        byte inlineMemory[STRING_INLINE_SIZE] = {};
+    };
+
     pd::Allocator allocator = Allocator::None;
-    byte* memory = nullptr;
 
-    // BufferSize of the memory in bytes
-    u64 bufferSize = 0;
+    // Whether or not the text is stored in `inlineMemory`
+    bool isInline = false;
+
+    mutable bool cachedASCII = false;
+
+    // The codepoint count, -1 if the text changed since it was counted
+    mutable int cachedCount = -1;
 };
 
+// The vtable pointer, the buffer and 8 bytes for the allocator, the flags and the cached count
+static_assert(sizeof(String) <= sizeof(void*) + STRING_INLINE_SIZE + 8, "String got bigger than its buffer and bookkeeping");
+
 template<int maxCapacity>
 class BoundedString final : public String {
 public:
@@ -350,6 +451,17 @@ public:
         Set(text);
     }
 
+    BoundedString(const BoundedString<maxCapacity>& other) : BoundedString() {
+        Set(other.Data());
+    }
+
+    BoundedString<maxCapacity>& operator=(const BoundedString<maxCapacity>& other) {
+        Set(other.Data());
+        return *this;
+    }
+
+    using String::operator=;
+
     virtual void ChangeAllocator(pd::Allocator allocator) override {
         // Not allowed
     }
@@ -0,0 +1,181 @@
+#include "StringBuilder.h"
+
+#include "Pandora/Core/Data/Memory.h"
+#include "Pandora/Core/Data/String.h"
+#include "Pandora/Core/Encoding/UTF8.h"
+#include "Pandora/Core/Math/Math.h"
+
+#include "Pandora/Libs/utf8/utf8.h"
+
+namespace pd {
+
+StringBuilder::StringBuilder(pd::Allocator allocator, u64 initialSize) :
+    allocator(allocator), initialSize(initialSize) {}
+
+StringBuilder::~StringBuilder() {
+    Delete();
+}
+
+void StringBuilder::Delete() {
+    Chunk* chunk = first;
+    while (chunk) {
+        Chunk* next = chunk->next;
+        Free(chunk, allocator);
+        chunk = next;
+    }
+
+    first = nullptr;
+    last = nullptr;
+    size = 0;
+}
+
+void StringBuilder::Clear() {
+    if (!last) return;
+
+    // The last chunk is always the biggest one
+    Chunk* chunk = first;
+    while (chunk != last) {
+        Chunk* next = chunk->next;
+        Free(chunk, allocator);
+        chunk = next;
+    }
+
+    first = last;
+    last->size = 0;
+    size = 0;
+}
+
+void StringBuilder::Append(StringView text) {
+    WriteRaw((const byte*)text.Data(), text.SizeInBytes());
+}
+
+void StringBuilder::Append(codepoint point) {
+    byte buffer[4];
+    int pointSize = CodepointSize(point);
+
+    utf8catcodepoint(buffer, point, sizeof(buffer));
+    WriteRaw(buffer, (u64)pointSize);
+}
+
+void StringBuilder::ToString(String& out) const {
+    out.Set(StringView());
+    out.ReserveCapacity(size + 1);
+
+    // Each chunk is at least as big as all the ones before it, so there's only a few of them
+    for (Chunk* chunk = first; chunk; chunk = chunk->next) {
+        if (chunk->size > 0) {
+            // A codepoint can be split between two chunks, but only the bytes get copied
+            int count = UTF8Count(chunk->Data(), chunk->size);
+            out.Append(StringView(chunk->Data(), count, (int)chunk->size));
+        }
+    }
+}
+
+i64 StringBuilder::WriteTo(Stream& out) const {
+    i64 written = 0;
+
+    for (Chunk* chunk = first; chunk; chunk = chunk->next) {
+        if (chunk->size > 0) {
+            written += out.WriteBytes(Slice<byte>(chunk->Data(), (int)chunk->size));
+        }
+    }
+
+    return written;
+}
+
+int StringBuilder::ReadByte(byte* out) {
+    return 0;
+}
+
+int StringBuilder::WriteByte(byte b) {
+    if (last && last->size < last->capacity) {
+        last->Data()[last->size++] = b;
+        size += 1;
+        return 1;
+    }
+
+    WriteRaw(&b, 1);
+    return 1;
+}
+
+int StringBuilder::WriteBytes(Slice<byte> bytes) {
+    WriteRaw(bytes.Data(), bytes.SizeInBytes());
+    return (int)bytes.SizeInBytes();
+}
+
+void StringBuilder::Flush() {
+    // No operation
+}
+
+void StringBuilder::Seek(i64 offset, SeekOrigin origin) {
+    // No operation
+}
+
+bool StringBuilder::CanRead() {
+    return false;
+}
+
+bool StringBuilder::CanWrite() {
+    return true;
+}
+
+bool StringBuilder::CanSeek() {
+    return false;
+}
+
+i64 StringBuilder::SizeInBytes() {
+    return (i64)size;
+}
+
+i64 StringBuilder::Position() {
+    return (i64)size;
+}
+
+pd::Allocator StringBuilder::Allocator() const {
+    return allocator;
+}
+
+void StringBuilder::WriteRaw(const byte* data, u64 bytes) {
+    if (bytes == 0) return;
+
+    u64 room = (last) ? last->capacity - last->size : 0;
+
+    // Fill up the last chunk, the rest goes into a new one in one piece
+    if (room > 0) {
+        u64 copySize = Min(room, bytes);
+        MemoryCopy(last->Data() + last->size, data, copySize);
+
+        last->size += copySize;
+        size += copySize;
+
+        data += copySize;
+        bytes -= copySize;
+    }
+
+    if (bytes > 0) {
+        AddChunk(bytes);
+
+        MemoryCopy(last->Data(), data, bytes);
+        last->size = bytes;
+        size += bytes;
+    }
+}
+
+void StringBuilder::AddChunk(u64 minimumSize) {
+    u64 capacity = Max(Max(initialSize, size), minimumSize);
+
+    Chunk* chunk = (Chunk*)Alloc(sizeof(Chunk) + capacity, allocator);
+    chunk->next = nullptr;
+    chunk->size = 0;
+    chunk->capacity = capacity;
+
+    if (last) {
+        last->next = chunk;
+    } else {
+        first = chunk;
+    }
+
+    last = chunk;
+}
+
+}
@@ -0,0 +1,209 @@
+#pragma once
+
+#include "Pandora/Core/Data/Allocator.h"
+#include "Pandora/Core/Data/StringView.h"
+#include "Pandora/Core/IO/Stream.h"
+#include "Pandora/Core/Logging/Logging.h"
+
+namespace pd {
+
+class String;
+
+/**
+ * \brief Assembles large amounts of text.
+ * The text is kept in a list of chunks that never move, so appending never copies
+ * what was written before. Each new chunk is as big as everything before it,
+ * which keeps appending amortized O(1) with only a handful of chunks.
+ * Call `ToString()` or `WriteTo()` once at the end to get the text out.
+ *
+ * Since it's a write-only `Stream` you can also `pd::Log()` straight into it.
+ */
+class StringBuilder : public Stream {
+public:
+    /**
+     * \param allocator The allocator used for the chunks.
+     * \param initialSize The size of the first chunk in bytes.
+     */
+    StringBuilder(pd::Allocator allocator = pd::Allocator::Persistent, u64 initialSize = 256);
+
+    StringBuilder(const StringBuilder& other) = delete;
+    StringBuilder& operator=(const StringBuilder& other) = delete;
+
+    virtual ~StringBuilder();
+
+    /**
+     * \brief Frees all the chunks.
+     * This is called on destruction.
+     */
+    void Delete();
+
+    /**
+     * \brief Removes all the text, but keeps the biggest chunk around for reuse.
+     */
+    void Clear();
+
+    /**
+     * \param text The UTF-8 text to append.
+     */
+    void Append(StringView text);
+
+    /**
+     * \param point The unicode codepoint to append.
+     */
+    void Append(codepoint point);
+
+    /**
+     * \brief Appends a value the same way `pd::Log()` would print `{}`.
+     *
+     * \param value The value.
+     */
+    template<typename T>
+    void AppendValue(const T& value) {
+        FormatInfo info(*this);
+        PrintType((T&)value, info);
+    }
+
+    /**
+     * \brief Appends formatted text, see `Logging.h` for the format.
+     *
+     * \param fmt The format string.
+     * \param args The format arguments.
+     */
+    template<typename... Args>
+    void AppendFormat(StringView fmt, const Args&... args) {
+        pd::Log(*this, fmt, args...);
+    }
+
+    /**
+     * \brief Appends formatted text using a format string that was parsed at compile time.
+     *
+     * \param fmt The format string.
+     * \param args The format arguments.
+     */
+    template<typename Text, typename... Args>
+    void AppendFormat(FormatString<Text> fmt, const Args&... args) {
+        pd::Log(*this, fmt, args...);
+    }
+
+    /**
+     * \brief Copies all the text into `out`, replacing what was in it.
+     *
+     * \param out The output string.
+     */
+    void ToString(String& out) const;
+
+    /**
+     * \brief Writes all the text to the stream.
+     *
+     * \param out The output stream.
+     * \return How many bytes were written.
+     */
+    i64 WriteTo(Stream& out) const;
+
+    /**
+     * \brief Does nothing, the builder can't be read from.
+     *
+     * \return 0.
+     */
+    virtual int ReadByte(byte* out) override;
+
+    /**
+     * \brief Appends a byte.
+     *
+     * \param b The byte to append.
+     * \return How many bytes were written.
+     */
+    virtual int WriteByte(byte b) override;
+
+    /**
+     * \brief Appends a sequence of bytes.
+     *
+     * \param bytes The bytes to append.
+     * \return How many bytes were written.
+     */
+    virtual int WriteBytes(Slice<byte> bytes) override;
+
+    /**
+     * \brief Does nothing.
+     */
+    virtual void Flush() override;
+
+    /**
+     * \brief Does nothing, the builder can only be appended to.
+     */
+    virtual void Seek(i64 offset, SeekOrigin origin = SeekOrigin::Current) override;
+
+    /**
+     * \return False.
+     */
+    virtual bool CanRead() override;
+
+    /**
+     * \return True.
+     */
+    virtual bool CanWrite() override;
+
+    /**
+     * \return False.
+     */
+    virtual bool CanSeek() override;
+
+    /**
+     * \return The size of the text in bytes.
+     */
+    virtual i64 SizeInBytes() override;
+
+    /**
+     * \return The size of the text in bytes.
+     */
+    virtual i64 Position() override;
+
+    /**
+     * \return The allocator used for the chunks.
+     */
+    pd::Allocator Allocator() const;
+
+private:
+    struct Chunk {
+        Chunk* next;
+        u64 size;
+        u64 capacity;
+
+        // The text follows the header
+        inline byte* Data() {
+            return (byte*)(this + 1);
+        }
+    };
+
+    /**
+     * \brief Copies the bytes into the chunks, adding new ones as needed.
+     *
+     * \param data The bytes.
+     * \param size How many bytes.
+     */
+    void WriteRaw(const byte* data, u64 size);
+
+    /**
+     * \brief Adds a chunk that can hold at least `minimumSize` bytes.
+     *
+     * \param minimumSize The minimum size in bytes.
+     */
+    void AddChunk(u64 minimumSize);
+
+    pd::Allocator allocator = pd::Allocator::Persistent;
+    u64 initialSize = 0;
+
+    Chunk* first = nullptr;
+    Chunk* last = nullptr;
+
+    u64 size = 0;
+};
+
+/**
+ * \brief Prints the text of the builder.
+ */
+inline void PrintType(StringBuilder& type, FormatInfo& info) {
+    type.WriteTo(info.output);
+}
+
+}
@@ -5,6 +5,7 @@
 #endif
 
 #include "Pandora/Core/Data/String.h"
+#include "Pandora/Core/Encoding/UTF8.h"
 
 #include "Pandora/Libs/utf8/utf8.h"
 
@@ -13,27 +14,33 @@ namespace pd {
 #if defined(PD_WINDOWS)
 
 wchar* UTF8ToWide(const uchar* text, Allocator allocator) {
-    int multiByteLength = MultiByteToWideChar(CP_UTF8, NULL, (char*)text,
-                                              -1, NULL, 0);
-
-    wchar* multiByte = (wchar*)Alloc(multiByteLength * sizeof(wchar), allocator);
-    MultiByteToWideChar(CP_UTF8, NULL, (char*)text, -1,
-                        multiByte, multiByteLength);
-
-    return multiByte;
+    return UTF8ToWide(text, UTF8Size(text) - 1, allocator);
 }
 
 wchar* UTF8ToWide(const uchar* text, int sizeInBytes, Allocator allocator) {
-    int multiByteLength = MultiByteToWideChar(CP_UTF8, NULL, (char*)text,
-                                              sizeInBytes, NULL, 0) + 1;
+    // Decoding never gives more codepoints than bytes
+    codepoint* points = (codepoint*)Alloc(((u64)sizeInBytes + 1) * sizeof(codepoint), Allocator::Temporary);
+    int count = DecodeUTF8(text, (u64)sizeInBytes, points);
+
+    // Codepoints past U+FFFF become a UTF-16 surrogate pair, they took 4 bytes as UTF-8 so it still fits
+    wchar* wide = (wchar*)Alloc(((u64)sizeInBytes + 1) * sizeof(wchar), allocator);
+    int length = 0;
 
-    wchar* multiByte = (wchar*)Alloc(multiByteLength * sizeof(wchar), allocator);
-    MultiByteToWideChar(CP_UTF8, NULL, (char*)text, sizeInBytes,
-                        multiByte, multiByteLength);
+    for (int i = 0; i < count; i++) {
+        codepoint point = points[i];
+
+        if (point >= 0x10000) {
+            point -= 0x10000;
+            wide[length++] = (wchar)(0xD800 + (point >> 10));
+            wide[length++] = (wchar)(0xDC00 + (point & 0x3FF));
+        } else {
+            wide[length++] = (wchar)point;
+        }
+    }
 
-    multiByte[multiByteLength - 1] = L'\0';
+    wide[length] = L'\0';
 
-    return multiByte;
+    return wide;
 }
 
 uchar* WideToUTF8(const wchar* text, Allocator allocator) {
@@ -72,8 +79,14 @@ StringView::StringView(const char* text, int count) {
     memory = (byte*)text;
     this->count = count;
 
+    // Walk the bytes directly, `At()` needs the size to be known already
+    const byte* position = memory;
     for (int i = 0; i < count; i++) {
-        sizeInBytes += CodepointSize(At(i));
+        codepoint point = 0;
+        const byte* next = (const byte*)GetNextCodepoint(position, &point);
+
+        sizeInBytes += (u64)(next - position);
+        position = next;
     }
 }
 
@@ -144,6 +157,11 @@ void StringView::Adjust(int start, int count) {
 }
 
 codepoint StringView::At(int index) const {
+    // Every codepoint is a single byte
+    if (IsASCII()) {
+        return memory[index];
+    }
+
     codepoint point = 0;
     const uchar* u = Data();
     for (int i = 0; i < index + 1; i++) {
@@ -153,6 +171,10 @@ codepoint StringView::At(int index) const {
     return point;
 }
 
+bool StringView::IsASCII() const {
+    return (u64)count == sizeInBytes;
+}
+
 const uchar* StringView::ToString(Allocator allocator) {
     int size = (int)SizeInBytes();
 
@@ -177,11 +199,11 @@ codepoint StringView::operator[](int index) const {
 }
 
 StringViewIt StringView::begin() const {
-    return StringViewIt(*this, 0);
+    return StringViewIt(memory, memory + sizeInBytes);
 }
 
 StringViewIt StringView::end() const {
-    return StringViewIt(*this, Count());
+    return StringViewIt(memory + sizeInBytes, memory + sizeInBytes);
 }
 
 }
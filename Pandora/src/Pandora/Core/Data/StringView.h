@@ -102,11 +102,19 @@ public:
 
 
     /**
+     * \brief Gets the codepoint at the specified index.
+     * This operation is O(1) for ASCII text and O(n) otherwise, iterate over the view to go through all codepoints.
+     *
      * \param index The index.
      * \return The codepoint at the index.
      */
     codepoint At(int index) const;
 
+    /**
+     * \return Whether or not every codepoint is ASCII.
+     */
+    bool IsASCII() const;
+
     /**
      * \brief Duplicates the view into a newly allocated string.
      * 
@@ -140,28 +148,47 @@ private:
     int count = 0;
 };
 
+/**
+ * \brief Walks the codepoints of UTF-8 text front to back, decoding each one once.
+ */
 struct StringViewIt {
-    StringViewIt(StringView parent, int i) : parent(parent), i(i) {}
+    StringViewIt(const byte* position, const byte* end) : position(position), end(end) {
+        Decode();
+    }
 
     codepoint operator*() const {
-        return parent.At(i);
+        return point;
     }
 
     void operator++() {
-        i += 1;
+        position = next;
+        Decode();
     }
 
-    bool operator==(const StringViewIt& other) {
-        return i == other.i && parent.Data() == other.parent.Data();
+    bool operator==(const StringViewIt& other) const {
+        return position == other.position;
     }
 
-    bool operator!=(const StringViewIt& other) {
+    bool operator!=(const StringViewIt& other) const {
         return !operator==(other);
     }
 
 private:
-    int i = 0;
-    StringView parent;
+    inline void Decode() {
+        if (position >= end) return;
+
+        if (*position < 0x80) {
+            point = *position;
+            next = position + 1;
+        } else {
+            next = (const byte*)GetNextCodepoint(position, &point);
+        }
+    }
+
+    const byte* position = nullptr;
+    const byte* end = nullptr;
+    const byte* next = nullptr;
+    codepoint point = 0;
 };
 
 }
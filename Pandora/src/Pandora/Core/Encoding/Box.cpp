@@ -18,7 +18,9 @@ Box::~Box() {
 bool Box::Load(StringView path) {
     Delete();
 
-    if (!file.Open(path, FileMode::Read)) {
+    ScopedMemoryTag tag(MemoryTag::Box);
+
+    if (!file.Open(path, FileMode::Read, FILE_STREAM_BUFFER_SIZE)) {
         CONSOLE_LOG_DEBUG("[{}Box Error{}] Failed to open file '{}' for reading\n",
                           ConColor::Red, ConColor::White, path);
         return false;
@@ -68,6 +70,9 @@ bool Box::Load(StringView path) {
 
     headers.Resize((int)fileCount);
     for (u32 i = 0; i < fileCount; i++) {
+        // Release the file name after every header
+        ScopedArena scope;
+
         ResourceType type;
         if (file.Read(&type) != sizeof(type)) {
             CONSOLE_LOG_DEBUG("[{}Error{}] Unexpected end-of-file\n",
@@ -182,6 +187,8 @@ ResourceType Box::GetResourceType(StringView name) {
 bool Box::GetResourceData(StringView name, Array<byte>& out) {
     if (!IsOpen() && !builder) return false;
 
+    ScopedMemoryTag tag(MemoryTag::Box);
+
     auto getData = [](Stream& in, Array<byte>& out) {
         u64 uncompressedSize;
         if (in.Read(&uncompressedSize) != sizeof(uncompressedSize)) {
@@ -199,7 +206,7 @@ bool Box::GetResourceData(StringView name, Array<byte>& out) {
 
         if (compressedSize > 0) {
             Array<byte> compressed;
-            compressed.Reserve((int)compressedSize);
+            compressed.AddUninitialized((int)compressedSize);
 
             if (in.ReadBytes(compressed.Data(), compressedSize) != compressedSize) {
                 CONSOLE_LOG_DEBUG("[{}Error{}] Unexpected end-of-file\n",
@@ -209,8 +216,8 @@ bool Box::GetResourceData(StringView name, Array<byte>& out) {
 
             DecompressData(compressed, out);
         } else {
-            out.Reserve((int)uncompressedSize);
-            if (in.ReadBytes(out.Data(), uncompressedSize) != uncompressedSize) {
+            int start = out.AddUninitialized((int)uncompressedSize);
+            if (in.ReadBytes(out.Data() + start, uncompressedSize) != uncompressedSize) {
                 CONSOLE_LOG_DEBUG("[{}Error{}] Unexpected end-of-file\n",
                                   ConColor::Red, ConColor::White);
                 return false;
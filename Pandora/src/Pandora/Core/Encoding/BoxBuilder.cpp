@@ -99,7 +99,7 @@ void BoxBuilder::StageGeneric(StringView name, StringView path, ResourceType typ
 bool BoxBuilder::Build(StringView path) {
     BOXB_LOG("Starting build\n");
 
-    FileStream file(path, FileMode::Write);
+    FileStream file(path, FileMode::Write, FILE_STREAM_BUFFER_SIZE);
 
     if (!file.IsOpen()) return false;
 
@@ -9,7 +9,7 @@
 #define STBI_MALLOC(sz) Alloc(sz, pd::Allocator::Persistent)
 #define STBI_REALLOC(p, newsz) pd::Realloc(p, newsz, pd::Allocator::Persistent)
 #define STBI_FREE(p) pd::Free(p, pd::Allocator::Persistent)
-#define STBI_MEMMOVE(a, b, sz) pd::MemoryCopy(a, b, sz, true)
+#define STBI_MEMMOVE(a, b, sz) pd::MemoryMove(a, b, sz)
 #define STBI_WINDOWS_UTF8
 #define STB_IMAGE_IMPLEMENTATION
 #include "Pandora/Libs/stb/stb_image.h"
@@ -18,7 +18,7 @@
 #define STBIW_MALLOC(sz) pd::Alloc(sz, pd::Allocator::Persistent)
 #define STBIW_REALLOC(p, newsz) pd::Realloc(p, newsz, pd::Allocator::Persistent)
 #define STBIW_FREE(p) pd::Free(p, pd::Allocator::Persistent)
-#define STBIW_MEMMOVE(a, b, sz) pd::MemoryCopy(a, b, sz, true)
+#define STBIW_MEMMOVE(a, b, sz) pd::MemoryMove(a, b, sz)
 #define STBIW_WINDOWS_UTF8
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include "Pandora/Libs/stb/stb_image_write.h"
@@ -500,6 +500,8 @@ bool JsonValue::Parse(StringView source, bool sourceIsPath, JsonParseSettings se
 }
 
 bool JsonValue::Parse(Stream& stream, JsonParseSettings settings) {
+    ScopedMemoryTag tag(MemoryTag::JSON);
+
     ParsingContext c(stream);
     c.stream.SkipBOMIfPresent();
     c.settings = settings;
@@ -540,6 +542,7 @@ void JsonValue::ParseValue(ParsingContext* c, JsonValue* value) {
                 ParseNumber(c, &value->GetNumber());
             } else {
                 // Word must be a keyword
+                ScopedArena scope;
                 String word(Allocator::Temporary);
 
                 do {
@@ -664,6 +667,7 @@ void JsonValue::ParseNumber(ParsingContext* c, f64* value) {
     bool hasExponent = false;
     codepoint point;
 
+    ScopedArena scope;
     String number(Allocator::Temporary);
     do {
         if (c->stream.ReadCodepoint(&point) == 0) break;
@@ -0,0 +1,577 @@
+#include "UTF8.h"
+
+#include <memory.h>
+
+#include "Pandora/Core/CPU.h"
+
+#if defined(PD_X86)
+#include <immintrin.h>
+#endif
+
+// The vectorized validation is the lookup table algorithm from
+// "Validating UTF-8 In Less Than One Instruction Per Byte" by Keiser and Lemire.
+// Every byte is classified by its high nibble and the nibbles of the byte before it,
+// the three lookups only share a bit when the pair of bytes is an error.
+
+namespace pd {
+
+typedef bool UTF8ValidateFunction(const byte* text, u64 size);
+typedef int UTF8CountFunction(const byte* text, u64 size);
+typedef bool UTF8ASCIIFunction(const byte* text, u64 size);
+typedef int UTF8DecodeFunction(const byte* text, u64 size, codepoint* out);
+
+// What malformed bytes decode to
+const codepoint UTF8_REPLACEMENT = 0xFFFD;
+
+// Continuation bytes are 0x80-0xBF, every other byte starts a codepoint
+inline bool IsContinuationByte(byte b) {
+    return (b & 0xC0) == 0x80;
+}
+
+/**
+ * \brief Decodes the codepoint at the start of the text, never reads past `remaining` bytes.
+ *
+ * \param text The UTF-8 text.
+ * \param remaining How many bytes are left in the text, at least 1.
+ * \param out The output codepoint.
+ * \return The size of the codepoint in bytes, 0 if it isn't valid UTF-8.
+ */
+inline int DecodeSequence(const byte* text, u64 remaining, codepoint* out) {
+    byte lead = text[0];
+
+    if (lead < 0x80) {
+        *out = lead;
+        return 1;
+    }
+
+    int continuations = 0;
+    codepoint point = 0;
+    codepoint minimum = 0;
+
+    if ((lead & 0xE0) == 0xC0) {
+        continuations = 1;
+        point = lead & 0x1F;
+        minimum = 0x80;
+    } else if ((lead & 0xF0) == 0xE0) {
+        continuations = 2;
+        point = lead & 0x0F;
+        minimum = 0x800;
+    } else if ((lead & 0xF8) == 0xF0) {
+        continuations = 3;
+        point = lead & 0x07;
+        minimum = 0x10000;
+    } else {
+        return 0;
+    }
+
+    if (remaining <= (u64)continuations) return 0;
+
+    for (int i = 1; i <= continuations; i++) {
+        if (!IsContinuationByte(text[i])) return 0;
+
+        point = (point << 6) | (text[i] & 0x3F);
+    }
+
+    // Overlong, past the last codepoint or a UTF-16 surrogate
+    if (point < minimum || point > 0x10FFFF || (point >= 0xD800 && point <= 0xDFFF)) {
+        return 0;
+    }
+
+    *out = point;
+    return continuations + 1;
+}
+
+/**
+ * \brief Decodes one codepoint, a malformed byte becomes `UTF8_REPLACEMENT`.
+ *
+ * \return How many bytes it consumed.
+ */
+inline int DecodeOne(const byte* text, u64 remaining, codepoint* out) {
+    int size = DecodeSequence(text, remaining, out);
+    if (size > 0) return size;
+
+    *out = UTF8_REPLACEMENT;
+    return 1;
+}
+
+//
+// Scalar
+//
+
+inline bool ValidateScalar(const byte* text, u64 size) {
+    u64 i = 0;
+
+    while (i < size) {
+        codepoint point;
+        int length = DecodeSequence(text + i, size - i, &point);
+        if (length == 0) return false;
+
+        i += length;
+    }
+
+    return true;
+}
+
+inline int CountScalar(const byte* text, u64 size) {
+    int count = 0;
+
+    for (u64 i = 0; i < size; i++) {
+        if (!IsContinuationByte(text[i])) {
+            count += 1;
+        }
+    }
+
+    return count;
+}
+
+inline bool IsASCIIScalar(const byte* text, u64 size) {
+    const u64 HIGH_BITS = 0x8080808080808080ull;
+
+    u64 i = 0;
+    u64 combined = 0;
+
+    for (; i + 8 <= size; i += 8) {
+        u64 word;
+        memcpy(&word, text + i, sizeof(word));
+        combined |= word;
+    }
+
+    for (; i < size; i++) {
+        combined |= text[i];
+    }
+
+    return (combined & HIGH_BITS) == 0;
+}
+
+inline int DecodeScalar(const byte* text, u64 size, codepoint* out) {
+    int count = 0;
+
+    for (u64 i = 0; i < size; count++) {
+        i += DecodeOne(text + i, size - i, &out[count]);
+    }
+
+    return count;
+}
+
+#if defined(PD_X86)
+
+//
+// SSE2
+//
+
+PD_TARGET("sse2")
+inline int CountSSE2(const byte* text, u64 size) {
+    // Bytes above this as signed integers start a codepoint, continuation bytes are -128 to -65
+    const __m128i threshold = _mm_set1_epi8((char)0xBF);
+    const __m128i zero = _mm_setzero_si128();
+
+    u64 i = 0;
+    int count = 0;
+
+    while (i + 16 <= size) {
+        // Every lane of the accumulator counts up to 255 before we have to sum them up
+        __m128i lanes = zero;
+        for (int block = 0; block < 255 && i + 16 <= size; block++, i += 16) {
+            __m128i input = _mm_loadu_si128((const __m128i*)(text + i));
+            lanes = _mm_sub_epi8(lanes, _mm_cmpgt_epi8(input, threshold));
+        }
+
+        __m128i sums = _mm_sad_epu8(lanes, zero);
+        count += _mm_cvtsi128_si32(sums) + _mm_extract_epi16(sums, 4);
+    }
+
+    return count + CountScalar(text + i, size - i);
+}
+
+PD_TARGET("sse2")
+inline bool IsASCIISSE2(const byte* text, u64 size) {
+    __m128i combined = _mm_setzero_si128();
+
+    u64 i = 0;
+    for (; i + 16 <= size; i += 16) {
+        combined = _mm_or_si128(combined, _mm_loadu_si128((const __m128i*)(text + i)));
+    }
+
+    return _mm_movemask_epi8(combined) == 0 && IsASCIIScalar(text + i, size - i);
+}
+
+PD_TARGET("sse2")
+inline int DecodeSSE2(const byte* text, u64 size, codepoint* out) {
+    const __m128i zero = _mm_setzero_si128();
+
+    u64 i = 0;
+    int count = 0;
+
+    while (i + 16 <= size) {
+        __m128i input = _mm_loadu_si128((const __m128i*)(text + i));
+        int nonASCII = _mm_movemask_epi8(input);
+
+        if (nonASCII == 0) {
+            // Widen 16 ASCII bytes to 16 codepoints
+            __m128i low = _mm_unpacklo_epi8(input, zero);
+            __m128i high = _mm_unpackhi_epi8(input, zero);
+
+            _mm_storeu_si128((__m128i*)(out + count + 0), _mm_unpacklo_epi16(low, zero));
+            _mm_storeu_si128((__m128i*)(out + count + 4), _mm_unpackhi_epi16(low, zero));
+            _mm_storeu_si128((__m128i*)(out + count + 8), _mm_unpacklo_epi16(high, zero));
+            _mm_storeu_si128((__m128i*)(out + count + 12), _mm_unpackhi_epi16(high, zero));
+
+            i += 16;
+            count += 16;
+            continue;
+        }
+
+        // Copy the ASCII before the first non-ASCII byte, then decode one codepoint at a time.
+        // The last one can stick out of the block, it gets checked against the end of the text.
+        u64 blockEnd = i + 16;
+        for (; (nonASCII & 1) == 0; nonASCII >>= 1) {
+            out[count++] = text[i++];
+        }
+
+        while (i < blockEnd) {
+            i += DecodeOne(text + i, size - i, &out[count]);
+            count += 1;
+        }
+    }
+
+    return count + DecodeScalar(text + i, size - i, out + count);
+}
+
+//
+// SSSE3
+//
+
+const byte UTF8_TOO_SHORT = 1 << 0;
+const byte UTF8_TOO_LONG = 1 << 1;
+const byte UTF8_OVERLONG_3 = 1 << 2;
+const byte UTF8_TOO_LARGE = 1 << 3;
+const byte UTF8_SURROGATE = 1 << 4;
+const byte UTF8_OVERLONG_2 = 1 << 5;
+const byte UTF8_TOO_LARGE_1000 = 1 << 6;
+const byte UTF8_OVERLONG_4 = 1 << 6;
+const byte UTF8_TWO_CONTS = 1 << 7;
+const byte UTF8_CARRY = UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS;
+
+// Indexed by the high nibble of the previous byte
+#define UTF8_PREVIOUS_HIGH_TABLE \
+    UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, \
+    UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, \
+    UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, \
+    UTF8_TOO_SHORT | UTF8_OVERLONG_2, \
+    UTF8_TOO_SHORT, \
+    UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE, \
+    UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4
+
+// Indexed by the low nibble of the previous byte
+#define UTF8_PREVIOUS_LOW_TABLE \
+    UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4, \
+    UTF8_CARRY | UTF8_OVERLONG_2, \
+    UTF8_CARRY, \
+    UTF8_CARRY, \
+    UTF8_CARRY | UTF8_TOO_LARGE, \
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE, \
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000
+
+// Indexed by the high nibble of the current byte
+#define UTF8_CURRENT_HIGH_TABLE \
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, \
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, \
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4, \
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE, \
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE, \
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE, \
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT
+
+/**
+ * \brief Tracks the state of the SSSE3 validation between blocks.
+ */
+struct UTF8ValidationSSSE3 {
+    __m128i error;
+    __m128i previous;
+    __m128i incomplete;
+};
+
+PD_TARGET("ssse3")
+inline __m128i CheckBlockSSSE3(__m128i input, __m128i previous) {
+    const __m128i previousHighTable = _mm_setr_epi8(UTF8_PREVIOUS_HIGH_TABLE);
+    const __m128i previousLowTable = _mm_setr_epi8(UTF8_PREVIOUS_LOW_TABLE);
+    const __m128i currentHighTable = _mm_setr_epi8(UTF8_CURRENT_HIGH_TABLE);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+
+    __m128i prev1 = _mm_alignr_epi8(input, previous, 15);
+    __m128i prev2 = _mm_alignr_epi8(input, previous, 14);
+    __m128i prev3 = _mm_alignr_epi8(input, previous, 13);
+
+    __m128i special = _mm_shuffle_epi8(previousHighTable, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+    special = _mm_and_si128(special, _mm_shuffle_epi8(previousLowTable, _mm_and_si128(prev1, nibble)));
+    special = _mm_and_si128(special, _mm_shuffle_epi8(currentHighTable, _mm_and_si128(_mm_srli_epi16(input, 4), nibble)));
+
+    // Bytes 2 or 3 after a 3 or 4 byte lead must be continuations, that's
+    // the only time two continuations in a row (the top bit) are allowed
+    __m128i isThird = _mm_subs_epu8(prev2, _mm_set1_epi8((char)(0xE0 - 0x80)));
+    __m128i isFourth = _mm_subs_epu8(prev3, _mm_set1_epi8((char)(0xF0 - 0x80)));
+    __m128i mustContinue = _mm_and_si128(_mm_or_si128(isThird, isFourth), _mm_set1_epi8((char)0x80));
+
+    return _mm_xor_si128(mustContinue, special);
+}
+
+PD_TARGET("ssse3")
+inline void ValidateBlockSSSE3(UTF8ValidationSSSE3& state, __m128i input) {
+    // A lead byte in the last 3 bytes that needs more bytes than are left
+    const __m128i maxValue = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                           (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+
+    if (_mm_movemask_epi8(input) == 0) {
+        // ASCII can't continue a sequence from the previous block
+        state.error = _mm_or_si128(state.error, state.incomplete);
+        state.incomplete = _mm_setzero_si128();
+    } else {
+        state.error = _mm_or_si128(state.error, CheckBlockSSSE3(input, state.previous));
+        state.incomplete = _mm_subs_epu8(input, maxValue);
+    }
+
+    state.previous = input;
+}
+
+PD_TARGET("ssse3")
+inline bool ValidateSSSE3(const byte* text, u64 size) {
+    UTF8ValidationSSSE3 state;
+    state.error = _mm_setzero_si128();
+    state.previous = _mm_setzero_si128();
+    state.incomplete = _mm_setzero_si128();
+
+    u64 i = 0;
+    for (; i + 16 <= size; i += 16) {
+        ValidateBlockSSSE3(state, _mm_loadu_si128((const __m128i*)(text + i)));
+    }
+
+    // Pad the tail with zeroes, which are ASCII
+    if (i < size) {
+        byte tail[16] = {};
+        memcpy(tail, text + i, size - i);
+        ValidateBlockSSSE3(state, _mm_loadu_si128((const __m128i*)tail));
+    }
+
+    state.error = _mm_or_si128(state.error, state.incomplete);
+
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(state.error, _mm_setzero_si128())) == 0xFFFF;
+}
+
+//
+// AVX2
+//
+
+/**
+ * \brief Tracks the state of the AVX2 validation between blocks.
+ */
+struct UTF8ValidationAVX2 {
+    __m256i error;
+    __m256i previous;
+    __m256i incomplete;
+};
+
+PD_TARGET("avx2")
+inline __m256i CheckBlockAVX2(__m256i input, __m256i previous) {
+    const __m256i previousHighTable = _mm256_broadcastsi128_si256(_mm_setr_epi8(UTF8_PREVIOUS_HIGH_TABLE));
+    const __m256i previousLowTable = _mm256_broadcastsi128_si256(_mm_setr_epi8(UTF8_PREVIOUS_LOW_TABLE));
+    const __m256i currentHighTable = _mm256_broadcastsi128_si256(_mm_setr_epi8(UTF8_CURRENT_HIGH_TABLE));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+    // The shifts work per 128-bit lane, so the lane before ours has to be shifted in
+    __m256i shifted = _mm256_permute2x128_si256(previous, input, 0x21);
+    __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+    __m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+    __m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+
+    __m256i special = _mm256_shuffle_epi8(previousHighTable, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+    special = _mm256_and_si256(special, _mm256_shuffle_epi8(previousLowTable, _mm256_and_si256(prev1, nibble)));
+    special = _mm256_and_si256(special, _mm256_shuffle_epi8(currentHighTable, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)));
+
+    __m256i isThird = _mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0 - 0x80)));
+    __m256i isFourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80)));
+    __m256i mustContinue = _mm256_and_si256(_mm256_or_si256(isThird, isFourth), _mm256_set1_epi8((char)0x80));
+
+    return _mm256_xor_si256(mustContinue, special);
+}
+
+PD_TARGET("avx2")
+inline void ValidateBlockAVX2(UTF8ValidationAVX2& state, __m256i input) {
+    const __m256i maxValue = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                              -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                              (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+
+    if (_mm256_movemask_epi8(input) == 0) {
+        state.error = _mm256_or_si256(state.error, state.incomplete);
+        state.incomplete = _mm256_setzero_si256();
+    } else {
+        state.error = _mm256_or_si256(state.error, CheckBlockAVX2(input, state.previous));
+        state.incomplete = _mm256_subs_epu8(input, maxValue);
+    }
+
+    state.previous = input;
+}
+
+PD_TARGET("avx2")
+inline bool ValidateAVX2(const byte* text, u64 size) {
+    UTF8ValidationAVX2 state;
+    state.error = _mm256_setzero_si256();
+    state.previous = _mm256_setzero_si256();
+    state.incomplete = _mm256_setzero_si256();
+
+    u64 i = 0;
+    for (; i + 32 <= size; i += 32) {
+        ValidateBlockAVX2(state, _mm256_loadu_si256((const __m256i*)(text + i)));
+    }
+
+    if (i < size) {
+        byte tail[32] = {};
+        memcpy(tail, text + i, size - i);
+        ValidateBlockAVX2(state, _mm256_loadu_si256((const __m256i*)tail));
+    }
+
+    state.error = _mm256_or_si256(state.error, state.incomplete);
+
+    return _mm256_testz_si256(state.error, state.error) != 0;
+}
+
+PD_TARGET("avx2")
+inline int CountAVX2(const byte* text, u64 size) {
+    const __m256i threshold = _mm256_set1_epi8((char)0xBF);
+    const __m256i zero = _mm256_setzero_si256();
+
+    u64 i = 0;
+    int count = 0;
+
+    while (i + 32 <= size) {
+        __m256i lanes = zero;
+        for (int block = 0; block < 255 && i + 32 <= size; block++, i += 32) {
+            __m256i input = _mm256_loadu_si256((const __m256i*)(text + i));
+            lanes = _mm256_sub_epi8(lanes, _mm256_cmpgt_epi8(input, threshold));
+        }
+
+        __m256i sums = _mm256_sad_epu8(lanes, zero);
+        count += _mm256_extract_epi32(sums, 0) + _mm256_extract_epi32(sums, 2) +
+                 _mm256_extract_epi32(sums, 4) + _mm256_extract_epi32(sums, 6);
+    }
+
+    return count + CountScalar(text + i, size - i);
+}
+
+PD_TARGET("avx2")
+inline bool IsASCIIAVX2(const byte* text, u64 size) {
+    __m256i combined = _mm256_setzero_si256();
+
+    u64 i = 0;
+    for (; i + 32 <= size; i += 32) {
+        combined = _mm256_or_si256(combined, _mm256_loadu_si256((const __m256i*)(text + i)));
+    }
+
+    return _mm256_movemask_epi8(combined) == 0 && IsASCIIScalar(text + i, size - i);
+}
+
+#undef UTF8_PREVIOUS_HIGH_TABLE
+#undef UTF8_PREVIOUS_LOW_TABLE
+#undef UTF8_CURRENT_HIGH_TABLE
+
+#endif
+
+//
+// Dispatch
+//
+
+// Same as the memory functions, they start out as resolvers
+
+inline bool ResolveValidate(const byte* text, u64 size);
+inline int ResolveCount(const byte* text, u64 size);
+inline bool ResolveASCII(const byte* text, u64 size);
+inline int ResolveDecode(const byte* text, u64 size, codepoint* out);
+
+// @GLOBAL
+static UTF8ValidateFunction* validateFunction = ResolveValidate;
+
+// @GLOBAL
+static UTF8CountFunction* countFunction = ResolveCount;
+
+// @GLOBAL
+static UTF8ASCIIFunction* asciiFunction = ResolveASCII;
+
+// @GLOBAL
+static UTF8DecodeFunction* decodeFunction = ResolveDecode;
+
+inline void ResolveUTF8Functions() {
+    validateFunction = ValidateScalar;
+    countFunction = CountScalar;
+    asciiFunction = IsASCIIScalar;
+    decodeFunction = DecodeScalar;
+
+#if defined(PD_X86)
+    const CPUFeatures& features = GetCPUFeatures();
+
+    if (features.sse2) {
+        countFunction = CountSSE2;
+        asciiFunction = IsASCIISSE2;
+        decodeFunction = DecodeSSE2;
+    }
+
+    if (features.ssse3) {
+        validateFunction = ValidateSSSE3;
+    }
+
+    if (features.avx2) {
+        validateFunction = ValidateAVX2;
+        countFunction = CountAVX2;
+        asciiFunction = IsASCIIAVX2;
+    }
+#endif
+}
+
+inline bool ResolveValidate(const byte* text, u64 size) {
+    ResolveUTF8Functions();
+    return validateFunction(text, size);
+}
+
+inline int ResolveCount(const byte* text, u64 size) {
+    ResolveUTF8Functions();
+    return countFunction(text, size);
+}
+
+inline bool ResolveASCII(const byte* text, u64 size) {
+    ResolveUTF8Functions();
+    return asciiFunction(text, size);
+}
+
+inline int ResolveDecode(const byte* text, u64 size, codepoint* out) {
+    ResolveUTF8Functions();
+    return decodeFunction(text, size, out);
+}
+
+bool IsValidUTF8(const uchar* text, u64 size) {
+    return validateFunction((const byte*)text, size);
+}
+
+int UTF8Count(const uchar* text, u64 size) {
+    return countFunction((const byte*)text, size);
+}
+
+bool IsASCII(const uchar* text, u64 size) {
+    return asciiFunction((const byte*)text, size);
+}
+
+int DecodeUTF8(const uchar* text, u64 size, codepoint* out) {
+    return decodeFunction((const byte*)text, size, out);
+}
+
+int DecodeUTF8Scalar(const uchar* text, u64 size, codepoint* out) {
+    return DecodeScalar((const byte*)text, size, out);
+}
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Pandora/Core/Types.h"
+
+namespace pd {
+
+/**
+ * \brief Checks the text against RFC 3629, rejecting overlong encodings,
+ * surrogates, codepoints past U+10FFFF and truncated sequences.
+ *
+ * \param text The UTF-8 text.
+ * \param size The size of the text in bytes.
+ * \return Whether or not the text is valid UTF-8.
+ */
+bool IsValidUTF8(const uchar* text, u64 size);
+
+/**
+ * \brief Counts the codepoints, assumes the text is valid UTF-8.
+ *
+ * \param text The UTF-8 text.
+ * \param size The size of the text in bytes.
+ * \return How many codepoints are in the text.
+ */
+int UTF8Count(const uchar* text, u64 size);
+
+/**
+ * \param text The text.
+ * \param size The size of the text in bytes.
+ * \return Whether or not every byte is ASCII.
+ */
+bool IsASCII(const uchar* text, u64 size);
+
+/**
+ * \brief Decodes the text to UTF-32.
+ * Every byte that doesn't start a valid sequence becomes U+FFFD, like a truncated sequence or a stray continuation byte.
+ *
+ * \param text The UTF-8 text.
+ * \param size The size of the text in bytes.
+ * \param out The output codepoints, must have room for `UTF8Count()` codepoints if the text is valid and `size` otherwise.
+ * \return How many codepoints were written.
+ */
+int DecodeUTF8(const uchar* text, u64 size, codepoint* out);
+
+/**
+ * \brief The same as `DecodeUTF8()` but never vectorized, the vectorized paths get checked against it.
+ */
+int DecodeUTF8Scalar(const uchar* text, u64 size, codepoint* out);
+
+}
@@ -1,11 +1,13 @@
 #include "Console.h"
 
 #include <cstdio>
+#include <string.h>
 
 #if defined(PD_WINDOWS)
 #include <Windows.h>
 #endif
 
+#include "Pandora/Core/Data/Memory.h"
 #include "Pandora/Core/Data/String.h"
 
 namespace pd {
@@ -32,8 +34,32 @@ const char* CON_COLOR_ANSI[] = {
 
 Console console;
 
+// The console whose lock the calling thread holds
+// @GLOBAL
+static thread_local Console* heldConsole = nullptr;
+
+Console::ReentrantLock::ReentrantLock(Console& console) : console(console) {
+    if (heldConsole == &console) return;
+
+    console.lock.Lock();
+    previous = heldConsole;
+    heldConsole = &console;
+    locked = true;
+}
+
+Console::ReentrantLock::~ReentrantLock() {
+    if (!locked) return;
+
+    heldConsole = previous;
+    console.lock.Unlock();
+}
+
 Console::Console(FILE* stream) : stream(stream) {}
 
+Console::~Console() {
+    Flush();
+}
+
 int Console::ReadByte(byte* out) {
     return 0;
 }
@@ -43,11 +69,17 @@ int Console::ReadBytes(byte* data, u64 length) {
 }
 
 int Console::WriteByte(byte b) {
-    return (int)fwrite(&b, 1, 1, stream);
+    ReentrantLock scopeLock(*this);
+    Append(&b, 1);
+
+    return 1;
 }
 
 int Console::WriteBytes(Slice<byte> bytes) {
-    return (int)fwrite(bytes.Data(), 1, bytes.SizeInBytes(), stream);
+    ReentrantLock scopeLock(*this);
+    Append(bytes.Data(), bytes.SizeInBytes());
+
+    return (int)bytes.SizeInBytes();
 }
 
 void Console::SetColorEnabled(bool isEnabled) {
@@ -58,38 +90,62 @@ bool Console::IsColorEnabled() const {
     return colorsEnabled;
 }
 
+void Console::SetFlushMode(ConsoleFlushMode mode) {
+    ReentrantLock scopeLock(*this);
+
+    flushMode = mode;
+}
+
+ConsoleFlushMode Console::FlushMode() const {
+    return flushMode;
+}
+
 void Console::SetColor(ConColor color) {
+    ReentrantLock scopeLock(*this);
+
 #if defined(PD_WINDOWS)
     // @TODO: preserve background color
 
+    // The color applies to what's written after this, so the text before it has to go out first
+    WriteBuffer(true);
     SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), (WORD)color);
 #elif defined(PD_LINUX)
-    printf("%s", CON_COLOR_ANSI[(int)color]);
+    const char* escape = CON_COLOR_ANSI[(int)color];
+    Append((const byte*)escape, strlen(escape));
 #endif
 }
 
 void Console::SetCursor(int x, int y) {
+    ReentrantLock scopeLock(*this);
+
 #if defined(PD_WINDOWS)
     COORD coords;
     coords.X = x;
     coords.Y = y;
 
+    WriteBuffer(true);
     SetConsoleCursorPosition(GetStdHandle(STD_OUTPUT_HANDLE), coords);
 #elif defined(PD_LINUX)
-    printf("\033[%d;%dH", x + 1, y + 1);
+    PrintfToStream(*this, "\033[%d;%dH", x + 1, y + 1);
 #endif
 }
 
 void Console::SetTitle(StringView title) {
+    ReentrantLock scopeLock(*this);
+
 #if defined(PD_WINDOWS)
     SetConsoleTitleW(title.ToWide());
 #elif defined(PD_LINUX)
-    printf("\033]0;%s\007", title.Data());
+    Append((const byte*)"\033]0;", 4);
+    Append((const byte*)title.Data(), title.SizeInBytes());
+    Append((const byte*)"\007", 1);
 #endif
 }
 
 void Console::Flush() {
-    fflush(stream);
+    ReentrantLock scopeLock(*this);
+
+    WriteBuffer(true);
 }
 
 void Console::Seek(i64 offset, SeekOrigin origin) {
@@ -116,4 +172,38 @@ i64 Console::Position() {
     return 0;
 }
 
+void Console::Append(const byte* data, u64 size) {
+    if (bufferUsed + size > CONSOLE_BUFFER_SIZE) {
+        WriteBuffer(flushMode == ConsoleFlushMode::Size);
+    }
+
+    if (size > CONSOLE_BUFFER_SIZE) {
+        // Too big to be worth buffering
+        fwrite(data, 1, size, stream);
+
+        if (flushMode == ConsoleFlushMode::Size) {
+            fflush(stream);
+        }
+    } else {
+        MemoryCopy(buffer + bufferUsed, data, size);
+        bufferUsed += size;
+    }
+
+    // The output stream takes care of showing the line, a terminal flushes at every line
+    if (flushMode == ConsoleFlushMode::Line && memchr(data, '\n', size)) {
+        WriteBuffer(false);
+    }
+}
+
+void Console::WriteBuffer(bool flush) {
+    if (bufferUsed > 0) {
+        fwrite(buffer, 1, bufferUsed, stream);
+        bufferUsed = 0;
+    }
+
+    if (flush) {
+        fflush(stream);
+    }
+}
+
 }
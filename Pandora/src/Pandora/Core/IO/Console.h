@@ -1,7 +1,9 @@
 #pragma once
 
 #include "Pandora/Core/IO/Stream.h"
+#include "Pandora/Core/Async/Mutex.h"
 #include "Pandora/Core/Logging/Logging.h"
+#include "Pandora/Core/Logging/AsyncLog.h"
 
 #include <cstdio>
 
@@ -27,10 +29,39 @@ enum class ConColor : byte {
     Count
 };
 
+/**
+ * \brief When the console writes its buffer to the output stream.
+ */
+enum class ConsoleFlushMode : byte {
+    // After every line, it shows up right away on a terminal
+    Line,
+
+    // Whenever the buffer is full
+    Size,
+
+    // Only when `Flush()` is called, a full buffer is handed to the output stream without flushing it
+    Manual
+};
+
+/**
+ * \brief The size of the console's write buffer in bytes.
+ */
+const int CONSOLE_BUFFER_SIZE = 8192;
+
+/**
+ * \brief Writes text to `stdout` or another `FILE`.
+ * Text and color changes are gathered in a buffer and written in one go
+ * depending on the `ConsoleFlushMode`, it's always flushed on asserts and on exit.
+ */
 class Console final : public Stream {
 public:
     Console(FILE* stream = stdout);
 
+    /**
+     * \brief Writes out whatever is left in the buffer.
+     */
+    virtual ~Console();
+
     /**
      * \brief Does nothing.
      * 
@@ -49,7 +80,7 @@ public:
     virtual int ReadBytes(byte* data, u64 length) override;
 
     /**
-     * \brief Writes a byte to the output stream.
+     * \brief Writes a byte to the buffer.
      * 
      * \param b The byte to write.
      * \return How many bytes were written.
@@ -57,7 +88,7 @@ public:
     virtual int WriteByte(byte b) override;
 
     /**
-     * \brief Writes a sequence of bytes to the output stream.
+     * \brief Writes a sequence of bytes to the buffer.
      * 
      * \param bytes The bytes to write.
      * \return How many bytes were written.
@@ -73,6 +104,21 @@ public:
      */
     template<typename... Args>
     void Log(StringView fmt, const Args&... args) {
+        ReentrantLock scopeLock(*this);
+        pd::Log(*this, fmt, args...);
+    }
+
+    /**
+     * \brief Writes a formatted string that was parsed at compile time to `stdout`.
+     * 
+     * \tparam Text The format string.
+     * \tparam Args The format arguments.
+     * \param fmt The format string.
+     * \param args The arguments.
+     */
+    template<typename Text, typename... Args>
+    void Log(FormatString<Text> fmt, const Args&... args) {
+        ReentrantLock scopeLock(*this);
         pd::Log(*this, fmt, args...);
     }
 
@@ -88,8 +134,19 @@ public:
      */
     bool IsColorEnabled() const;
 
+    /**
+     * \param mode When the buffer gets written to the output stream.
+     */
+    void SetFlushMode(ConsoleFlushMode mode);
+
+    /**
+     * \return When the buffer gets written to the output stream.
+     */
+    ConsoleFlushMode FlushMode() const;
+
     /**
      * \brief Sets the foreground color.
+     * On Linux the escape code goes into the buffer along with the text.
      * 
      * \param color The color. 
      */
@@ -111,7 +168,7 @@ public:
     void SetTitle(StringView title);
 
     /**
-     * \brief Flushes the output stream.
+     * \brief Writes the buffer to the output stream and flushes it.
      */
     virtual void Flush() override;
 
@@ -130,14 +187,54 @@ public:
     virtual i64 Position() override;
 
 private:
+    /**
+     * \brief Locks the console unless the calling thread already holds it.
+     * `Log()` holds it for the whole line, so the writes in it don't lock again
+     * and lines from different threads don't get mixed up.
+     */
+    class ReentrantLock {
+    public:
+        ReentrantLock(Console& console);
+        ~ReentrantLock();
+
+    private:
+        Console& console;
+        Console* previous = nullptr;
+        bool locked = false;
+    };
+
+    /**
+     * \brief Copies bytes into the buffer, writing it out according to the flush mode.
+     * `lock` must be held.
+     *
+     * \param data The bytes.
+     * \param size How many bytes.
+     */
+    void Append(const byte* data, u64 size);
+
+    /**
+     * \brief Hands the buffer to the output stream.
+     * `lock` must be held.
+     *
+     * \param flush Whether or not to also flush the output stream.
+     */
+    void WriteBuffer(bool flush);
+
     FILE* stream;
     bool colorsEnabled = true;
+
+    ConsoleFlushMode flushMode = ConsoleFlushMode::Line;
+
+    Mutex lock;
+
+    byte buffer[CONSOLE_BUFFER_SIZE];
+    u64 bufferUsed = 0;
 };
 
 extern Console console;
 
 #if defined(PD_DEBUG)
-#define CONSOLE_LOG_DEBUG(fmt, ...) console.Log(fmt, __VA_ARGS__);
+#define CONSOLE_LOG_DEBUG(fmt, ...) pd::asyncLog.Log(pd::LogLevel::Debug, PD_FORMAT(fmt), __VA_ARGS__);
 #else
 #define CONSOLE_LOG_DEBUG(fmt, ...)
 #endif
@@ -148,6 +245,9 @@ inline void PrintType(ConColor& type, FormatInfo& info) {
     if (&info.output == &console) {
         if (!console.IsColorEnabled()) return;
         console.SetColor(type);
+    } else if (IsLogRecord(info.output)) {
+        // The log thread changes the color when it gets to it
+        WriteLogColor(info.output, (byte)type);
     }
 }
 
@@ -46,17 +46,13 @@ u64 ReadEntireFile(StringView path, Array<byte>& out) {
 
     u64 fileSize = file.SizeInBytes();
 
-    // Make sure to resize first so that out.Data() is actually allocated
-    out.Resize((int)fileSize);
-
-    int oldCount = out.Count();
-    byte* reserveStart = out.Data() + oldCount;
-    out.Reserve((int)fileSize);
-    u64 read = file.ReadBytes(reserveStart, fileSize);
+    // No need to zero the bytes, they get overwritten right away
+    int oldCount = out.AddUninitialized((int)fileSize);
+    u64 read = file.ReadBytes(out.Data() + oldCount, fileSize);
 
     if (read < fileSize) {
         // We didn't read the same amount, shrink our reserved amount
-        out.RemoveRange(oldCount + (int)read, oldCount + (int)fileSize);
+        out.Resize(oldCount + (int)read);
     }
 
     return read;
@@ -8,12 +8,39 @@
 
 #if defined(PD_LINUX)
 #include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/stat.h>
 #endif
 
+#include "Pandora/Core/Data/Allocator.h"
+#include "Pandora/Core/Data/Memory.h"
+#include "Pandora/Core/Math/Math.h"
+
 namespace pd {
 
-FileStream::FileStream(StringView path, FileMode mode) {
-    Open(path, mode);
+#if defined(PD_LINUX)
+
+/**
+ * \param mode The file mode.
+ * \return The `open()` flags that match the `fopen()` mode of the file mode.
+ */
+inline int GetOpenFlags(FileMode mode) {
+    switch (mode) {
+        case FileMode::Read: return O_RDONLY;
+        case FileMode::Write: return O_WRONLY | O_CREAT | O_TRUNC;
+        case FileMode::ReadWrite: return O_RDWR;
+        case FileMode::Truncate: return O_RDWR | O_CREAT | O_TRUNC;
+        case FileMode::Append: return O_WRONLY | O_CREAT | O_APPEND;
+    }
+
+    return O_RDONLY;
+}
+
+#endif
+
+FileStream::FileStream(StringView path, FileMode mode, u32 bufferSize) {
+    Open(path, mode, bufferSize);
 }
 
 
@@ -21,13 +48,15 @@ FileStream::~FileStream() {
     Close();
 }
 
-bool FileStream::Open(StringView path, FileMode mode) {
+bool FileStream::Open(StringView path, FileMode mode, u32 bufferSize) {
     if (IsOpen()) {
         Close();
     }
 
     this->mode = mode;
 
+    bool buffered = bufferSize > 0;
+
     BoundedString<8> modeString;
 
     switch (mode) {
@@ -44,18 +73,64 @@ bool FileStream::Open(StringView path, FileMode mode) {
 
     _wfopen_s(&file, widePath, wideMode);
 
+    if (file && buffered) {
+        // We do the buffering ourselves
+        setvbuf(file, nullptr, _IONBF, 0);
+
+        _fseeki64(file, 0, SEEK_END);
+        fileSize = _ftelli64(file);
+    }
+
 #elif defined(PD_LINUX)
-    file = fopen(path.CStr(), modeString.CStr());
+    if (buffered) {
+        descriptor = open(path.CStr(), GetOpenFlags(mode), 0666);
+
+        struct stat info;
+        if (descriptor >= 0 && fstat(descriptor, &info) == 0) {
+            fileSize = (i64)info.st_size;
+
+            // Let the kernel read ahead more aggressively
+            posix_fadvise(descriptor, 0, 0, POSIX_FADV_SEQUENTIAL);
+        }
+    } else {
+        file = fopen(path.CStr(), modeString.CStr());
+    }
 #endif
 
+    if (IsOpen() && buffered) {
+        buffer = (byte*)Alloc(bufferSize);
+        bufferCapacity = bufferSize;
+        bufferUsed = 0;
+        dirtyStart = 0;
+        dirtyEnd = 0;
+
+        position = (mode == FileMode::Append) ? fileSize : 0;
+        bufferOffset = position;
+    }
+
     endOfFile = !IsOpen();
     return IsOpen();
 }
 
 void FileStream::Close() {
-    if (IsOpen()) {
-        Flush();
+    if (!IsOpen()) return;
+
+    Flush();
+
+    if (IsBuffered()) {
+        Free(buffer);
+        buffer = nullptr;
+        bufferCapacity = 0;
+    }
+
+#if defined(PD_LINUX)
+    if (descriptor >= 0) {
+        close(descriptor);
+        descriptor = -1;
+    }
+#endif
 
+    if (file) {
         fclose(file);
         file = nullptr;
     }
@@ -64,6 +139,16 @@ void FileStream::Close() {
 int FileStream::ReadByte(byte* out) {
     if (!CanRead() || !IsOpen()) return 0;
 
+    if (IsBuffered()) {
+        if (position >= bufferOffset && position < bufferOffset + bufferUsed) {
+            *out = buffer[position - bufferOffset];
+            position += 1;
+            return 1;
+        }
+
+        return ReadBytes(out, 1);
+    }
+
     int read = (int)fread(out, 1, 1, file);
 
     endOfFile = read != 1;
@@ -73,6 +158,41 @@ int FileStream::ReadByte(byte* out) {
 int FileStream::ReadBytes(byte* data, u64 length) {
     if (!CanRead() || !IsOpen()) return 0;
 
+    if (IsBuffered()) {
+        u64 read = 0;
+
+        while (read < length) {
+            i64 bufferEnd = bufferOffset + bufferUsed;
+
+            if (position >= bufferOffset && position < bufferEnd) {
+                u64 copySize = Min(length - read, (u64)(bufferEnd - position));
+                MemoryCopy(data + read, buffer + (position - bufferOffset), copySize);
+
+                read += copySize;
+                position += copySize;
+                continue;
+            }
+
+            // Too big to be worth going through the buffer
+            if (length - read >= bufferCapacity) {
+                WriteBuffer();
+
+                i64 readDirect = ReadAt(position, data + read, length - read);
+                if (readDirect > 0) {
+                    read += readDirect;
+                    position += readDirect;
+                }
+
+                break;
+            }
+
+            if (!FillBuffer()) break;
+        }
+
+        endOfFile = read != length;
+        return (int)read;
+    }
+
     int read = (int)fread(data, 1, length, file);
 
     endOfFile = read != (int)length;
@@ -82,12 +202,63 @@ int FileStream::ReadBytes(byte* data, u64 length) {
 int FileStream::WriteByte(byte b) {
     if (!CanWrite() || !IsOpen()) return 0;
 
+    if (IsBuffered()) {
+        return WriteBytes(Slice<byte>(&b, 1));
+    }
+
     return (int)fwrite(&b, 1, 1, file) != 0;
 }
 
 int FileStream::WriteBytes(Slice<byte> bytes) {
     if (!CanWrite() || !IsOpen()) return 0;
 
+    if (IsBuffered()) {
+        const byte* data = bytes.Data();
+        u64 length = bytes.SizeInBytes();
+        u64 written = 0;
+
+        while (written < length) {
+            // Writes can overwrite any part of the buffer or continue right after it
+            i64 start = position - bufferOffset;
+            if (start < 0 || start > (i64)bufferUsed || start >= (i64)bufferCapacity) {
+                ResetBuffer();
+
+                // Too big to be worth going through the buffer
+                if (length - written >= bufferCapacity) {
+                    i64 writtenDirect = WriteAt(position, data + written, length - written);
+                    if (writtenDirect > 0) {
+                        written += writtenDirect;
+                        position += writtenDirect;
+                    }
+
+                    bufferOffset = position;
+                    break;
+                }
+
+                continue;
+            }
+
+            u64 copySize = Min(length - written, (u64)(bufferCapacity - start));
+            MemoryCopy(buffer + start, data + written, copySize);
+
+            u32 end = (u32)(start + copySize);
+            if (dirtyStart == dirtyEnd) {
+                dirtyStart = (u32)start;
+                dirtyEnd = end;
+            } else {
+                dirtyStart = Min(dirtyStart, (u32)start);
+                dirtyEnd = Max(dirtyEnd, end);
+            }
+
+            bufferUsed = Max(bufferUsed, end);
+
+            written += copySize;
+            position += copySize;
+        }
+
+        return (int)written;
+    }
+
     return (int)fwrite(bytes.Data(), 1, bytes.SizeInBytes(), file);
 }
 
@@ -111,16 +282,37 @@ int FileStream::WriteBOM() {
 void FileStream::Flush() {
     if (!IsOpen()) return;
 
-    fflush(file);
+    if (IsBuffered()) {
+        WriteBuffer();
+    }
+
+    if (file) {
+        fflush(file);
+    }
 }
 
 void FileStream::Seek(i64 offset, SeekOrigin origin) {
     if (!CanSeek() || !IsOpen()) return;
 
-    int seek = 0;
-
     i64 oldPos = Position();
 
+    if (IsBuffered()) {
+        // Nothing happens until the next read or write, so seeks within the buffer are free
+        switch (origin) {
+            case SeekOrigin::Start:   position = offset; break;
+            case SeekOrigin::Current: position += offset; break;
+            case SeekOrigin::End:     position = SizeInBytes() + offset; break;
+        }
+
+        if (endOfFile && position < oldPos) {
+            endOfFile = false;
+        }
+
+        return;
+    }
+
+    int seek = 0;
+
     switch (origin) {
         case SeekOrigin::Start:   seek = SEEK_SET; break;
         case SeekOrigin::Current: seek = SEEK_CUR; break;
@@ -157,12 +349,20 @@ bool FileStream::EndOfFile() {
 }
 
 bool FileStream::IsOpen() {
+#if defined(PD_LINUX)
+    if (descriptor >= 0) return true;
+#endif
+
     return file != nullptr;
 }
 
 i64 FileStream::SizeInBytes() {
     if (!IsOpen()) return 0;
 
+    if (IsBuffered()) {
+        return Max(fileSize, bufferOffset + (i64)bufferUsed);
+    }
+
     i64 currentPos = Position();
 
     Seek(0, SeekOrigin::End);
@@ -175,6 +375,10 @@ i64 FileStream::SizeInBytes() {
 i64 FileStream::Position() {
     if (!IsOpen()) return 0;
 
+    if (IsBuffered()) {
+        return position;
+    }
+
     // Would it be wise to avoid ftell and instead track our own position with read/writes/seeks?
 #if defined(PD_WINDOWS)
     return _ftelli64(file);
@@ -183,4 +387,74 @@ i64 FileStream::Position() {
 #endif
 }
 
+bool FileStream::IsBuffered() const {
+    return buffer != nullptr;
+}
+
+i64 FileStream::ReadAt(i64 offset, byte* data, u64 length) {
+    u64 read = 0;
+
+#if defined(PD_WINDOWS)
+    _fseeki64(file, offset, SEEK_SET);
+    read = fread(data, 1, length, file);
+#elif defined(PD_LINUX)
+    while (read < length) {
+        ssize_t result = pread(descriptor, data + read, length - read, offset + read);
+
+        if (result < 0 && errno == EINTR) continue;
+        if (result <= 0) break;
+
+        read += (u64)result;
+    }
+#endif
+
+    return (i64)read;
+}
+
+i64 FileStream::WriteAt(i64 offset, const byte* data, u64 length) {
+    u64 written = 0;
+
+#if defined(PD_WINDOWS)
+    _fseeki64(file, offset, SEEK_SET);
+    written = fwrite(data, 1, length, file);
+#elif defined(PD_LINUX)
+    while (written < length) {
+        ssize_t result = pwrite(descriptor, data + written, length - written, offset + written);
+
+        if (result < 0 && errno == EINTR) continue;
+        if (result <= 0) break;
+
+        written += (u64)result;
+    }
+#endif
+
+    fileSize = Max(fileSize, offset + (i64)written);
+    return (i64)written;
+}
+
+void FileStream::WriteBuffer() {
+    if (dirtyEnd > dirtyStart) {
+        WriteAt(bufferOffset + dirtyStart, buffer + dirtyStart, dirtyEnd - dirtyStart);
+    }
+
+    dirtyStart = 0;
+    dirtyEnd = 0;
+}
+
+void FileStream::ResetBuffer() {
+    WriteBuffer();
+
+    bufferOffset = position;
+    bufferUsed = 0;
+}
+
+bool FileStream::FillBuffer() {
+    ResetBuffer();
+
+    i64 read = ReadAt(position, buffer, bufferCapacity);
+    bufferUsed = (read > 0) ? (u32)read : 0;
+
+    return bufferUsed > 0;
+}
+
 }
@@ -20,6 +20,19 @@ enum class FileMode : byte {
     Append
 };
 
+/**
+ * \brief A good buffer size for `FileStream`s that read or write a lot of small values.
+ */
+const u32 FILE_STREAM_BUFFER_SIZE = 256 * 1024;
+
+
+/**
+ * \brief A stream to a file on disk.
+ * By default it goes through the C standard library. When opened with a buffer size
+ * it keeps its own buffer instead, reading ahead and holding on to writes until the buffer
+ * is written out, seeks within the buffer don't touch the file at all.
+ * On Linux the buffered mode uses `pread()` and `pwrite()` and hints sequential access.
+ */
 class FileStream final : public Stream {
 public:
     FileStream() = default;
@@ -29,8 +42,9 @@ public:
      * 
      * \param path The path.
      * \param mode The mode.
+     * \param bufferSize The size of the buffer in bytes, 0 to use the C standard library's buffering.
      */
-    FileStream(StringView path, FileMode mode = FileMode::ReadWrite);
+    FileStream(StringView path, FileMode mode = FileMode::ReadWrite, u32 bufferSize = 0);
 
     virtual ~FileStream();
 
@@ -39,9 +53,10 @@ public:
      * 
      * \param path The path.
      * \param mode The mode.
+     * \param bufferSize The size of the buffer in bytes, 0 to use the C standard library's buffering.
      * \return Whether or not the file opened successfully.
      */
-    bool Open(StringView path, FileMode mode = FileMode::ReadWrite);
+    bool Open(StringView path, FileMode mode = FileMode::ReadWrite, u32 bufferSize = 0);
 
     /**
      * \brief Closes the file.
@@ -108,6 +123,20 @@ public:
         pd::Log(*this, fmt, args...);
     }
 
+    /**
+     * \brief Writes formatted UTF-8 that was parsed at compile time to the file.
+     * Mode must support writing.
+     * 
+     * \tparam Text The format string.
+     * \tparam Args The log arguments.
+     * \param fmt The format string.
+     * \param args The arguments.
+     */
+    template<typename Text, typename... Args>
+    void WriteFormat(FormatString<Text> fmt, const Args &... args) {
+        pd::Log(*this, fmt, args...);
+    }
+
     /**
      * \brief Writesthe byte-order mark at the current position.
      * Mode must support writing.
@@ -118,6 +147,7 @@ public:
 
     /**
      * \brief Flushes the file stream.
+     * In buffered mode this writes out the buffer.
      */
     virtual void Flush() override;
 
@@ -166,12 +196,70 @@ public:
      */
     virtual i64 Position() override;
 
+    /**
+     * \return Whether or not the stream keeps its own buffer.
+     */
+    bool IsBuffered() const;
 
 private:
+    /**
+     * \brief Reads from the file at an offset, without the buffer.
+     *
+     * \param offset The offset in the file.
+     * \param data Where to read the bytes into.
+     * \param length How many bytes to read.
+     * \return How many bytes were read.
+     */
+    i64 ReadAt(i64 offset, byte* data, u64 length);
+
+    /**
+     * \brief Writes to the file at an offset, without the buffer.
+     *
+     * \param offset The offset in the file.
+     * \param data The bytes to write.
+     * \param length How many bytes to write.
+     * \return How many bytes were written.
+     */
+    i64 WriteAt(i64 offset, const byte* data, u64 length);
+
+    /**
+     * \brief Writes the changed part of the buffer to the file.
+     */
+    void WriteBuffer();
+
+    /**
+     * \brief Writes out the buffer and moves it to the current position.
+     */
+    void ResetBuffer();
+
+    /**
+     * \brief Fills the buffer with the file contents at the current position.
+     *
+     * \return Whether or not anything was read.
+     */
+    bool FillBuffer();
+
     FileMode mode = FileMode::Read;
     FILE* file = nullptr;
 
     bool endOfFile = true;
+
+#if defined(PD_LINUX)
+    int descriptor = -1;
+#endif
+
+    // Buffered mode, `buffer` holds `bufferUsed` bytes of the file starting at `bufferOffset`
+    byte* buffer = nullptr;
+    u32 bufferCapacity = 0;
+    u32 bufferUsed = 0;
+    i64 bufferOffset = 0;
+
+    // The part of the buffer that was written to but not to the file yet
+    u32 dirtyStart = 0;
+    u32 dirtyEnd = 0;
+
+    i64 position = 0;
+    i64 fileSize = 0;
 };
 
 }
@@ -0,0 +1,432 @@
+#include "AsyncLog.h"
+
+#include <new>
+#include <thread>
+#include <string.h>
+
+#include "Pandora/Core/Assert.h"
+#include "Pandora/Core/Async/Lock.h"
+#include "Pandora/Core/Data/Allocator.h"
+#include "Pandora/Core/Data/Memory.h"
+#include "Pandora/Core/IO/Console.h"
+#include "Pandora/Core/Math/Math.h"
+
+namespace pd {
+
+// @GLOBAL
+AsyncLog asyncLog;
+
+// A color change in a record is this byte followed by the color with the top bit set.
+// ANSI escapes also start with it, but they're followed by a '['.
+const byte LOG_COLOR_MARKER = 0x1B;
+const byte LOG_COLOR_FLAG = 0x80;
+
+// How much the log thread gathers before writing it to the sinks
+const u64 LOG_BATCH_SIZE = 64 * 1024;
+
+/**
+ * \brief A single producer, single consumer ring buffer of records.
+ * Every record is its size as a u32 followed by the text.
+ */
+struct LogRing {
+    byte* memory = nullptr;
+    u64 mask = 0;
+
+    // Only written by the thread that owns the ring
+    std::atomic<u64> head{ 0 };
+
+    // Only written while holding the sink lock
+    std::atomic<u64> tail{ 0 };
+
+    // Set when the owning thread exits, the ring gets freed once it's drained
+    std::atomic<bool> retired{ false };
+
+    LogRing* next = nullptr;
+};
+
+/**
+ * \brief A fixed buffer that every thread formats its records into.
+ */
+class LogRecordStream final : public Stream {
+public:
+    virtual int ReadByte(byte* out) override {
+        return 0;
+    }
+
+    virtual int WriteByte(byte b) override {
+        if (size >= LOG_MAX_RECORD_SIZE) return 0;
+
+        buffer[size++] = b;
+        return 1;
+    }
+
+    virtual int WriteBytes(Slice<byte> bytes) override {
+        u64 copySize = Min(bytes.SizeInBytes(), (u64)(LOG_MAX_RECORD_SIZE - size));
+
+        MemoryCopy(buffer + size, bytes.Data(), copySize);
+        size += (int)copySize;
+
+        return (int)copySize;
+    }
+
+    virtual void Flush() override {
+        // No operation
+    }
+
+    virtual void Seek(i64 offset, SeekOrigin origin = SeekOrigin::Current) override {
+        // No operation
+    }
+
+    byte buffer[LOG_MAX_RECORD_SIZE];
+    int size = 0;
+};
+
+// Bumped when the log gets deleted, so threads know their ring is gone
+// @GLOBAL
+static std::atomic<u32> logGeneration{ 1 };
+
+struct LogThreadState {
+    ~LogThreadState() {
+        if (ring && ringGeneration == logGeneration.load(std::memory_order_acquire)) {
+            ring->retired.store(true, std::memory_order_release);
+        }
+    }
+
+    LogRecordStream record;
+
+    LogRing* ring = nullptr;
+    u32 ringGeneration = 0;
+};
+
+// @GLOBAL
+static thread_local LogThreadState threadState;
+
+inline void WriteRing(LogRing* ring, u64 position, const void* data, u64 size) {
+    u64 offset = position & ring->mask;
+    u64 firstSize = Min(size, ring->mask + 1 - offset);
+
+    MemoryCopy(ring->memory + offset, data, firstSize);
+    MemoryCopy(ring->memory, (const byte*)data + firstSize, size - firstSize);
+}
+
+inline void ReadRing(LogRing* ring, u64 position, void* out, u64 size) {
+    u64 offset = position & ring->mask;
+    u64 firstSize = Min(size, ring->mask + 1 - offset);
+
+    MemoryCopy(out, ring->memory + offset, firstSize);
+    MemoryCopy((byte*)out + firstSize, ring->memory, size - firstSize);
+}
+
+AsyncLog::~AsyncLog() {
+    Delete();
+}
+
+void AsyncLog::Create(const AsyncLogSettings& settings) {
+    Lock lock(sinkLock);
+
+    if (created) return;
+
+    this->settings = settings;
+
+    // Room for at least two records, and a power of two so positions can be masked
+    u32 bufferSize = LOG_MAX_RECORD_SIZE * 2;
+    while (bufferSize < settings.bufferSize) {
+        bufferSize *= 2;
+    }
+
+    this->settings.bufferSize = bufferSize;
+
+    minLevel = settings.level;
+    dropped = 0;
+    stopping = false;
+
+    batch = (byte*)Alloc(LOG_BATCH_SIZE);
+    batchSize = 0;
+
+    created = true;
+
+    thread.Create(LogThreadMain, this, "Pandora Log");
+}
+
+void AsyncLog::Delete() {
+    if (!created) return;
+
+    stopping = true;
+    wakeUp.Post();
+    thread.Join();
+
+    Lock lock(sinkLock);
+
+    // Anything that came in after the last batch
+    Drain();
+    created = false;
+
+    logGeneration.fetch_add(1, std::memory_order_acq_rel);
+
+    Lock ringsLock(ringLock);
+
+    LogRing* ring = rings;
+    while (ring) {
+        LogRing* next = ring->next;
+
+        Free(ring->memory);
+        ring->~LogRing();
+        Free(ring);
+
+        ring = next;
+    }
+
+    rings = nullptr;
+
+    Free(batch);
+    batch = nullptr;
+}
+
+void AsyncLog::AddSink(Stream* sink) {
+    Lock lock(sinkLock);
+
+    PD_ASSERT(sinkCount < LOG_MAX_SINKS, "too many log sinks, max. %d", LOG_MAX_SINKS);
+
+    sinks[sinkCount++] = sink;
+}
+
+void AsyncLog::RemoveSink(Stream* sink) {
+    Lock lock(sinkLock);
+
+    for (int i = 0; i < sinkCount; i++) {
+        if (sinks[i] == sink) {
+            sinks[i] = sinks[sinkCount - 1];
+            sinkCount -= 1;
+            return;
+        }
+    }
+}
+
+void AsyncLog::SetLevel(LogLevel level) {
+    minLevel = level;
+}
+
+LogLevel AsyncLog::Level() const {
+    return minLevel;
+}
+
+void AsyncLog::Flush() {
+    Lock lock(sinkLock);
+
+    if (created) {
+        Drain();
+    }
+
+    FlushSinks();
+}
+
+u64 AsyncLog::DroppedCount() const {
+    return dropped;
+}
+
+Stream& AsyncLog::BeginRecord() {
+    threadState.record.size = 0;
+    return threadState.record;
+}
+
+void AsyncLog::EndRecord() {
+    LogRecordStream& record = threadState.record;
+    u32 size = (u32)record.size;
+
+    if (!created.load(std::memory_order_acquire)) {
+        Lock lock(sinkLock);
+        WriteToSinks(record.buffer, size);
+        FlushSinks();
+        return;
+    }
+
+    LogRing* ring = GetThreadRing();
+
+    u64 capacity = ring->mask + 1;
+    u64 recordSize = sizeof(size) + size;
+    u64 head = ring->head.load(std::memory_order_relaxed);
+
+    while (capacity - (head - ring->tail.load(std::memory_order_acquire)) < recordSize) {
+        if (settings.overflow == LogOverflow::Drop) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            RequestDrain();
+            return;
+        }
+
+        RequestDrain();
+        std::this_thread::yield();
+    }
+
+    WriteRing(ring, head, &size, sizeof(size));
+    WriteRing(ring, head + sizeof(size), record.buffer, size);
+
+    ring->head.store(head + recordSize, std::memory_order_release);
+
+    // Don't wait for the interval if the buffer is filling up
+    if (head + recordSize - ring->tail.load(std::memory_order_relaxed) > capacity / 2) {
+        RequestDrain();
+    }
+}
+
+void AsyncLog::LogThreadMain(void* data) {
+    AsyncLog* log = (AsyncLog*)data;
+
+    while (!log->stopping.load(std::memory_order_acquire)) {
+        log->wakeUp.WaitTimeout(Duration(log->settings.flushInterval));
+        log->wakeRequested.store(false, std::memory_order_relaxed);
+
+        Lock lock(log->sinkLock);
+        log->Drain();
+    }
+
+    Lock lock(log->sinkLock);
+    log->Drain();
+}
+
+LogRing* AsyncLog::GetThreadRing() {
+    LogThreadState& state = threadState;
+    u32 currentGeneration = logGeneration.load(std::memory_order_acquire);
+
+    if (state.ring && state.ringGeneration == currentGeneration) {
+        return state.ring;
+    }
+
+    LogRing* ring = (LogRing*)Alloc(sizeof(LogRing));
+    new (ring) LogRing();
+
+    ring->memory = (byte*)Alloc(settings.bufferSize);
+    ring->mask = settings.bufferSize - 1;
+
+    Lock lock(ringLock);
+
+    ring->next = rings;
+    rings = ring;
+
+    state.ring = ring;
+    state.ringGeneration = currentGeneration;
+
+    return ring;
+}
+
+void AsyncLog::RequestDrain() {
+    if (!wakeRequested.exchange(true, std::memory_order_relaxed)) {
+        wakeUp.Post();
+    }
+}
+
+void AsyncLog::Drain() {
+    if (!batch) return;
+
+    bool wroteAnything = false;
+
+    Lock lock(ringLock);
+
+    LogRing** link = &rings;
+    while (*link) {
+        LogRing* ring = *link;
+
+        // Check this before reading the head, a retired ring can't get new records after it
+        bool retired = ring->retired.load(std::memory_order_acquire);
+
+        u64 tail = ring->tail.load(std::memory_order_relaxed);
+        u64 head = ring->head.load(std::memory_order_acquire);
+
+        while (tail != head) {
+            u32 size = 0;
+            ReadRing(ring, tail, &size, sizeof(size));
+
+            // Records never get split up, that keeps color markers in one piece
+            if (batchSize + size > LOG_BATCH_SIZE) {
+                WriteToSinks(batch, batchSize);
+                batchSize = 0;
+            }
+
+            ReadRing(ring, tail + sizeof(size), batch + batchSize, size);
+            batchSize += size;
+
+            tail += sizeof(size) + size;
+            wroteAnything = true;
+        }
+
+        ring->tail.store(tail, std::memory_order_release);
+
+        if (retired) {
+            *link = ring->next;
+
+            Free(ring->memory);
+            ring->~LogRing();
+            Free(ring);
+        } else {
+            link = &ring->next;
+        }
+    }
+
+    if (batchSize > 0) {
+        WriteToSinks(batch, batchSize);
+        batchSize = 0;
+    }
+
+    if (wroteAnything) {
+        FlushSinks();
+    }
+}
+
+void AsyncLog::WriteToSinks(const byte* text, u64 size) {
+    Stream* defaultSink = &console;
+
+    Stream** targets = (sinkCount > 0) ? sinks : &defaultSink;
+    int targetCount = (sinkCount > 0) ? sinkCount : 1;
+
+    const byte* end = text + size;
+
+    for (int i = 0; i < targetCount; i++) {
+        Stream* sink = targets[i];
+
+        const byte* start = text;
+        const byte* marker = text;
+
+        while (marker < end && (marker = (const byte*)memchr(marker, LOG_COLOR_MARKER, end - marker))) {
+            if (marker + 1 >= end || !(marker[1] & LOG_COLOR_FLAG)) {
+                marker += 1;
+                continue;
+            }
+
+            if (marker > start) {
+                sink->WriteBytes(Slice<byte>((byte*)start, (int)(marker - start)));
+            }
+
+            // Only the console knows what to do with colors
+            if (sink == &console && console.IsColorEnabled()) {
+                console.SetColor((ConColor)(marker[1] & ~LOG_COLOR_FLAG));
+            }
+
+            start = marker + 2;
+            marker = start;
+        }
+
+        if (end > start) {
+            sink->WriteBytes(Slice<byte>((byte*)start, (int)(end - start)));
+        }
+    }
+}
+
+void AsyncLog::FlushSinks() {
+    if (sinkCount == 0) {
+        console.Flush();
+    }
+
+    for (int i = 0; i < sinkCount; i++) {
+        sinks[i]->Flush();
+    }
+}
+
+void WriteLogColor(Stream& record, byte color) {
+    byte marker[2] = { LOG_COLOR_MARKER, (byte)(LOG_COLOR_FLAG | color) };
+    record.WriteBytes(Slice<byte>(marker, 2));
+}
+
+bool IsLogRecord(const Stream& stream) {
+    return &stream == &threadState.record;
+}
+
+}
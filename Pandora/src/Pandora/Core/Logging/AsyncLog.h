@@ -0,0 +1,248 @@
+#pragma once
+
+#include <atomic>
+
+#include "Pandora/Core/Types.h"
+#include "Pandora/Core/IO/Stream.h"
+#include "Pandora/Core/Async/Thread.h"
+#include "Pandora/Core/Async/Mutex.h"
+#include "Pandora/Core/Async/Semaphore.h"
+#include "Pandora/Core/Logging/Logging.h"
+
+namespace pd {
+
+enum class LogLevel : byte {
+    Debug,
+    Info,
+    Warning,
+    Error,
+    Count
+};
+
+/**
+ * \brief What a thread does when its log buffer is full.
+ */
+enum class LogOverflow : byte {
+    // Throw the record away and count it, never stalls the thread
+    Drop,
+
+    // Wait for the log thread to make room
+    Block
+};
+
+/**
+ * \brief How many sinks the log can write to.
+ */
+const int LOG_MAX_SINKS = 8;
+
+/**
+ * \brief The biggest a single log record can be in bytes, anything past it gets cut off.
+ */
+const int LOG_MAX_RECORD_SIZE = 4096;
+
+struct AsyncLogSettings {
+    // The size of the buffer of every thread that logs, rounded up to a power of two
+    u32 bufferSize = 256 * 1024;
+
+    LogOverflow overflow = LogOverflow::Drop;
+
+    // Records below this level are thrown away before they're formatted
+    LogLevel level = LogLevel::Debug;
+
+    // How long the log thread waits between writing batches, in milliseconds
+    u32 flushInterval = 5;
+};
+
+struct LogRing;
+
+/**
+ * \brief Logs without stalling the thread that logs.
+ * Every thread formats its records into its own ring buffer without taking any locks,
+ * a background thread writes them to the sinks in batches.
+ * Records from one thread stay in order, records from different threads can be interleaved per batch.
+ *
+ * If the log isn't created, records are written to the sinks right away on the calling thread.
+ * If there are no sinks, records go to the `console`.
+ */
+class AsyncLog {
+public:
+    ~AsyncLog();
+
+    /**
+     * \brief Starts the log thread.
+     *
+     * \param settings The settings.
+     */
+    void Create(const AsyncLogSettings& settings = AsyncLogSettings());
+
+    /**
+     * \brief Writes everything that's left, then stops the log thread and frees the buffers.
+     * Other threads shouldn't be logging anymore at this point, the `App` does this on destruction.
+     */
+    void Delete();
+
+    /**
+     * \brief Adds a stream that records get written to. It has to outlive the log.
+     *
+     * \param sink The stream.
+     */
+    void AddSink(Stream* sink);
+
+    /**
+     * \param sink The stream to stop writing to.
+     */
+    void RemoveSink(Stream* sink);
+
+    /**
+     * \param level Records below this level are thrown away.
+     */
+    void SetLevel(LogLevel level);
+
+    /**
+     * \return The lowest level that gets logged.
+     */
+    LogLevel Level() const;
+
+    /**
+     * \param level The level.
+     * \return Whether or not records of this level get logged.
+     */
+    inline bool IsEnabled(LogLevel level) const {
+        return level >= minLevel.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * \brief Writes everything that was logged before this call to the sinks and flushes them.
+     * Safe to call from an assert.
+     */
+    void Flush();
+
+    /**
+     * \return How many records were thrown away because a buffer was full.
+     */
+    u64 DroppedCount() const;
+
+    /**
+     * \brief Logs a formatted record, see `Logging.h` for the format.
+     *
+     * \param level The level of the record.
+     * \param fmt The format string.
+     * \param args The arguments.
+     */
+    template<typename... Args>
+    void Log(LogLevel level, StringView fmt, const Args&... args) {
+        if (!IsEnabled(level)) return;
+
+        pd::Log(BeginRecord(), fmt, args...);
+        EndRecord();
+    }
+
+    /**
+     * \brief Logs a formatted record using a format string that was parsed at compile time.
+     *
+     * \param level The level of the record.
+     * \param fmt The format string.
+     * \param args The arguments.
+     */
+    template<typename Text, typename... Args>
+    void Log(LogLevel level, FormatString<Text> fmt, const Args&... args) {
+        if (!IsEnabled(level)) return;
+
+        pd::Log(BeginRecord(), fmt, args...);
+        EndRecord();
+    }
+
+    /**
+     * \return The stream the current thread formats its record into.
+     */
+    Stream& BeginRecord();
+
+    /**
+     * \brief Hands the record of the current thread over to the log thread.
+     */
+    void EndRecord();
+
+private:
+    static void LogThreadMain(void* data);
+
+    /**
+     * \return The ring buffer of the current thread, creates it if needed.
+     */
+    LogRing* GetThreadRing();
+
+    /**
+     * \brief Wakes up the log thread if nobody did already.
+     */
+    void RequestDrain();
+
+    /**
+     * \brief Writes all the records in the ring buffers to the sinks.
+     * `sinkLock` must be held.
+     */
+    void Drain();
+
+    /**
+     * \brief Writes text to every sink, handling the color markers.
+     * `sinkLock` must be held.
+     *
+     * \param text The text.
+     * \param size The size of the text in bytes.
+     */
+    void WriteToSinks(const byte* text, u64 size);
+
+    /**
+     * \brief Flushes every sink.
+     * `sinkLock` must be held.
+     */
+    void FlushSinks();
+
+    AsyncLogSettings settings;
+
+    Thread thread;
+
+    std::atomic<bool> created{ false };
+    std::atomic<bool> stopping{ false };
+
+    std::atomic<LogLevel> minLevel{ LogLevel::Debug };
+    std::atomic<u64> dropped{ 0 };
+
+    // Guards the sinks, only one thread writes to them at a time
+    Mutex sinkLock;
+    Stream* sinks[LOG_MAX_SINKS] = {};
+    int sinkCount = 0;
+
+    // Guards the list of ring buffers
+    Mutex ringLock;
+    LogRing* rings = nullptr;
+
+    // Where the log thread gathers records before writing them
+    byte* batch = nullptr;
+    u64 batchSize = 0;
+
+    Semaphore wakeUp{ 0 };
+    std::atomic<bool> wakeRequested{ false };
+};
+
+extern AsyncLog asyncLog;
+
+/**
+ * \brief Writes a color change into a log record, the log thread
+ * applies it when writing to the `console` and leaves it out for other sinks.
+ *
+ * \param record The record stream.
+ * \param color The `ConColor`.
+ */
+void WriteLogColor(Stream& record, byte color);
+
+/**
+ * \param stream The stream.
+ * \return Whether or not the stream is the record stream of the current thread.
+ */
+bool IsLogRecord(const Stream& stream);
+
+/**
+ * \brief Logs a record through the `asyncLog`, the format string has to be a literal.
+ */
+#define PD_LOG(level, fmt, ...) pd::asyncLog.Log((level), PD_FORMAT(fmt),##__VA_ARGS__)
+
+}
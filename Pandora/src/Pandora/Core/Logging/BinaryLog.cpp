@@ -0,0 +1,309 @@
+#include "BinaryLog.h"
+
+#include "Pandora/Core/Assert.h"
+#include "Pandora/Core/Async/Lock.h"
+#include "Pandora/Core/Data/Allocator.h"
+#include "Pandora/Core/Data/Array.h"
+
+namespace pd {
+
+const byte BINARY_LOG_MAGIC[4] = { 'P', 'D', 'B', 'L' };
+
+// The registered format strings, an ID is the index
+// @GLOBAL
+static const char* binaryFormats[BINARY_LOG_MAX_FORMATS];
+
+// @GLOBAL
+static std::atomic<u32> binaryFormatCount{ 0 };
+
+// @GLOBAL
+static thread_local BinaryLogRecord binaryRecord;
+
+u32 RegisterBinaryFormat(const char* fmt) {
+    u32 id = binaryFormatCount.fetch_add(1, std::memory_order_relaxed);
+
+    PD_ASSERT(id < (u32)BINARY_LOG_MAX_FORMATS, "too many binary log formats, max. %d", BINARY_LOG_MAX_FORMATS);
+    PD_ASSERT(strlen(fmt) <= (u64)BINARY_LOG_MAX_FORMAT_SIZE, "binary log format is too long, max. %d bytes", BINARY_LOG_MAX_FORMAT_SIZE);
+
+    binaryFormats[id] = fmt;
+    return id;
+}
+
+const char* GetBinaryFormat(u32 id) {
+    if (id >= binaryFormatCount.load(std::memory_order_relaxed)) return nullptr;
+
+    return binaryFormats[id];
+}
+
+BinaryLog::~BinaryLog() {
+    Delete();
+}
+
+void BinaryLog::Create(Stream* output, u32 bufferSize) {
+    Delete();
+
+    Lock scopeLock(lock);
+
+    this->output = output;
+    this->bufferSize = bufferSize;
+    bufferUsed = 0;
+
+    buffer = (byte*)Alloc(bufferSize);
+
+    MemorySet(writtenFormats, sizeof(writtenFormats), 0);
+    truncated = 0;
+
+    WriteBuffered(BINARY_LOG_MAGIC, sizeof(BINARY_LOG_MAGIC));
+    WriteBuffered(&BINARY_LOG_VERSION, sizeof(BINARY_LOG_VERSION));
+}
+
+void BinaryLog::Delete() {
+    Lock scopeLock(lock);
+
+    if (!output) return;
+
+    FlushBuffer();
+    output->Flush();
+    output = nullptr;
+
+    Free(buffer);
+    buffer = nullptr;
+}
+
+void BinaryLog::Flush() {
+    Lock scopeLock(lock);
+
+    if (!output) return;
+
+    FlushBuffer();
+    output->Flush();
+}
+
+u64 BinaryLog::TruncatedCount() const {
+    return truncated;
+}
+
+BinaryLogRecord& BinaryLog::BeginRecord() {
+    binaryRecord.size = 0;
+    binaryRecord.argCount = 0;
+    binaryRecord.truncated = false;
+
+    return binaryRecord;
+}
+
+void BinaryLog::EndRecord(u32 formatID) {
+    BinaryLogRecord& record = binaryRecord;
+
+    Lock scopeLock(lock);
+
+    if (!output) return;
+
+    if (record.truncated) {
+        truncated.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // The first record of a format brings the format string along
+    u64& written = writtenFormats[formatID / 64];
+    u64 formatBit = 1ull << (formatID % 64);
+
+    if (!(written & formatBit)) {
+        const char* fmt = GetBinaryFormat(formatID);
+        u32 size = (u32)strlen(fmt);
+
+        byte entry = (byte)BinaryLogEntry::Format;
+        WriteBuffered(&entry, sizeof(entry));
+        WriteBuffered(&formatID, sizeof(formatID));
+        WriteBuffered(&size, sizeof(size));
+        WriteBuffered(fmt, size);
+
+        written |= formatBit;
+    }
+
+    byte header[6];
+    header[0] = (byte)BinaryLogEntry::Record;
+    MemoryCopy(header + 1, &formatID, sizeof(formatID));
+    header[5] = (byte)record.argCount;
+
+    WriteBuffered(header, sizeof(header));
+    WriteBuffered(record.buffer, record.size);
+}
+
+void BinaryLog::WriteBuffered(const void* data, u64 size) {
+    if (bufferUsed + size > bufferSize) {
+        FlushBuffer();
+
+        // Too big to be worth gathering
+        if (size > bufferSize) {
+            output->WriteBytes(Slice<byte>((byte*)data, (int)size));
+            return;
+        }
+    }
+
+    MemoryCopy(buffer + bufferUsed, data, size);
+    bufferUsed += (u32)size;
+}
+
+void BinaryLog::FlushBuffer() {
+    if (bufferUsed == 0) return;
+
+    output->WriteBytes(Slice<byte>(buffer, (int)bufferUsed));
+    bufferUsed = 0;
+}
+
+/**
+ * \brief Where a format string is in the decoder's text.
+ */
+struct DecodedFormat {
+    int offset = -1;
+    int size = 0;
+};
+
+/**
+ * \brief Reads a raw value and prints it like `pd::Log()` would have.
+ *
+ * \tparam T The type of the value.
+ * \param input The binary log.
+ * \param output The text output.
+ * \param fmt The format string.
+ * \param segment The segment of the value, nullptr to skip it.
+ * \return False if the log ended early.
+ */
+template<typename T>
+inline bool DecodeBinaryValue(Stream& input, Stream& output, const char* fmt, const FormatSegment* segment) {
+    T value;
+    if (input.Read(&value) != sizeof(T)) return false;
+
+    if (segment) {
+        PrintFormatArg(output, fmt, *segment, value);
+    }
+
+    return true;
+}
+
+/**
+ * \brief Reads an argument and prints it.
+ *
+ * \param input The binary log.
+ * \param output The text output.
+ * \param fmt The format string.
+ * \param segment The segment of the argument, nullptr to skip it.
+ * \return False if the argument is corrupted.
+ */
+inline bool DecodeBinaryArg(Stream& input, Stream& output, const char* fmt, const FormatSegment* segment) {
+    byte type = 0;
+    if (input.Read(&type) != sizeof(type)) return false;
+
+    switch ((BinaryArgType)type) {
+        case BinaryArgType::Text: {
+            u32 size = 0;
+            if (input.Read(&size) != sizeof(size)) return false;
+            if (size > BINARY_LOG_MAX_RECORD_SIZE) return false;
+
+            byte text[BINARY_LOG_MAX_RECORD_SIZE];
+            if (input.ReadBytes(text, size) != (int)size) return false;
+
+            if (segment && size > 0) {
+                output.WriteBytes(Slice<byte>(text, (int)size));
+            }
+
+            return true;
+        }
+
+        case BinaryArgType::Bool: return DecodeBinaryValue<bool>(input, output, fmt, segment);
+        case BinaryArgType::Char: return DecodeBinaryValue<char>(input, output, fmt, segment);
+        case BinaryArgType::I8: return DecodeBinaryValue<i8>(input, output, fmt, segment);
+        case BinaryArgType::I16: return DecodeBinaryValue<i16>(input, output, fmt, segment);
+        case BinaryArgType::I32: return DecodeBinaryValue<i32>(input, output, fmt, segment);
+        case BinaryArgType::I64: return DecodeBinaryValue<i64>(input, output, fmt, segment);
+        case BinaryArgType::U8: return DecodeBinaryValue<u8>(input, output, fmt, segment);
+        case BinaryArgType::U16: return DecodeBinaryValue<u16>(input, output, fmt, segment);
+        case BinaryArgType::U32: return DecodeBinaryValue<u32>(input, output, fmt, segment);
+        case BinaryArgType::U64: return DecodeBinaryValue<u64>(input, output, fmt, segment);
+        case BinaryArgType::F32: return DecodeBinaryValue<f32>(input, output, fmt, segment);
+        case BinaryArgType::F64: return DecodeBinaryValue<f64>(input, output, fmt, segment);
+
+        default:
+            return false;
+    }
+}
+
+bool DecodeBinaryLog(Stream& input, Stream& output) {
+    byte magic[sizeof(BINARY_LOG_MAGIC)];
+    if (input.ReadBytes(magic, sizeof(magic)) != sizeof(magic)) return false;
+    if (!MemoryCompare(magic, (void*)BINARY_LOG_MAGIC, sizeof(magic))) return false;
+
+    byte version = 0;
+    if (input.Read(&version) != sizeof(version) || version != BINARY_LOG_VERSION) return false;
+
+    Array<char> formatText(Allocator::Temporary);
+    Array<DecodedFormat> formats(Allocator::Temporary);
+
+    byte entry = 0;
+    while (input.Read(&entry) == sizeof(entry)) {
+        u32 id = 0;
+        if (input.Read(&id) != sizeof(id) || id >= (u32)BINARY_LOG_MAX_FORMATS) return false;
+
+        switch ((BinaryLogEntry)entry) {
+            case BinaryLogEntry::Format: {
+                u32 size = 0;
+                if (input.Read(&size) != sizeof(size)) return false;
+                if (size > (u32)BINARY_LOG_MAX_FORMAT_SIZE) return false;
+
+                while ((int)id >= formats.Count()) {
+                    formats.Add(DecodedFormat());
+                }
+
+                int offset = formatText.AddUninitialized((int)size);
+                if (size > 0 && input.ReadBytes((byte*)&formatText[offset], size) != (int)size) return false;
+
+                formats[id].offset = offset;
+                formats[id].size = (int)size;
+                break;
+            }
+
+            case BinaryLogEntry::Record: {
+                byte argCount = 0;
+                if (input.Read(&argCount) != sizeof(argCount)) return false;
+
+                if ((int)id >= formats.Count() || formats[id].offset < 0) return false;
+
+                const char* fmt = formatText.Data() + formats[id].offset;
+                int size = formats[id].size;
+
+                FormatSegment segment;
+                int offset = 0;
+                int argIndex = 0;
+
+                while (offset < size) {
+                    offset = ParseFormatSegment(fmt, size, offset, segment);
+                    WriteFormatText(output, fmt, segment);
+
+                    if (!segment.hasArg) continue;
+
+                    // The record was cut short when it was logged
+                    if (argIndex >= argCount) {
+                        output.WriteText("{ missing }");
+                        continue;
+                    }
+
+                    if (!DecodeBinaryArg(input, output, fmt, &segment)) return false;
+                    argIndex += 1;
+                }
+
+                // Only happens if the format doesn't match the record
+                for (; argIndex < argCount; argIndex++) {
+                    if (!DecodeBinaryArg(input, output, fmt, nullptr)) return false;
+                }
+
+                break;
+            }
+
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,418 @@
+#pragma once
+
+#include <atomic>
+
+#include "Pandora/Core/Types.h"
+#include "Pandora/Core/IO/Stream.h"
+#include "Pandora/Core/Async/Mutex.h"
+#include "Pandora/Core/Data/Memory.h"
+#include "Pandora/Core/Logging/Logging.h"
+
+//
+// The binary log format, everything is in native byte order:
+//
+// Header: 'P' 'D' 'B' 'L' followed by the version as a u8
+//
+// Then a list of entries, each starting with a `BinaryLogEntry` u8:
+//   Format: u32 id, u32 size, the format string
+//   Record: u32 id, u8 argument count, then per argument a `BinaryArgType` u8 followed by
+//           the raw value, or for text a u32 size followed by the text
+//
+// The format of a record is written the first time it's used in the stream,
+// so a log can be decoded without the program that wrote it.
+//
+
+namespace pd {
+
+/**
+ * \brief How many different format strings can be logged in binary.
+ */
+const int BINARY_LOG_MAX_FORMATS = 4096;
+
+/**
+ * \brief The biggest a single binary record can be in bytes, arguments past it are left out.
+ */
+const int BINARY_LOG_MAX_RECORD_SIZE = 4096;
+
+/**
+ * \brief The longest a format string logged in binary can be in bytes.
+ * Also keeps the decoder from trusting a corrupted size.
+ */
+const int BINARY_LOG_MAX_FORMAT_SIZE = 65536;
+
+const byte BINARY_LOG_VERSION = 1;
+
+enum class BinaryLogEntry : byte {
+    Format = 1,
+    Record
+};
+
+/**
+ * \brief How an argument is stored in a binary record.
+ */
+enum class BinaryArgType : byte {
+    // Already formatted, printed as is
+    Text,
+    Bool,
+    Char,
+    I8,
+    I16,
+    I32,
+    I64,
+    U8,
+    U16,
+    U32,
+    U64,
+    F32,
+    F64,
+    Count
+};
+
+/**
+ * \brief Registers a format string for binary logging, use `BinaryFormatID()` instead.
+ *
+ * \param fmt The format string, it has to live for the rest of the program.
+ * \return The ID of the format string.
+ */
+u32 RegisterBinaryFormat(const char* fmt);
+
+/**
+ * \param id The ID of the format string.
+ * \return The registered format string.
+ */
+const char* GetBinaryFormat(u32 id);
+
+/**
+ * \brief The ID of a `PD_FORMAT()` format string, registered once per call site.
+ *
+ * \tparam Text The format string.
+ * \return The ID of the format string.
+ */
+template<typename Text>
+inline u32 BinaryFormatID() {
+    static const u32 id = RegisterBinaryFormat(Text::Get());
+    return id;
+}
+
+/**
+ * \brief A single binary record while it's being assembled.
+ * Formatted text for arguments gets written into it through the `Stream` interface.
+ */
+class BinaryLogRecord final : public Stream {
+public:
+    virtual int ReadByte(byte* out) override {
+        return 0;
+    }
+
+    virtual int WriteByte(byte b) override {
+        if (size >= BINARY_LOG_MAX_RECORD_SIZE) {
+            truncated = true;
+            return 0;
+        }
+
+        buffer[size++] = b;
+        return 1;
+    }
+
+    virtual int WriteBytes(Slice<byte> bytes) override {
+        int copySize = (int)bytes.SizeInBytes();
+        if (copySize > BINARY_LOG_MAX_RECORD_SIZE - size) {
+            copySize = BINARY_LOG_MAX_RECORD_SIZE - size;
+            truncated = true;
+        }
+
+        MemoryCopy(buffer + size, bytes.Data(), copySize);
+        size += copySize;
+
+        return copySize;
+    }
+
+    virtual void Flush() override {
+        // No operation
+    }
+
+    virtual void Seek(i64 offset, SeekOrigin origin = SeekOrigin::Current) override {
+        // No operation
+    }
+
+    /**
+     * \param bytes How many bytes are going to be written.
+     * \return Whether or not they fit.
+     */
+    inline bool HasRoom(int bytes) const {
+        return size + bytes <= BINARY_LOG_MAX_RECORD_SIZE;
+    }
+
+    byte buffer[BINARY_LOG_MAX_RECORD_SIZE];
+    int size = 0;
+
+    // How many arguments were written
+    int argCount = 0;
+
+    // Set when an argument didn't fit
+    bool truncated = false;
+};
+
+/**
+ * \brief Writes a raw value with its type.
+ *
+ * \param record The record.
+ * \param type The type of the value.
+ * \param value The value.
+ * \param size The size of the value in bytes.
+ */
+inline void WriteBinaryValue(BinaryLogRecord& record, BinaryArgType type, const void* value, int size) {
+    if (!record.HasRoom(1 + size)) {
+        record.truncated = true;
+        return;
+    }
+
+    record.buffer[record.size] = (byte)type;
+    MemoryCopy(record.buffer + record.size + 1, value, size);
+    record.size += 1 + size;
+    record.argCount += 1;
+}
+
+/**
+ * \brief Writes an argument into a binary record.
+ * Types without a binary form are formatted right away using `PrintType()`
+ * and stored as text, add a specialization to store a type raw.
+ *
+ * \tparam T The type of the argument.
+ * \param record The record.
+ * \param fmt The format string.
+ * \param segment The segment the argument belongs to.
+ * \param arg The argument.
+ */
+template<typename T>
+inline void WriteBinaryArg(BinaryLogRecord& record, const char* fmt, const FormatSegment& segment, T& arg) {
+    const int headerSize = 1 + sizeof(u32);
+
+    if (!record.HasRoom(headerSize)) {
+        record.truncated = true;
+        return;
+    }
+
+    int start = record.size;
+    record.size += headerSize;
+
+    PrintFormatArg(record, fmt, segment, arg);
+
+    u32 textSize = (u32)(record.size - start - headerSize);
+    record.buffer[start] = (byte)BinaryArgType::Text;
+    MemoryCopy(record.buffer + start + 1, &textSize, sizeof(textSize));
+    record.argCount += 1;
+}
+
+template<>
+inline void WriteBinaryArg(BinaryLogRecord& record, const char* fmt, const FormatSegment& segment, bool& arg) {
+    WriteBinaryValue(record, BinaryArgType::Bool, &arg, sizeof(arg));
+}
+
+template<>
+inline void WriteBinaryArg(BinaryLogRecord& record, const char* fmt, const FormatSegment& segment, char& arg) {
+    WriteBinaryValue(record, BinaryArgType::Char, &arg, sizeof(arg));
+}
+
+template<>
+inline void WriteBinaryArg(BinaryLogRecord& record, const char* fmt, const FormatSegment& segment, i8& arg) {
+    WriteBinaryValue(record, BinaryArgType::I8, &arg, sizeof(arg));
+}
+
+template<>
+inline void WriteBinaryArg(BinaryLogRecord& record, const char* fmt, const FormatSegment& segment, i16& arg) {
+    WriteBinaryValue(record, BinaryArgType::I16, &arg, sizeof(arg));
+}
+
+template<>
+inline void WriteBinaryArg(BinaryLogRecord& record, const char* fmt, const FormatSegment& segment, i32& arg) {
+    WriteBinaryValue(record, BinaryArgType::I32, &arg, sizeof(arg));
+}
+
+template<>
+inline void WriteBinaryArg(BinaryLogRecord& record, const char* fmt, const FormatSegment& segment, i64& arg) {
+    WriteBinaryValue(record, BinaryArgType::I64, &arg, sizeof(arg));
+}
+
+template<>
+inline void WriteBinaryArg(BinaryLogRecord& record, const char* fmt, const FormatSegment& segment, u8& arg) {
+    WriteBinaryValue(record, BinaryArgType::U8, &arg, sizeof(arg));
+}
+
+template<>
+inline void WriteBinaryArg(BinaryLogRecord& record, const char* fmt, const FormatSegment& segment, u16& arg) {
+    WriteBinaryValue(record, BinaryArgType::U16, &arg, sizeof(arg));
+}
+
+template<>
+inline void WriteBinaryArg(BinaryLogRecord& record, const char* fmt, const FormatSegment& segment, u32& arg) {
+    WriteBinaryValue(record, BinaryArgType::U32, &arg, sizeof(arg));
+}
+
+template<>
+inline void WriteBinaryArg(BinaryLogRecord& record, const char* fmt, const FormatSegment& segment, u64& arg) {
+    WriteBinaryValue(record, BinaryArgType::U64, &arg, sizeof(arg));
+}
+
+template<>
+inline void WriteBinaryArg(BinaryLogRecord& record, const char* fmt, const FormatSegment& segment, f32& arg) {
+    WriteBinaryValue(record, BinaryArgType::F32, &arg, sizeof(arg));
+}
+
+template<>
+inline void WriteBinaryArg(BinaryLogRecord& record, const char* fmt, const FormatSegment& segment, f64& arg) {
+    WriteBinaryValue(record, BinaryArgType::F64, &arg, sizeof(arg));
+}
+
+/**
+ * \brief The implementation of the binary logging function.
+ *
+ * \param record The record.
+ * \param fmt The format string.
+ * \param spec The parsed format string.
+ * \param index The index of the next segment.
+ */
+inline void WriteBinaryArgs(BinaryLogRecord& record, const char* fmt, const FormatSpec& spec, int index) {
+    // No operation
+}
+
+/**
+ * \brief The implementation of the binary logging function.
+ *
+ * \tparam Arg0 The current argument to write.
+ * \tparam Args The rest of the arguments.
+ * \param record The record.
+ * \param fmt The format string.
+ * \param spec The parsed format string.
+ * \param index The index of the next segment.
+ * \param arg0 The current argument to write.
+ * \param args The remaining arguments.
+ */
+template<typename Arg0, typename... Args>
+inline void WriteBinaryArgs(BinaryLogRecord& record, const char* fmt, const FormatSpec& spec, int index,
+                            const Arg0& arg0, const Args&... args) {
+    // The arguments are stored by position, skipping one would shift the rest into the wrong segments.
+    // Stop at the first one that didn't fit so the decoder prints the remaining ones as missing.
+    if (record.truncated) return;
+
+    while (!spec.segments[index].hasArg) {
+        index += 1;
+    }
+
+    WriteBinaryArg(record, fmt, spec.segments[index], (Arg0&)arg0);
+    WriteBinaryArgs(record, fmt, spec, index + 1, args...);
+}
+
+/**
+ * \brief Logs records in a compact binary form instead of text.
+ * Only the format ID and the raw arguments get written, the text is put
+ * together later by `DecodeBinaryLog()` or the LogDecoder tool.
+ * Safe to log to from multiple threads.
+ */
+class BinaryLog {
+public:
+    ~BinaryLog();
+
+    /**
+     * \brief Starts a new binary log and writes the header.
+     *
+     * \param output The stream to write to, it has to outlive the log.
+     * \param bufferSize How many bytes are gathered before they're written to the stream.
+     */
+    void Create(Stream* output, u32 bufferSize = 64 * 1024);
+
+    /**
+     * \brief Writes what's left and stops using the stream.
+     * This is called on destruction.
+     */
+    void Delete();
+
+    /**
+     * \brief Writes everything that was logged to the stream and flushes it.
+     */
+    void Flush();
+
+    /**
+     * \brief Logs a record, see `Logging.h` for the format.
+     *
+     * \tparam Text The format string.
+     * \tparam Args The log arguments.
+     * \param fmt The format string, from `PD_FORMAT()`.
+     * \param args The arguments.
+     */
+    template<typename Text, typename... Args>
+    void Log(FormatString<Text> fmt, const Args&... args) {
+        static_assert(!FormatString<Text>::spec.malformed, "format string has a { or } without a match, use {{ and }} to escape them");
+        static_assert(!FormatString<Text>::spec.tooLong, "format string has too many segments, raise FORMAT_MAX_SEGMENTS");
+        static_assert(FormatString<Text>::spec.argCount == sizeof...(Args), "format string expects a different number of arguments");
+        static_assert(sizeof...(Args) < 256, "too many arguments for a binary record");
+
+        if (!output) return;
+
+        BinaryLogRecord& record = BeginRecord();
+        WriteBinaryArgs(record, Text::Get(), FormatString<Text>::spec, 0, args...);
+        EndRecord(BinaryFormatID<Text>());
+    }
+
+    /**
+     * \return How many records were cut short because they didn't fit.
+     */
+    u64 TruncatedCount() const;
+
+private:
+    /**
+     * \return The record of the current thread.
+     */
+    BinaryLogRecord& BeginRecord();
+
+    /**
+     * \brief Writes the record of the current thread.
+     *
+     * \param formatID The ID of the format string.
+     */
+    void EndRecord(u32 formatID);
+
+    /**
+     * \brief Gathers bytes into the buffer, writing it to the stream when it's full.
+     * `lock` must be held.
+     *
+     * \param data The bytes.
+     * \param size How many bytes.
+     */
+    void WriteBuffered(const void* data, u64 size);
+
+    /**
+     * \brief Writes the buffer to the stream.
+     * `lock` must be held.
+     */
+    void FlushBuffer();
+
+    Stream* output = nullptr;
+
+    Mutex lock;
+
+    byte* buffer = nullptr;
+    u32 bufferSize = 0;
+    u32 bufferUsed = 0;
+
+    // Which formats were already written to the stream
+    u64 writtenFormats[BINARY_LOG_MAX_FORMATS / 64] = {};
+
+    std::atomic<u64> truncated{ 0 };
+};
+
+/**
+ * \brief Turns a binary log back into text.
+ *
+ * \param input The binary log.
+ * \param output The stream to write the text to.
+ * \return False if the log is not a binary log or is corrupted, everything up to the error is written.
+ */
+bool DecodeBinaryLog(Stream& input, Stream& output);
+
+/**
+ * \brief Logs a record to a `BinaryLog`, the format string has to be a literal.
+ */
+#define PD_LOG_BINARY(log, fmt, ...) (log).Log(PD_FORMAT(fmt),##__VA_ARGS__)
+
+}
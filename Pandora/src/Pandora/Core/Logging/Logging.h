@@ -23,132 +23,335 @@
 //
 // Example:
 //   {#.-123X} : Pretty print as hexadecimal with a precision of -123
+//
+// Wrap a literal format string in PD_FORMAT() to parse it at compile time,
+// that also checks that the number of arguments matches:
+//   pd::Log(out, PD_FORMAT("{} + {} = {}\n"), a, b, a + b);
 
 namespace pd {
 
 /**
- * \brief The implementation of the logging function.
- * 
- * \param out The stream to log it to.
- * \param remainingFormat The remaining format string.
+ * \brief How many segments a `PD_FORMAT()` format string can be split into.
  */
-void LogInternal(Stream& out, const char* remainingFormat);
+const int FORMAT_MAX_SEGMENTS = 64;
 
 /**
- * \brief The implementation of the logging function.
- * 
- * \tparam Arg0 The current argument to print.
- * \tparam Args The rest of the arguments.
- * \param out The stream to log it to.
- * \param remainingFormat The remaining format string.
- * \param arg0 The current argument to print.
- * \param args The remaining arguments.
+ * \brief A run of literal text, optionally followed by a `{}` specifier.
  */
-template<typename Arg0, typename... Args>
-inline void LogInternal(Stream& out, const char* remainingFormat, const Arg0& arg0, const Args&... args) {
-    int formatLength = (int)strlen(remainingFormat);
+struct FormatSegment {
+    // The literal text as an offset into the format string
+    int textOffset = 0;
+    int textSize = 0;
 
-    FormatInfo info(out);
-    bool parsingParam = false;
-    for (int i = 0; i < formatLength; i++) {
-        if (remainingFormat[i] == '{') {
-            if (i + 1 < formatLength && remainingFormat[i + 1] == '{') {
-                out.WriteByte('{');
-                i += 1;
-                continue;
-            }
+    // Whether or not an argument gets printed after the text
+    bool hasArg = false;
 
-            info.raw = remainingFormat + i;
-            info.rawLength = i;
+    // The specifier from the { up to the }
+    int rawOffset = 0;
+    int rawLength = 0;
 
-            parsingParam = true;
-        } else if (remainingFormat[i] == '}') {
-            if (i + 1 < formatLength && remainingFormat[i + 1] == '}') {
-                out.WriteByte('}');
-                i += 1;
-                continue;
-            }
+    DisplayBase base = DisplayBase::NotSpecified;
+    bool pretty = false;
+    bool precisionSpecified = false;
+    int precision = 0;
 
-            if (parsingParam) {
-                info.rawLength = i - info.rawLength;
+    // Set if there was a { without a } or a } without a {, those are printed as text
+    bool malformed = false;
+};
 
-                parsingParam = false;
-                PrintType((Arg0&)arg0, info);
-                LogInternal(out, remainingFormat + i + 1, args...);
-                return;
-            }
-        } else if (parsingParam) {
+/**
+ * \brief Parses what's inside of a `{}`.
+ *
+ * \param fmt The format string.
+ * \param size The size of the format string in bytes.
+ * \param offset The offset after the {.
+ * \param out The segment to store the specifier in.
+ * \return The offset of the }, -1 if there is none.
+ */
+constexpr int ParseFormatSpecifier(const char* fmt, int size, int offset, FormatSegment& out) {
+    for (int i = offset; i < size; i++) {
+        switch (fmt[i]) {
+            case '}':
+                return i;
 
-            switch (remainingFormat[i]) {
-                // Decimal
-                case 'D':
-                    info.base = DisplayBase::Decimal;
-                    break;
+            // Decimal
+            case 'D':
+                out.base = DisplayBase::Decimal;
+                break;
 
-                // Octal
-                case 'O':
-                    info.base = DisplayBase::Octal;
-                    break;
+            // Octal
+            case 'O':
+                out.base = DisplayBase::Octal;
+                break;
 
-                // Hexadecimal
-                case 'X':
-                    info.base = DisplayBase::Hexadecimal;
-                    break;
+            // Hexadecimal
+            case 'X':
+                out.base = DisplayBase::Hexadecimal;
+                break;
 
-                case '#':
-                    info.pretty = true;
-                    break;
+            case '#':
+                out.pretty = true;
+                break;
 
-                // Precision
-                case '.':
-                    char buffer[255];
-                    int bufferWrite = 0;
+            // Precision
+            case '.': {
+                bool positive = true;
+                if (i + 1 < size && fmt[i + 1] == '-') {
+                    positive = false;
+                    i += 1;
+                }
 
+                int precision = 0;
+                while (i + 1 < size && fmt[i + 1] >= '0' && fmt[i + 1] <= '9') {
+                    precision = precision * 10 + (fmt[i + 1] - '0');
                     i += 1;
+                }
+
+                out.precisionSpecified = true;
+                out.precision = (positive) ? precision : -precision;
+                break;
+            }
+        }
+    }
 
-                    bool positive = true;
-                    if (remainingFormat[i] == '-') {
-                        positive = false;
-                        i += 1;
-                    }
+    return -1;
+}
 
-                    while (remainingFormat[i] >= '0' && remainingFormat[i] <= '9') {
-                        buffer[bufferWrite] = remainingFormat[i++];
+/**
+ * \brief Parses the next segment of the format string, works at compile time as well.
+ * Escaped braces end the text of a segment, so the text can be written in one go.
+ *
+ * \param fmt The format string.
+ * \param size The size of the format string in bytes.
+ * \param offset The offset to start parsing at.
+ * \param out The parsed segment.
+ * \return The offset after the segment.
+ */
+constexpr int ParseFormatSegment(const char* fmt, int size, int offset, FormatSegment& out) {
+    out = FormatSegment();
+    out.textOffset = offset;
 
-                        if (++bufferWrite >= 254) {
-                            break;
-                        }
-                    }
-                    buffer[bufferWrite] = '\0';
+    for (int i = offset; i < size; i++) {
+        char c = fmt[i];
 
-                    info.precisionSpecified = true;
-                    info.precision = (int)strtol(buffer, nullptr, 10) * ((positive) ? 1 : -1);
+        if (c != '{' && c != '}') continue;
 
-                    i -= 1;
-                    break;
-            }
+        // Keep the first of the two braces as text
+        if (i + 1 < size && fmt[i + 1] == c) {
+            out.textSize = i + 1 - offset;
+            return i + 2;
+        }
 
-        } else {
-            out.WriteByte((remainingFormat + i)[0]);
+        if (c == '}') {
+            out.malformed = true;
+            continue;
         }
+
+        int end = ParseFormatSpecifier(fmt, size, i + 1, out);
+
+        if (end < 0) {
+            out.malformed = true;
+            break;
+        }
+
+        out.textSize = i - offset;
+        out.hasArg = true;
+        out.rawOffset = i;
+        out.rawLength = end - i;
+
+        return end + 1;
     }
+
+    out.textSize = size - offset;
+    return size;
 }
 
 /**
- * \brief Prints a formatted string to the specified stream.
- * This variant gets called when no additional arguments are supplied.
+ * \brief A format string split into segments.
+ */
+struct FormatSpec {
+    FormatSegment segments[FORMAT_MAX_SEGMENTS] = {};
+    int segmentCount = 0;
+
+    // How many arguments the format string expects
+    int argCount = 0;
+
+    bool malformed = false;
+    bool tooLong = false;
+};
+
+/**
+ * \param fmt The null-terminated format string.
+ * \return The parsed format string.
+ */
+constexpr FormatSpec ParseFormat(const char* fmt) {
+    FormatSpec spec{};
+
+    int size = 0;
+    while (fmt[size]) {
+        size += 1;
+    }
+
+    int offset = 0;
+    while (offset < size) {
+        if (spec.segmentCount == FORMAT_MAX_SEGMENTS) {
+            spec.tooLong = true;
+            break;
+        }
+
+        FormatSegment& segment = spec.segments[spec.segmentCount];
+        offset = ParseFormatSegment(fmt, size, offset, segment);
+
+        spec.segmentCount += 1;
+        spec.argCount += (segment.hasArg) ? 1 : 0;
+        spec.malformed = spec.malformed || segment.malformed;
+    }
+
+    return spec;
+}
+
+/**
+ * \brief A format string that was parsed at compile time, create it with `PD_FORMAT()`.
+ *
+ * \tparam Text A type with a `static constexpr const char* Get()` that returns the format string.
+ */
+template<typename Text>
+struct FormatString {
+    static constexpr FormatSpec spec = ParseFormat(Text::Get());
+};
+
+template<typename Text>
+constexpr FormatSpec FormatString<Text>::spec;
+
+/**
+ * \brief Parses a literal format string at compile time.
+ */
+#define PD_FORMAT(text) \
+    ([]() { \
+        struct FormatText { \
+            static constexpr const char* Get() { return text; } \
+        }; \
+        return ::pd::FormatString<FormatText>(); \
+    }())
+
+/**
+ * \brief Writes the literal text of the segment.
+ *
+ * \param out The stream to log it to.
+ * \param fmt The format string.
+ * \param segment The segment.
+ */
+inline void WriteFormatText(Stream& out, const char* fmt, const FormatSegment& segment) {
+    if (segment.textSize > 0) {
+        out.WriteBytes(Slice<byte>((byte*)fmt + segment.textOffset, segment.textSize));
+    }
+}
+
+/**
+ * \brief Prints the argument of the segment.
+ *
+ * \tparam T The type of the argument.
+ * \param out The stream to log it to.
+ * \param fmt The format string.
+ * \param segment The segment.
+ * \param arg The argument.
+ */
+template<typename T>
+inline void PrintFormatArg(Stream& out, const char* fmt, const FormatSegment& segment, const T& arg) {
+    FormatInfo info(out);
+    info.raw = fmt + segment.rawOffset;
+    info.rawLength = segment.rawLength;
+    info.base = segment.base;
+    info.pretty = segment.pretty;
+    info.precisionSpecified = segment.precisionSpecified;
+    info.precision = segment.precision;
+
+    PrintType((T&)arg, info);
+}
+
+/**
+ * \brief The implementation of the logging function.
+ * Prints `{ missing }` for every `{}` that is left.
  * 
- * \tparam Args The log arguments.
  * \param out The stream to log it to.
  * \param fmt The format string.
+ * \param size The size of the format string in bytes.
+ * \param offset The offset of the remaining format string.
  */
-template<typename... Args>
-inline void Log(Stream& out, StringView fmt) {
-    LogInternal(out, fmt.CStr());
+void LogInternal(Stream& out, const char* fmt, int size, int offset);
+
+/**
+ * \brief The implementation of the logging function.
+ * 
+ * \tparam Arg0 The current argument to print.
+ * \tparam Args The rest of the arguments.
+ * \param out The stream to log it to.
+ * \param fmt The format string.
+ * \param size The size of the format string in bytes.
+ * \param offset The offset of the remaining format string.
+ * \param arg0 The current argument to print.
+ * \param args The remaining arguments.
+ */
+template<typename Arg0, typename... Args>
+inline void LogInternal(Stream& out, const char* fmt, int size, int offset, const Arg0& arg0, const Args&... args) {
+    FormatSegment segment;
+
+    while (offset < size) {
+        offset = ParseFormatSegment(fmt, size, offset, segment);
+        WriteFormatText(out, fmt, segment);
+
+        if (segment.hasArg) {
+            PrintFormatArg(out, fmt, segment, arg0);
+            LogInternal(out, fmt, size, offset, args...);
+            return;
+        }
+    }
+}
+
+/**
+ * \brief The implementation of the logging function for parsed format strings.
+ *
+ * \param out The stream to log it to.
+ * \param fmt The format string.
+ * \param spec The parsed format string.
+ * \param index The index of the next segment.
+ */
+inline void LogSegments(Stream& out, const char* fmt, const FormatSpec& spec, int index) {
+    for (; index < spec.segmentCount; index++) {
+        WriteFormatText(out, fmt, spec.segments[index]);
+    }
+}
+
+/**
+ * \brief The implementation of the logging function for parsed format strings.
+ *
+ * \tparam Arg0 The current argument to print.
+ * \tparam Args The rest of the arguments.
+ * \param out The stream to log it to.
+ * \param fmt The format string.
+ * \param spec The parsed format string.
+ * \param index The index of the next segment.
+ * \param arg0 The current argument to print.
+ * \param args The remaining arguments.
+ */
+template<typename Arg0, typename... Args>
+inline void LogSegments(Stream& out, const char* fmt, const FormatSpec& spec, int index,
+                        const Arg0& arg0, const Args&... args) {
+    for (; index < spec.segmentCount; index++) {
+        const FormatSegment& segment = spec.segments[index];
+        WriteFormatText(out, fmt, segment);
+
+        if (segment.hasArg) {
+            PrintFormatArg(out, fmt, segment, arg0);
+            LogSegments(out, fmt, spec, index + 1, args...);
+            return;
+        }
+    }
 }
 
 /**
  * \brief Prints a formatted string to the specified stream.
+ * The format string gets parsed while printing, use `PD_FORMAT()` for literals.
  * 
  * \tparam Args The log arguments.
  * \param out The stream to log it to.
@@ -157,7 +360,25 @@ inline void Log(Stream& out, StringView fmt) {
  */
 template<typename... Args>
 inline void Log(Stream& out, StringView fmt, const Args&... args) {
-    LogInternal(out, fmt.CStr(), args...);
+    LogInternal(out, fmt.CStr(), (int)fmt.SizeInBytes(), 0, args...);
+}
+
+/**
+ * \brief Prints a formatted string that was parsed at compile time to the specified stream.
+ * 
+ * \tparam Text The format string.
+ * \tparam Args The log arguments.
+ * \param out The stream to log it to.
+ * \param fmt The format string.
+ * \param args The arguments.
+ */
+template<typename Text, typename... Args>
+inline void Log(Stream& out, FormatString<Text> fmt, const Args&... args) {
+    static_assert(!FormatString<Text>::spec.malformed, "format string has a { or } without a match, use {{ and }} to escape them");
+    static_assert(!FormatString<Text>::spec.tooLong, "format string has too many segments, raise FORMAT_MAX_SEGMENTS");
+    static_assert(FormatString<Text>::spec.argCount == sizeof...(Args), "format string expects a different number of arguments");
+
+    LogSegments(out, Text::Get(), FormatString<Text>::spec, 0, args...);
 }
 
 }
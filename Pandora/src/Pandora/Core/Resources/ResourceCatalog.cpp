@@ -66,17 +66,17 @@ void ResourceCatalog::Delete() {
 void ResourceCatalog::DeleteResource(ResourceType type, StringView name, bool forceFree) {
     TypeCatalog* catalog = &catalogs[(int)type];
 
-    String nameStr = name.ToString();
-    Ref<Resource>& rscPtr = catalog->Get(&nameStr);
+    Ref<Resource>* rscPtr = catalog->Find(name);
+    if (!rscPtr) return;
 
     if (forceFree) {
-        rscPtr.Delete();
+        rscPtr->Delete();
     } else {
-        rscPtr.ChangeType(RefType::Weak);
+        rscPtr->ChangeType(RefType::Weak);
     }
 
-    if (!rscPtr) {
-        catalog->Remove(&name);
+    if (!*rscPtr) {
+        catalog->Remove(name);
     }
 }
 
@@ -3,6 +3,7 @@
 #include "Pandora/Core/Data/Dictionary.h"
 #include "Pandora/Core/Data/Array.h"
 #include "Pandora/Core/Data/Reference.h"
+#include "Pandora/Core/Data/Name.h"
 
 #include "Pandora/Core/Resources/Resource.h"
 
@@ -96,6 +97,17 @@ public:
     template<typename T>
     Ref<T> Get(StringView name);
 
+    /**
+     * \brief Gets a resource from the box.
+     * Uses the hash stored in the name, so nothing gets hashed.
+     * 
+     * \tparam T The resource type.
+     * \param name The resource name.
+     * \return A new reference to the resource.
+     */
+    template<typename T>
+    Ref<T> Get(Name name);
+
     /**
      * \brief Gets the uncompressed data of the specified resource.
      * 
@@ -116,6 +128,18 @@ public:
                                    void* data = nullptr);
 
 private:
+
+    /**
+     * \brief Gets a resource from the box, loading it if it isn't in the catalog yet.
+     * 
+     * \tparam T The resource type.
+     * \param name The resource name.
+     * \param hash The `DoHash()` hash of the name.
+     * \return A new reference to the resource.
+     */
+    template<typename T>
+    Ref<T> GetHashed(StringView name, u64 hash);
+
     Box box;
 
     OnRequestResource* onRequestResource[(int)ResourceType::Count];
@@ -132,16 +156,27 @@ inline void ResourceCatalog::DeleteResource(StringView name, bool forceFree) {
 
 template<typename T>
 inline Ref<T> ResourceCatalog::Get(StringView name) {
+    return GetHashed<T>(name, DoHash(name));
+}
+
+template<typename T>
+inline Ref<T> ResourceCatalog::Get(Name name) {
+    return GetHashed<T>(name.View(), name.Hash());
+}
+
+template<typename T>
+inline Ref<T> ResourceCatalog::GetHashed(StringView name, u64 hash) {
     static_assert(std::is_base_of<Resource, T>::value, "Template type T must derive from pd::Resource");
 
     ResourceType type = T::GetType();
     TypeCatalog* catalog = &catalogs[(int)type];
 
-    String nameStr = name.ToString();
-    Ref<Resource>& rsc = catalog->Get(nameStr);
+    // Looks up with the view so only a miss allocates the key
+    Ref<Resource>& rsc = catalog->Get(name, hash);
 
     // Use handler to Load it if there is no data in this reference
     if (!rsc.Get()) {
+        ScopedMemoryTag tag(MemoryTag::Resources);
         rsc.Reset(onRequestResource[(int)type](box, type, name, requestUserData[(int)type]));
     }
 
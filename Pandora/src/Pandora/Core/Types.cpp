@@ -1,5 +1,8 @@
 #include "Types.h"
 
+#include <string.h>
+
+#include "Pandora/Core/Encoding/UTF8.h"
 #include "Pandora/Libs/utf8/utf8.h"
 
 namespace pd {
@@ -29,15 +32,15 @@ uchar* GetNextCodepoint(const uchar* string, codepoint* out) {
 }
 
 bool IsValidUTF8(const uchar* string) {
-    return utf8valid(string) == nullptr;
+    return IsValidUTF8(string, strlen((const char*)string));
 }
 
 int UTF8Size(const uchar* string) {
-    return (int)utf8size(string);
+    return (int)strlen((const char*)string) + 1;
 }
 
 int UTF8Count(const uchar* string) {
-    return (int)utf8len(string);
+    return UTF8Count(string, strlen((const char*)string));
 }
 
 }
@@ -15,14 +15,24 @@ int WINAPI WinMain(HINSTANCE instance, HINSTANCE prevInstance, LPSTR args, int s
 int main(int argc, char** argv) {
 #endif
 
+#if defined(PD_TRACK_LEAKS)
+    // Remember where every allocation was made so leaks can be reported at exit
+    pd::EnableLeakTracking(true);
+#endif
+
     pd::App* app = pd::CreateApp(argc, argv);
     app->Run();
     pd::Delete(app);
 
     pd::u64 allocated = pd::GetAllocatedBytes();
+    if (allocated > 0 && pd::IsLeakTracking()) {
+        pd::ReportLeaks();
+    }
+
     PD_ASSERT_D(allocated == 0, "we're leaking %llu bytes", allocated);
 
     pd::DeleteTemporaryAllocator();
+    pd::DeletePoolAllocator();
 
     return 0;
 }
@@ -68,86 +68,87 @@ bool FTFont::Load(Box& box, StringView name) {
 }
 
 Glyph* FTFont::GetGlyph(codepoint point) {
-    if (!glyphs.Contains(point)) {
-        u32 glyphIndex = FT_Get_Char_Index(face, point);
+    Glyph* cached = glyphs.Find(point);
+    if (cached) return cached;
 
-        if (FT_Load_Glyph(face, glyphIndex, FT_LOAD_DEFAULT | FT_LOAD_COLOR) != 0) {
-            return nullptr;
-        }
+    u32 glyphIndex = FT_Get_Char_Index(face, point);
 
-        if (FT_Render_Glyph(face->glyph, FT_RENDER_MODE_LCD) != 0) {
-            return nullptr;
-        }
+    if (FT_Load_Glyph(face, glyphIndex, FT_LOAD_DEFAULT | FT_LOAD_COLOR) != 0) {
+        return nullptr;
+    }
 
-        Glyph glyph;
+    if (FT_Render_Glyph(face->glyph, FT_RENDER_MODE_LCD) != 0) {
+        return nullptr;
+    }
 
-        Vec2i size = Vec2i(face->glyph->bitmap.width, face->glyph->bitmap.rows);
+    Glyph glyph;
 
-        Color* colors = nullptr;
-        if (size.x * size.y > 0) {
-            colors = (Color*)Alloc((u64)size.x * size.y * sizeof(Color));
-            MemorySet(colors, (u64)size.x * size.y * sizeof(Color), 0);
+    Vec2i size = Vec2i(face->glyph->bitmap.width, face->glyph->bitmap.rows);
 
-            switch (face->glyph->bitmap.pixel_mode) {
-                case FT_PIXEL_MODE_LCD: {
-                    // Width is 3x the size in LCD mode
-                    size.x /= 3;
-                    
-                    int colorY = size.y - 1;
-                    for (int y = 0; y < size.y; y++) {
-                        for (int x = 0; x < size.x * 3; x += 3) {
-                            int i = y * face->glyph->bitmap.pitch + x;
+    Color* colors = nullptr;
+    if (size.x * size.y > 0) {
+        colors = (Color*)Alloc((u64)size.x * size.y * sizeof(Color));
+        MemorySet(colors, (u64)size.x * size.y * sizeof(Color), 0);
 
-                            f32 r = face->glyph->bitmap.buffer[i + 0] / 255.0f;
-                            f32 g = face->glyph->bitmap.buffer[i + 1] / 255.0f;
-                            f32 b = face->glyph->bitmap.buffer[i + 2] / 255.0f;
+        switch (face->glyph->bitmap.pixel_mode) {
+            case FT_PIXEL_MODE_LCD: {
+                // Width is 3x the size in LCD mode
+                size.x /= 3;
+                
+                int colorY = size.y - 1;
+                for (int y = 0; y < size.y; y++) {
+                    for (int x = 0; x < size.x * 3; x += 3) {
+                        int i = y * face->glyph->bitmap.pitch + x;
 
-                            colors[colorY * size.x + (x / 3)] = Color(r, g, b, (r + g + b) / 3.0f);
-                        }
-                        colorY -= 1;
+                        f32 r = face->glyph->bitmap.buffer[i + 0] / 255.0f;
+                        f32 g = face->glyph->bitmap.buffer[i + 1] / 255.0f;
+                        f32 b = face->glyph->bitmap.buffer[i + 2] / 255.0f;
+
+                        colors[colorY * size.x + (x / 3)] = Color(r, g, b, (r + g + b) / 3.0f);
                     }
-                    break;
+                    colorY -= 1;
                 }
+                break;
+            }
 
-                case FT_PIXEL_MODE_BGRA: {
-                    int colorY = size.y - 1;
-                    for (int y = 0; y < size.y; y++) {
-                        for (int x = 0; x < size.x * 4; x += 4) {
-                            int i = y * face->glyph->bitmap.pitch + x;
+            case FT_PIXEL_MODE_BGRA: {
+                int colorY = size.y - 1;
+                for (int y = 0; y < size.y; y++) {
+                    for (int x = 0; x < size.x * 4; x += 4) {
+                        int i = y * face->glyph->bitmap.pitch + x;
 
-                            f32 b = face->glyph->bitmap.buffer[i + 0] / 255.0f;
-                            f32 g = face->glyph->bitmap.buffer[i + 1] / 255.0f;
-                            f32 r = face->glyph->bitmap.buffer[i + 2] / 255.0f;
-                            f32 a = face->glyph->bitmap.buffer[i + 3] / 255.0f;
+                        f32 b = face->glyph->bitmap.buffer[i + 0] / 255.0f;
+                        f32 g = face->glyph->bitmap.buffer[i + 1] / 255.0f;
+                        f32 r = face->glyph->bitmap.buffer[i + 2] / 255.0f;
+                        f32 a = face->glyph->bitmap.buffer[i + 3] / 255.0f;
 
-                            colors[colorY * size.x + (x / 4)] = Color(r, g, b, a);
-                        }
-                        colorY -= 1;
+                        colors[colorY * size.x + (x / 4)] = Color(r, g, b, a);
                     }
-
-                    glyph.hasColor = true;
-                    break;
+                    colorY -= 1;
                 }
 
-                default: {
-                    CONSOLE_LOG_DEBUG("[{}FreeType Error{}] unhandled pixel mode '{}'",
-                        ConColor::Red, ConColor::Grey, face->glyph->bitmap.pixel_mode);
-                    break;
-                }
+                glyph.hasColor = true;
+                break;
             }
-        }
 
-        PackGlyph(Slice<Color>(colors, size.x * size.y), size.x, glyph);
-        glyph.size = size;
-        glyph.bearing = Vec2((f32)face->glyph->metrics.horiBearingX, (f32)face->glyph->metrics.horiBearingY) / 64.0f;
-        glyph.advance = (f32)face->glyph->metrics.horiAdvance / 64.0f;
+            default: {
+                CONSOLE_LOG_DEBUG("[{}FreeType Error{}] unhandled pixel mode '{}'",
+                    ConColor::Red, ConColor::Grey, face->glyph->bitmap.pixel_mode);
+                break;
+            }
+        }
+    }
 
-        Free(colors);
+    PackGlyph(Slice<Color>(colors, size.x * size.y), size.x, glyph);
+    glyph.size = size;
+    glyph.bearing = Vec2((f32)face->glyph->metrics.horiBearingX, (f32)face->glyph->metrics.horiBearingY) / 64.0f;
+    glyph.advance = (f32)face->glyph->metrics.horiAdvance / 64.0f;
 
-        glyphs.Set(point, glyph);
-    }
+    Free(colors);
 
-    return &glyphs.Get(point);
+    Glyph& inserted = glyphs.Get(point);
+    inserted = glyph;
+    return &inserted;
 }
 
 Vec2 FTFont::GetKerning(codepoint left, codepoint right) {
@@ -132,8 +132,8 @@ void LineRenderer::DrawCircle(Vec2 center, f32 radius, Color color, int vertexCo
 }
 
 void LineRenderer::DrawSolidCircle(Vec2 center, f32 radius, Color color, int vertexCount, f32 depth) {
-    int s = vertices.Count();
-    vertices.Reserve(vertexCount + 1);
+    // Every vertex gets written below
+    int s = vertices.AddUninitialized(vertexCount + 1);
     vertices[s].position = center;
     vertices[s].position.z = depth;
     vertices[s].color = color;
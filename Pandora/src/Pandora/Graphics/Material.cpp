@@ -45,6 +45,10 @@ void Material::SetTexture(StringView name, int slot) {
     AfterSetTexture(slot);
 }
 
+void Material::SetTexture(Name name, int slot) {
+    SetTexture(catalog.Get<Texture>(name), slot);
+}
+
 void Material::SetTexture(const Ref<Texture>& texture, int slot) {
     if (slot < 0 || slot >= PD_MAX_TEXTURE_UNITS) {
         CONSOLE_LOG_DEBUG("[{}Material Error{}] {} is not a valid texture slot (min. 0, max. {})\n",
@@ -42,6 +42,14 @@ public:
      */
     void SetTexture(StringView name, int slot);
 
+    /**
+     * \brief Sets the texture of the specified slot.
+     * 
+     * \param name The texture resource name.
+     * \param slot The slot.
+     */
+    void SetTexture(Name name, int slot);
+
     /**
      * \brief Sets the texture of the specified slot.
      * 
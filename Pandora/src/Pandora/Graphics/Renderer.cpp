@@ -9,6 +9,8 @@ void Renderer::DrawQuad(void* data) {
 }
 
 void Renderer::DrawQuads(void* data, int quadCount) {
+    ScopedMemoryTag tag(MemoryTag::Renderer);
+
     GenerateIndices(quadCount);
 
     int vertexCountInBytes = shader->GetLayout().GetStride() * 4 * quadCount;
@@ -16,10 +18,12 @@ void Renderer::DrawQuads(void* data, int quadCount) {
 }
 
 void Renderer::DrawIndexed(void* vertexData, int vertexCount, Slice<u32> indexData, bool relativeIndices) {
+    ScopedMemoryTag tag(MemoryTag::Renderer);
 
     int vertexSize = shader->GetLayout().GetDefaultStride();
 
     if (relativeIndices && indices.Count() > 0) {
+        ScopedArena scope;
         Array<u32> absIndices(Allocator::Temporary);
         absIndices.AddRange(indexData);
     
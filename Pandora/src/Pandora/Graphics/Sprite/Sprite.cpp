@@ -13,7 +13,7 @@ void GetSpriteVertexLayout(DataLayout& layout) {
     layout.Finish();
 }
 
-Sprite::Sprite(Sprite& other) {
+Sprite::Sprite(const Sprite& other) {
     position = other.position;
     color = other.color;
     size = other.size;
@@ -27,7 +27,7 @@ void GetSpriteVertexLayout(DataLayout& layout);
 class Sprite {
 public:
     Sprite() = default;
-    Sprite(Sprite& other);
+    Sprite(const Sprite& other);
     ~Sprite() = default;
 
     /**
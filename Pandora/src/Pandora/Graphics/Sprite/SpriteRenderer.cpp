@@ -1,5 +1,6 @@
 #include "SpriteRenderer.h"
 
+#include "Pandora/Core/Async/Parallel.h"
 #include "Pandora/Graphics/VideoAPI.h"
 
 namespace pd {
@@ -11,7 +12,7 @@ struct SpriteBatch {
     Material* material = nullptr;
 };
 
-SpriteRenderer::SpriteRenderer() {
+SpriteRenderer::SpriteRenderer() : vertices(Allocator::Persistent, 32) {
     VideoAPI* video = VideoAPI::Get();
     renderer = video->GetRenderer();
     mvpBuffer = video->CreateConstantBuffer();
@@ -38,12 +39,17 @@ void SpriteRenderer::Draw(const Sprite& sprite) {
 void SpriteRenderer::Render() {
     if (sprites.Count() == 0) return;
 
-    sprites.Sort([](const Sprite& a, const Sprite& b) {
-        return a.position.z < b.position.z;
+    // Radix sort is linear even when the sprites are already in order, which they usually are,
+    // and it's stable so sprites at the same depth keep the order they were drawn in.
+    // Big scenes get sorted on the workers, small ones stay on this thread
+    ParallelRadixSort(sprites, [](const Sprite& sprite) {
+        return sprite.position.z;
     });
 
-    Array<SpriteVertex> vertices;
-    vertices.Reserve(sprites.Count() * 4);
+    // The vertex buffer is kept around so it only grows when there are more sprites than ever before,
+    // all vertices get generated below so they don't need to be constructed
+    vertices.Clear();
+    vertices.AddUninitialized(sprites.Count() * 4);
 
     Array<SpriteBatch> batches;
     SpriteBatch currBatch = {};
@@ -78,6 +78,9 @@ private:
 
     // We might want a seperate array of pointers to sort because it'll be quicker.
     Array<Sprite> sprites;
+
+    // Reused every frame, aligned for SIMD vertex generation
+    Array<SpriteVertex> vertices;
 };
 
 }
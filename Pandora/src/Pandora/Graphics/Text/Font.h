@@ -1,7 +1,7 @@
 #pragma once
 
 #include "Pandora/Core/Data/Reference.h"
-#include "Pandora/Core/Data/Dictionary.h"
+#include "Pandora/Core/Data/FlatMap.h"
 #include "Pandora/Core/Resources/Resource.h"
 
 #include "Pandora/Graphics/TexturePacker.h"
@@ -121,7 +121,7 @@ protected:
      */
     void PackGlyph(Slice<Color> pixels, int stride, Glyph& glyph);
 
-    Dictionary<codepoint, Glyph> glyphs;
+    FlatMap<codepoint, Glyph> glyphs;
 
     /**
      * \brief All the glyph pages.
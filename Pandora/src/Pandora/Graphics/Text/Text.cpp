@@ -1,7 +1,19 @@
 #include "Text.h"
 
+#include "Pandora/Core/Encoding/UTF8.h"
+
 namespace pd {
 
+// Decodes the whole text at once instead of stepping the iterator, the codepoints are temporary
+inline Slice<codepoint> DecodeText(const String& text) {
+    StringView view = text.View();
+
+    codepoint* points = (codepoint*)Alloc((view.SizeInBytes() + 1) * sizeof(codepoint), Allocator::Temporary);
+    int count = DecodeUTF8(view.Data(), view.SizeInBytes(), points);
+
+    return Slice<codepoint>(points, count);
+}
+
 // @TODO: BBCode style tags (bold, color, effects, icons)
 // @TODO: proper layout engine so we can support RTL, Arabic and more
 
@@ -22,20 +34,24 @@ void Text::Draw(SpriteRenderer& renderer) {
 }
 
 void Text::GenerateSprites() {
+    ScopedMemoryTag tag(MemoryTag::Text);
+
+    Slice<codepoint> points = DecodeText(text);
+
     letters.Clear();
+    letters.ReserveCapacity(points.Count());
 
-    for (int i = 0; i < text.Count(); i++) {
-        codepoint point = text[i];
+    for (codepoint point : points) {
         Glyph* g = font->GetGlyph(point);
 
         if (!g) continue;
 
-        letters.Reserve(1);
-        letters.Last().point = point;
+        Letter& letter = letters.EmplaceBack();
+        letter.point = point;
 
-        letters.Last().sprite.Load(font->GetGlyphTexture(*g), spriteMat);
-        letters.Last().sprite.size = g->size;
-        letters.Last().sprite.SetNormalizedClippingMask(g->uv);
+        letter.sprite.Load(font->GetGlyphTexture(*g), spriteMat);
+        letter.sprite.size = g->size;
+        letter.sprite.SetNormalizedClippingMask(g->uv);
     }
 
     UpdateProperties();
@@ -82,8 +98,12 @@ Vec2 Text::CalculateBounds() {
     Vec2 penPos = Vec2(0.0f, font->GetAscender() * scale.y);
     f32 xMax = 0.0f;
 
-    for (int i = 0; i < text.Count(); ++i) {
-        if (text[i] == '\n') {
+    Slice<codepoint> points = DecodeText(text);
+
+    for (int i = 0; i < points.Count(); i++) {
+        codepoint point = points[i];
+
+        if (point == '\n') {
             penPos.y += f32(font->GetHeight()) * scale.y;
 
             if (penPos.x > xMax) {
@@ -96,12 +116,12 @@ Vec2 Text::CalculateBounds() {
 
         // Add kerning
         Vec2 kerning = Vec2(0.0f);
-        if (i + 1 < text.Count()) {
-            kerning = font->GetKerning(text[i], text[i + 1]);
+        if (i + 1 < points.Count()) {
+            kerning = font->GetKerning(point, points[i + 1]);
             kerning.x += kerning.x * scale.x;
         }
 
-        Glyph* g = font->GetGlyph(text[i]);
+        Glyph* g = font->GetGlyph(point);
 
         if (!g) continue;
 
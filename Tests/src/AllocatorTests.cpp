@@ -0,0 +1,84 @@
+#include <Pandora/Core/Data/Allocator.h>
+#include <Pandora/Core/Data/Memory.h>
+
+#include "Tests.h"
+
+using namespace pd;
+
+// Growing a block from before a marker must not let the marker release it
+static void TestTemporaryGrowAcrossMarker() {
+    const int OLD_SIZE = 64;
+    const int NEW_SIZE = 256;
+
+    byte* block = (byte*)Alloc(OLD_SIZE, Allocator::Temporary);
+    MemorySet(block, OLD_SIZE, 0xAB);
+
+    TemporaryMarker marker = PushTemporaryMarker();
+
+    block = (byte*)Realloc(block, NEW_SIZE, Allocator::Temporary);
+    MemorySet(block + OLD_SIZE, NEW_SIZE - OLD_SIZE, 0xAB);
+
+    PopTemporaryMarker(marker);
+
+    // Reuses whatever the marker released
+    byte* after = (byte*)Alloc(NEW_SIZE, Allocator::Temporary);
+    MemorySet(after, NEW_SIZE, 0x11);
+
+    bool intact = true;
+    for (int i = 0; i < NEW_SIZE; i++) {
+        intact &= block[i] == 0xAB;
+    }
+
+    TEST_CHECK(intact);
+    TEST_CHECK(IsTemporaryAllocationValid(block));
+}
+
+// Both scopes were empty when the block grew, neither of them may release it
+static void TestTemporaryGrowAcrossNestedMarkers() {
+    byte* block = (byte*)Alloc(32, Allocator::Temporary);
+    MemorySet(block, 32, 0xCE);
+
+    {
+        ScopedArena outer;
+        ScopedArena inner;
+
+        block = (byte*)Realloc(block, 1024, Allocator::Temporary);
+        MemorySet(block + 32, 1024 - 32, 0xCE);
+
+        // Lives in the inner scope, after the block
+        byte* scoped = (byte*)Alloc(64, Allocator::Temporary);
+        TEST_CHECK(scoped > block + 1024);
+    }
+
+    Alloc(1024, Allocator::Temporary);
+
+    bool intact = true;
+    for (int i = 0; i < 1024; i++) {
+        intact &= block[i] == 0xCE;
+    }
+
+    TEST_CHECK(intact);
+}
+
+// The last block inside the innermost scope still grows in place
+static void TestTemporaryGrowInScope() {
+    ScopedArena arena;
+    ResetTemporaryStats();
+
+    byte* block = (byte*)Alloc(64, Allocator::Temporary);
+    byte* grown = (byte*)Realloc(block, 4096, Allocator::Temporary);
+
+    TEST_CHECK(grown == block);
+    TEST_CHECK(GetTemporaryStats().inPlaceGrows == 1);
+    TEST_CHECK(GetTemporaryStats().copyingGrows == 0);
+}
+
+void TestAllocator() {
+    ResetTemporaryAllocator();
+
+    TestTemporaryGrowAcrossMarker();
+    TestTemporaryGrowAcrossNestedMarkers();
+    TestTemporaryGrowInScope();
+
+    ResetTemporaryAllocator();
+}
@@ -0,0 +1,42 @@
+#include <Pandora/Core/Data/Hash.h>
+#include <Pandora/Core/Data/Name.h>
+#include <Pandora/Core/Data/Dictionary.h>
+
+#include "Tests.h"
+
+using namespace pd;
+
+// The literal has to be usable where only constants are
+static_assert("Shaders/Sprite"_hash != 0, "the literal hash must be a compile-time constant");
+static_assert(""_hash == HashString("", 0), "the literal must use HashString()");
+
+static void TestLiteralMatchesDoHash() {
+    // Covers an empty text, a partial word and texts that span several words
+    const char* TEXTS[] = { "", "a", "Menu", "Shaders/Sprite", "Textures/Tiles/tile_0.png" };
+
+    for (const char* text : TEXTS) {
+        u64 hash = HashString(text, StringView(text).SizeInBytes());
+
+        TEST_CHECK(DoHash(String(text)) == hash);
+        TEST_CHECK(DoHash(StringView(text)) == hash);
+        TEST_CHECK(Name(text).Hash() == hash);
+    }
+
+    TEST_CHECK(DoHash(String("Shaders/Sprite")) == "Shaders/Sprite"_hash);
+    TEST_CHECK(DoHash(StringView("Menu")) == "Menu"_hash);
+}
+
+static void TestLiteralFindsStringKeys() {
+    Dictionary<String, int> scenes;
+    scenes.Insert(String("Menu"), 1);
+    scenes.Insert(String("Game"), 2);
+
+    int* game = scenes.Find(StringView("Game"), "Game"_hash);
+    TEST_CHECK(game && *game == 2);
+    TEST_CHECK(scenes.Find(StringView("Pause"), "Pause"_hash) == nullptr);
+}
+
+void TestHash() {
+    TestLiteralMatchesDoHash();
+    TestLiteralFindsStringKeys();
+}
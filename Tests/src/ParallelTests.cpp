@@ -0,0 +1,136 @@
+#include <Pandora/Core/Async/Parallel.h>
+#include <Pandora/Core/Data/String.h>
+#include <Pandora/Core/Math/Random.h>
+
+#include "Tests.h"
+
+using namespace pd;
+
+// Enough elements that the parallel sort doesn't hand them to RadixSort
+static const int PARALLEL_SORT_COUNT = PARALLEL_RADIX_SORT_MIN_COUNT * 3 + 123;
+
+struct SortItem {
+    f32 depth;
+    int order;
+};
+
+struct NamedItem {
+    i32 depth;
+    String name;
+};
+
+static bool SortedStably(const Array<SortItem>& items) {
+    for (int i = 1; i < items.Count(); i++) {
+        if (items[i].depth < items[i - 1].depth) return false;
+        if (items[i].depth == items[i - 1].depth && items[i].order < items[i - 1].order) return false;
+    }
+
+    return true;
+}
+
+static bool SameItems(const Array<SortItem>& a, const Array<SortItem>& b) {
+    if (a.Count() != b.Count()) return false;
+
+    for (int i = 0; i < a.Count(); i++) {
+        if (a[i].depth != b[i].depth || a[i].order != b[i].order) return false;
+    }
+
+    return true;
+}
+
+static void FillItems(Array<SortItem>& items, int count, u64 distinctDepths) {
+    items.Clear();
+
+    for (int i = 0; i < count; i++) {
+        SortItem item;
+        item.depth = (f32)pd::random.Range(0, distinctDepths) - (f32)(distinctDepths / 2);
+        item.order = i;
+        items.Add(item);
+    }
+}
+
+static void TestParallelRadixSortMatchesRadixSort() {
+    auto key = [](const SortItem& item) { return item.depth; };
+
+    // Few depths make every pass move, many depths make some passes skip
+    const u64 DISTINCT_DEPTHS[] = { 8, 1000, 1u << 30 };
+
+    // The default grain, uneven chunks and a single chunk that falls back to RadixSort
+    const int GRAIN_SIZES[] = { 0, 4097, PARALLEL_SORT_COUNT };
+
+    Array<SortItem> items;
+    Array<SortItem> expected;
+
+    for (u64 distinct : DISTINCT_DEPTHS) {
+        for (int grainSize : GRAIN_SIZES) {
+            FillItems(items, PARALLEL_SORT_COUNT, distinct);
+            expected = items;
+
+            ParallelOptions options;
+            options.grainSize = grainSize;
+
+            ParallelRadixSort(items, key, options);
+            expected.RadixSort(key);
+
+            TEST_CHECK(SortedStably(items));
+            TEST_CHECK(SameItems(items, expected));
+        }
+    }
+}
+
+static void TestParallelRadixSortOrderedInput() {
+    auto key = [](const SortItem& item) { return item.depth; };
+
+    Array<SortItem> items;
+    for (int i = 0; i < PARALLEL_SORT_COUNT; i++) {
+        items.Add(SortItem{ (f32)(i / 3), i });
+    }
+
+    Array<SortItem> expected = items;
+    ParallelRadixSort(items, key);
+    TEST_CHECK(SameItems(items, expected));
+
+    // Only the last element is out of place, which is a chunk the others can't see
+    items.Last().depth = -1.0f;
+    ParallelRadixSort(items, key);
+    TEST_CHECK(SortedStably(items));
+    TEST_CHECK(items[0].order == PARALLEL_SORT_COUNT - 1);
+}
+
+static void TestParallelRadixSortMovesElements() {
+    Array<NamedItem> items;
+
+    for (int i = 0; i < PARALLEL_SORT_COUNT; i++) {
+        NamedItem item;
+        item.depth = (i32)pd::random.Range(0, 64) - 32;
+        item.name.Format("item {}", item.depth);
+        items.Add(std::move(item));
+    }
+
+    ParallelRadixSort(items, [](const NamedItem& item) { return item.depth; });
+
+    bool sorted = true;
+    bool namesFollowed = true;
+    String expectedName;
+
+    for (int i = 0; i < items.Count(); i++) {
+        if (i > 0 && items[i].depth < items[i - 1].depth) sorted = false;
+
+        expectedName.Format("item {}", items[i].depth);
+        if (items[i].name != expectedName) namesFollowed = false;
+    }
+
+    TEST_CHECK(sorted);
+    TEST_CHECK(namesFollowed);
+}
+
+void TestParallel() {
+    // This runs on machines with a single core too, extra workers still run the chunks concurrently
+    workerPool.Create(3);
+
+    pd::random.Seed(1234);
+
+    TestParallelRadixSortMatchesRadixSort();
+    TestParallelRadixSortOrderedInput();
+    TestParallelRadixSortMovesElements();
+}
@@ -0,0 +1,108 @@
+#include <Pandora/Core/Data/String.h>
+
+#include "Tests.h"
+
+using namespace pd;
+
+// A long text so the string can't keep it inline
+static const char* LONG_TEXT = "a string that is too long to be stored inline";
+
+static void TestMoveEmptyString() {
+    String empty;
+
+    String heap(LONG_TEXT);
+    heap = std::move(empty);
+    TEST_CHECK(heap.Count() == 0);
+    TEST_CHECK(heap == "");
+
+    String inlined("short");
+    inlined = String();
+    TEST_CHECK(inlined.Count() == 0);
+    TEST_CHECK(inlined == "");
+
+    // Different allocators never hand over the buffer
+    String temporary(LONG_TEXT, Allocator::Temporary);
+    temporary = String();
+    TEST_CHECK(temporary.Count() == 0);
+
+    BoundedString<64> bounded(LONG_TEXT);
+    bounded = String();
+    TEST_CHECK(bounded.Count() == 0);
+
+    // The string is still usable afterwards
+    heap.Append("text");
+    TEST_CHECK(heap == "text");
+}
+
+static void TestCopyEmptyString() {
+    String empty;
+
+    String heap(LONG_TEXT);
+    heap = empty;
+    TEST_CHECK(heap.Count() == 0);
+    TEST_CHECK(heap == "");
+}
+
+// Grows a string one character at a time past the inline buffer, it moves to the heap on the way
+static void TestGrowPastInline() {
+    const char* ALPHABET = "abcdefghijklmnopqrstuvwxyz0123456789";
+
+    String text;
+    for (int i = 0; ALPHABET[i]; i++) {
+        text.Append((codepoint)ALPHABET[i]);
+
+        TEST_CHECK(text.Count() == i + 1);
+        TEST_CHECK(StringView(text.Data(), i + 1) == StringView(ALPHABET, i + 1));
+    }
+
+    // Multi-byte codepoints that end right at the edge of the inline buffer
+    String accented;
+    for (int i = 0; i < STRING_INLINE_SIZE; i++) {
+        accented.Append((codepoint)0xE9);
+        TEST_CHECK(accented.Count() == i + 1);
+        TEST_CHECK(StringView(accented).SizeInBytes() == (u64)(i + 1) * 2);
+    }
+
+    TEST_CHECK(accented[STRING_INLINE_SIZE - 1] == 0xE9);
+}
+
+static void TestMoveInlineAndHeap() {
+    String inlined("short");
+    String heap(LONG_TEXT);
+
+    String movedInline(std::move(inlined));
+    String movedHeap(std::move(heap));
+    TEST_CHECK(movedInline == "short");
+    TEST_CHECK(movedHeap == LONG_TEXT);
+
+    // Swap their places so each one gets overwritten by the other kind
+    String temp(std::move(movedInline));
+    movedInline = std::move(movedHeap);
+    movedHeap = std::move(temp);
+    TEST_CHECK(movedInline == LONG_TEXT);
+    TEST_CHECK(movedHeap == "short");
+
+    String copy = movedInline;
+    copy.Append("!");
+    TEST_CHECK(movedInline == LONG_TEXT);
+    TEST_CHECK(copy.Count() == movedInline.Count() + 1);
+}
+
+static void TestBoundedString() {
+    BoundedString<64> bounded("short");
+    TEST_CHECK(bounded == "short");
+
+    bounded.Append(" and then some more text");
+    TEST_CHECK(bounded == "short and then some more text");
+
+    bounded.Set(LONG_TEXT);
+    TEST_CHECK(bounded == LONG_TEXT);
+}
+
+void TestString() {
+    TestMoveEmptyString();
+    TestCopyEmptyString();
+    TestGrowPastInline();
+    TestMoveInlineAndHeap();
+    TestBoundedString();
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <Pandora/Core/Types.h>
+
+// A failed check gets printed and counted, the test runner fails if any did.
+#define TEST_CHECK(expr) CheckTest((expr), #expr, __FILE__, __LINE__)
+
+void CheckTest(bool passed, const char* expr, const char* file, int line);
+
+int FailedChecks();
+
+void TestAllocator();
+void TestString();
+void TestParallel();
+void TestHash();
+void TestUTF8();
@@ -0,0 +1,162 @@
+#include <Pandora/Core/Data/Array.h>
+#include <Pandora/Core/Encoding/UTF8.h>
+#include <Pandora/Core/Math/Random.h>
+
+#include "Tests.h"
+
+using namespace pd;
+
+// How many random texts get decoded both ways
+const int UTF8_RANDOM_RUNS = 20000;
+
+// Appends the codepoint as UTF-8
+static void AppendUTF8(Array<byte>& text, codepoint point) {
+    if (point < 0x80) {
+        text.Add((byte)point);
+    } else if (point < 0x800) {
+        text.Add((byte)(0xC0 | (point >> 6)));
+        text.Add((byte)(0x80 | (point & 0x3F)));
+    } else if (point < 0x10000) {
+        text.Add((byte)(0xE0 | (point >> 12)));
+        text.Add((byte)(0x80 | ((point >> 6) & 0x3F)));
+        text.Add((byte)(0x80 | (point & 0x3F)));
+    } else {
+        text.Add((byte)(0xF0 | (point >> 18)));
+        text.Add((byte)(0x80 | ((point >> 12) & 0x3F)));
+        text.Add((byte)(0x80 | ((point >> 6) & 0x3F)));
+        text.Add((byte)(0x80 | (point & 0x3F)));
+    }
+}
+
+// Mostly ASCII runs, so the vectorized path sees whole ASCII blocks as well as mixed ones
+static codepoint RandomCodepoint() {
+    switch (pd::random.Range(0, 8)) {
+    case 0: return (codepoint)pd::random.Range(0x80, 0x800);
+    case 1: return (codepoint)pd::random.Range(0x800, 0xD800);
+    case 2: return (codepoint)pd::random.Range(0xE000, 0x10000);
+    case 3: return (codepoint)pd::random.Range(0x10000, 0x110000);
+    default: return (codepoint)pd::random.Range(0, 0x80);
+    }
+}
+
+static bool DecodesTheSame(const Array<byte>& text) {
+    Array<codepoint> simd;
+    Array<codepoint> scalar;
+    simd.AddUninitialized(text.Count() + 1);
+    scalar.AddUninitialized(text.Count() + 1);
+
+    int simdCount = DecodeUTF8(text.Data(), (u64)text.Count(), simd.Data());
+    int scalarCount = DecodeUTF8Scalar(text.Data(), (u64)text.Count(), scalar.Data());
+
+    if (simdCount != scalarCount || simdCount > text.Count()) return false;
+
+    for (int i = 0; i < simdCount; i++) {
+        if (simd[i] != scalar[i]) return false;
+    }
+
+    return true;
+}
+
+static void TestDecodeValid() {
+    Array<byte> text;
+    Array<codepoint> expected;
+    Array<codepoint> decoded;
+
+    for (int run = 0; run < UTF8_RANDOM_RUNS; run++) {
+        text.Clear();
+        expected.Clear();
+
+        int count = (int)pd::random.Range(0, 100);
+        for (int i = 0; i < count; i++) {
+            expected.Add(RandomCodepoint());
+            AppendUTF8(text, expected.Last());
+        }
+
+        decoded.Clear();
+        decoded.AddUninitialized(text.Count() + 1);
+        int decodedCount = DecodeUTF8(text.Data(), (u64)text.Count(), decoded.Data());
+
+        bool same = decodedCount == expected.Count();
+        for (int i = 0; same && i < decodedCount; i++) {
+            same = decoded[i] == expected[i];
+        }
+
+        TEST_CHECK(same);
+        TEST_CHECK(DecodesTheSame(text));
+        TEST_CHECK(decodedCount == UTF8Count(text.Data(), (u64)text.Count()));
+    }
+}
+
+static void TestDecodeInvalid() {
+    Array<byte> text;
+
+    for (int run = 0; run < UTF8_RANDOM_RUNS; run++) {
+        text.Clear();
+
+        int count = (int)pd::random.Range(1, 100);
+        for (int i = 0; i < count; i++) {
+            AppendUTF8(text, RandomCodepoint());
+        }
+
+        // Overwrite a few bytes with anything, continuation bytes and leads are the interesting ones
+        int corruptions = (int)pd::random.Range(1, 4);
+        for (int i = 0; i < corruptions; i++) {
+            int index = (int)pd::random.Range(0, text.Count());
+            text[index] = (byte)pd::random.Range(0x80, 0x100);
+        }
+
+        // Cut the text off in the middle of a sequence every other run
+        if (run % 2 == 0 && text.Count() > 1) {
+            text.RemoveRange(text.Count() - 1, 1);
+        }
+
+        TEST_CHECK(DecodesTheSame(text));
+    }
+}
+
+// A sequence that gets cut off right where a 16 or 32 byte block ends
+static void TestDecodeTruncatedAtBlocks() {
+    const int BLOCK_ENDS[] = { 16, 32, 48, 64 };
+    const codepoint POINTS[] = { 0xE9, 0x20AC, 0x1F600 };
+
+    Array<byte> text;
+    Array<codepoint> decoded;
+
+    for (int blockEnd : BLOCK_ENDS) {
+        for (codepoint point : POINTS) {
+            Array<byte> encoded;
+            AppendUTF8(encoded, point);
+
+            // Start the sequence 1 to 3 bytes before the block ends, then drop its last byte
+            for (int before = 1; before < encoded.Count(); before++) {
+                for (int tail = 0; tail < 20; tail += 19) {
+                    text.Clear();
+                    for (int i = 0; i < blockEnd - before; i++) {
+                        text.Add('a');
+                    }
+
+                    text.AddRange(encoded.Data(), encoded.Count() - 1);
+                    for (int i = 0; i < tail; i++) {
+                        text.Add('b');
+                    }
+
+                    TEST_CHECK(DecodesTheSame(text));
+
+                    decoded.Clear();
+                    decoded.AddUninitialized(text.Count() + 1);
+                    int count = DecodeUTF8(text.Data(), (u64)text.Count(), decoded.Data());
+
+                    // Every byte of the cut off sequence becomes a replacement character
+                    TEST_CHECK(count == blockEnd - before + encoded.Count() - 1 + tail);
+                    TEST_CHECK(decoded[blockEnd - before] == 0xFFFD);
+                }
+            }
+        }
+    }
+}
+
+void TestUTF8() {
+    TestDecodeValid();
+    TestDecodeInvalid();
+    TestDecodeTruncatedAtBlocks();
+}
@@ -0,0 +1,48 @@
+#include <Pandora/Core/Async/WorkerPool.h>
+#include <Pandora/Core/Data/Allocator.h>
+#include <Pandora/Core/IO/Console.h>
+
+#include "Tests.h"
+
+using namespace pd;
+
+// Checks the engine code that can run without a window.
+//
+// Usage: Tests
+// Returns 0 if every check passed.
+
+// @GLOBAL
+static int failedChecks = 0;
+
+void CheckTest(bool passed, const char* expr, const char* file, int line) {
+    if (passed) return;
+
+    console.Log("[{}Tests{}] {}:{} failed: {}\n", ConColor::Red, ConColor::White, file, line, expr);
+    failedChecks += 1;
+}
+
+int FailedChecks() {
+    return failedChecks;
+}
+
+int main(int argc, char** argv) {
+    TestAllocator();
+    TestString();
+    TestParallel();
+    TestHash();
+    TestUTF8();
+
+    if (failedChecks == 0) {
+        console.Log("[{}Tests{}] all checks passed\n", ConColor::Green, ConColor::White);
+    } else {
+        console.Log("[{}Tests{}] {} checks failed\n", ConColor::Red, ConColor::White, failedChecks);
+    }
+
+    console.Flush();
+
+    workerPool.Delete();
+    DeleteTemporaryAllocator();
+    DeletePoolAllocator();
+
+    return (failedChecks == 0) ? 0 : 1;
+}
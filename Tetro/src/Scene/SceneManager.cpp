@@ -45,7 +45,14 @@ void SceneManager::OnEvent(Event* event) {
 }
 
 void SceneManager::RemoveScene(StringView name) {
-    u64 hash = DoHash(name);
+    RemoveSceneHashed(name, DoHash(name));
+}
+
+void SceneManager::RemoveScene(Name name) {
+    RemoveSceneHashed(name.View(), name.Hash());
+}
+
+void SceneManager::RemoveSceneHashed(StringView name, u64 hash) {
     int index = FindSceneIndex(hash);
 
     if (index != -1) {
@@ -57,8 +64,14 @@ void SceneManager::RemoveScene(StringView name) {
 }
 
 void SceneManager::SetCurrent(StringView name) {
-    u64 hash = DoHash(name);
+    SetCurrentHashed(name, DoHash(name));
+}
 
+void SceneManager::SetCurrent(Name name) {
+    SetCurrentHashed(name.View(), name.Hash());
+}
+
+void SceneManager::SetCurrentHashed(StringView name, u64 hash) {
     SceneEntry* scene = FindScene(hash);
 
     if (current) {
@@ -87,6 +100,12 @@ Scene* SceneManager::GetScene(StringView name) {
     return (entry) ? entry->scene : nullptr;
 }
 
+Scene* SceneManager::GetScene(Name name) {
+    SceneEntry* entry = FindScene(name.Hash());
+
+    return (entry) ? entry->scene : nullptr;
+}
+
 SceneManager::SceneEntry* SceneManager::FindScene(u64 hash) {
     int index = FindSceneIndex(hash);
     return (index != -1) ? &scenes[index] : nullptr;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Pandora/Core/Data/Array.h"
+#include "Pandora/Core/Data/Name.h"
 #include "Pandora/Core/Event.h"
 
 #include "Scene.h"
@@ -33,13 +34,38 @@ public:
 
     template<typename T, typename ...Args>
     void AddScene(StringView name, Args&&... args) {
+        AddSceneHashed<T>(name, DoHash(name), std::forward<Args>(args)...);
+    }
+
+    // Uses the hash stored in the name, so nothing gets hashed
+    template<typename T, typename ...Args>
+    void AddScene(Name name, Args&&... args) {
+        AddSceneHashed<T>(name.View(), name.Hash(), std::forward<Args>(args)...);
+    }
+
+    void RemoveScene(StringView name);
+    void RemoveScene(Name name);
+
+    void SetCurrent(StringView name);
+    void SetCurrent(Name name);
+
+    Slice<SceneEntry> GetScenes();
+
+    Scene* GetCurrent();
+
+    Scene* GetScene(StringView name);
+    Scene* GetScene(Name name);
+
+private:
+
+    template<typename T, typename ...Args>
+    void AddSceneHashed(StringView name, u64 hash, Args&&... args) {
         static_assert(std::is_base_of<Scene, T>::value, "Template type T must derive from pd::Scene");
 
-        u64 hash = DoHash(name);
         SceneEntry* scene = FindScene(hash);
 
         if (scene) {
-            RemoveScene(name);
+            RemoveSceneHashed(name, hash);
         }
 
         SceneEntry newScene = {};
@@ -49,17 +75,9 @@ public:
         scenes.Add(newScene);
     }
 
-    void RemoveScene(StringView name);
-
-    void SetCurrent(StringView name);
-
-    Slice<SceneEntry> GetScenes();
-
-    Scene* GetCurrent();
+    void RemoveSceneHashed(StringView name, u64 hash);
 
-    Scene* GetScene(StringView name);
-
-private:
+    void SetCurrentHashed(StringView name, u64 hash);
 
     SceneEntry* FindScene(u64 hash);
 